@@ -0,0 +1,46 @@
+/*
+ *  CombSort.c
+ *  SDL_Sort_Visualizer
+ *
+ *  Created by Emiliano Iacopini on 10/18/26.
+ *
+ *  Example sort plugin, built with `make plugins`.
+ */
+
+#include "SortPlugin.h"
+
+static void combSort(const sv_array *array)
+{
+    size_t gap = array->size;
+    int sorted = 0;
+
+    while (!sorted) {
+        // Shrink the gap by the usual factor of 1.3
+        gap = gap * 10 / 13;
+        if (gap <= 1) {
+            gap = 1;
+            sorted = 1;
+        }
+
+        for (size_t i = 0; i + gap < array->size; i++) {
+            if (array->less(array->context, i + gap, i)) {
+                array->swap(array->context, i, i + gap);
+                sorted = 0;
+            }
+        }
+    }
+}
+
+static const sv_plugin gPlugin = {
+    SV_PLUGIN_ABI_VERSION,
+    "Comb Sort",
+    "comb",
+    '.',
+    NULL,
+    combSort
+};
+
+const sv_plugin *sv_plugin_descriptor(void)
+{
+    return &gPlugin;
+}
@@ -0,0 +1,112 @@
+//
+//  Argsort.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Argsort_hpp
+#define Argsort_hpp
+
+#include <vector>
+#include <string>
+#include <variant>
+#include <cstdint>
+#include <type_traits>
+
+#include "Elements.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Enum that represents what the algorithms move while sorting an array
+     */
+    enum ARGSORT_MODE
+    {
+        DIRECT_SORT,   // The elements themselves
+        INDIRECT_SORT, // The indices of the elements, every comparison gathers the two keys
+        CACHED_SORT    // The indices with a copy of their key, extracted once before the sort
+    };
+
+    const std::string gARGSORT_MODE_NAMES[] = {"direct", "indirect", "cached"};
+
+    const int gARGSORT_MODES_COUNT = 3;
+
+    /*!
+     * @brief An index into the sorted array with a copy of its key, what the cached argsort moves
+     */
+    template <typename T>
+    struct CACHED_INDEX
+    {
+        T key;
+        uint32_t index;
+    };
+
+    /*!
+     * @brief The arrays an argsort runs on: bare indices, or indices with the keys of one of the
+     *        ElementArray types
+     */
+    typedef std::variant<std::vector<uint32_t>,
+                         std::vector<CACHED_INDEX<int32_t>>,
+                         std::vector<CACHED_INDEX<int64_t>>,
+                         std::vector<CACHED_INDEX<uint64_t>>,
+                         std::vector<CACHED_INDEX<float>>,
+                         std::vector<CACHED_INDEX<double>>> IndexArray;
+
+    /*!
+     * @brief Creates the identity permutation of the keys, with a copy of every key when cached
+     * @param mode INDIRECT_SORT or CACHED_SORT
+     */
+    inline IndexArray makeIndexArray(ARGSORT_MODE mode, const ElementArray &keys)
+    {
+        return std::visit([mode](const auto &values) -> IndexArray {
+            typedef typename std::decay<decltype(values)>::type::value_type T;
+            uint32_t n = values.size();
+
+            if (mode == CACHED_SORT) {
+                std::vector<CACHED_INDEX<T>> cached(n);
+                for (uint32_t i = 0; i < n; i++)
+                    cached[i] = {values[i], i};
+                return cached;
+            }
+
+            std::vector<uint32_t> indices(n);
+            for (uint32_t i = 0; i < n; i++)
+                indices[i] = i;
+            return indices;
+        }, keys);
+    }
+
+    /*!
+     * @brief The index found at a position of the argsort
+     */
+    inline uint32_t indexAt(const IndexArray &indices, int position)
+    {
+        return std::visit([position](const auto &order) -> uint32_t {
+            if constexpr (std::is_same<typename std::decay<decltype(order)>::type::value_type, uint32_t>::value)
+                return order[position];
+            else
+                return order[position].index;
+        }, indices);
+    }
+
+    /*!
+     * @brief Copies the keys in the order of the indices, the array the argsort stands for
+     */
+    template <typename T>
+    std::vector<T> gatherKeys(const IndexArray &indices, const std::vector<T> &keys)
+    {
+        return std::visit([&keys](const auto &order) {
+            std::vector<T> gathered(order.size());
+            for (size_t i = 0; i < order.size(); i++) {
+                if constexpr (std::is_same<typename std::decay<decltype(order)>::type::value_type, uint32_t>::value)
+                    gathered[i] = keys[order[i]];
+                else
+                    gathered[i] = keys[order[i].index];
+            }
+            return gathered;
+        }, indices);
+    }
+}
+
+#endif /* Argsort_hpp */
@@ -0,0 +1,435 @@
+//
+//  Baseline.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "Baseline.hpp"
+
+namespace
+{
+    using namespace Visualizer;
+
+    // The name of the format, so another JSON file isn't taken for a baseline
+    const char *gBASELINE_FORMAT = "sort-visualizer-baseline";
+
+    // The resamples of the bootstrap confidence intervals
+    const int gBOOTSTRAP_RESAMPLES = 2000;
+
+    // The largest samples whose U distribution is computed exactly
+    const int gEXACT_U_MAX = 20;
+
+    // A parsed JSON value, only what the baselines hold
+    struct JsonValue
+    {
+        enum Kind { NULL_VALUE, BOOL_VALUE, NUMBER_VALUE, STRING_VALUE, ARRAY_VALUE, OBJECT_VALUE };
+
+        Kind kind = NULL_VALUE;
+        bool boolean = false;
+        double number = 0.0;
+        std::string text;
+        std::vector<JsonValue> items;
+        std::vector<std::pair<std::string, JsonValue>> members;
+
+        // The member with the given name, a null value if missing
+        const JsonValue &operator[](const std::string &name) const
+        {
+            static const JsonValue missing;
+            for (const auto &member : members)
+                if (member.first == name)
+                    return member.second;
+            return missing;
+        }
+    };
+
+    // A recursive descent parser of JSON text
+    class JsonParser
+    {
+    public:
+        JsonParser(const std::string &text) : mText(text) {}
+
+        JsonValue parse()
+        {
+            JsonValue value = parseValue();
+            skipSpaces();
+            if (mPosition != mText.size())
+                fail("trailing characters");
+            return value;
+        }
+
+    private:
+        const std::string &mText;
+        size_t mPosition = 0;
+
+        [[noreturn]] void fail(const std::string &reason)
+        {
+            throw std::runtime_error(reason + " at offset " + std::to_string(mPosition));
+        }
+
+        void skipSpaces()
+        {
+            while (mPosition < mText.size() && (mText[mPosition] == ' ' || mText[mPosition] == '\n' || mText[mPosition] == '\r' || mText[mPosition] == '\t'))
+                mPosition++;
+        }
+
+        bool consume(const std::string &token)
+        {
+            if (mText.compare(mPosition, token.size(), token) != 0)
+                return false;
+            mPosition += token.size();
+            return true;
+        }
+
+        void expect(char c)
+        {
+            skipSpaces();
+            if (mPosition >= mText.size() || mText[mPosition] != c)
+                fail(std::string("expected '") + c + "'");
+            mPosition++;
+        }
+
+        JsonValue parseValue()
+        {
+            skipSpaces();
+            if (mPosition >= mText.size())
+                fail("unexpected end");
+
+            JsonValue value;
+            char c = mText[mPosition];
+
+            if (c == '{') {
+                value.kind = JsonValue::OBJECT_VALUE;
+                mPosition++;
+                skipSpaces();
+                if (consume("}"))
+                    return value;
+                do {
+                    skipSpaces();
+                    std::string name = parseString();
+                    expect(':');
+                    value.members.emplace_back(name, parseValue());
+                    skipSpaces();
+                } while (consume(","));
+                expect('}');
+            }
+            else if (c == '[') {
+                value.kind = JsonValue::ARRAY_VALUE;
+                mPosition++;
+                skipSpaces();
+                if (consume("]"))
+                    return value;
+                do {
+                    value.items.push_back(parseValue());
+                    skipSpaces();
+                } while (consume(","));
+                expect(']');
+            }
+            else if (c == '"') {
+                value.kind = JsonValue::STRING_VALUE;
+                value.text = parseString();
+            }
+            else if (consume("true")) {
+                value.kind = JsonValue::BOOL_VALUE;
+                value.boolean = true;
+            }
+            else if (consume("false"))
+                value.kind = JsonValue::BOOL_VALUE;
+            else if (consume("null"))
+                value.kind = JsonValue::NULL_VALUE;
+            else {
+                char *end;
+                value.kind = JsonValue::NUMBER_VALUE;
+                value.number = std::strtod(mText.c_str() + mPosition, &end);
+                if (end == mText.c_str() + mPosition)
+                    fail("unexpected character");
+                mPosition = end - mText.c_str();
+            }
+
+            return value;
+        }
+
+        // The names and values written by writeBaseline only escape quotes and backslashes
+        std::string parseString()
+        {
+            if (mPosition >= mText.size() || mText[mPosition] != '"')
+                fail("expected a string");
+            mPosition++;
+
+            std::string text;
+            while (mPosition < mText.size() && mText[mPosition] != '"') {
+                if (mText[mPosition] == '\\')
+                    mPosition++;
+                if (mPosition < mText.size())
+                    text += mText[mPosition++];
+            }
+            if (mPosition >= mText.size())
+                fail("unterminated string");
+            mPosition++;
+
+            return text;
+        }
+    };
+
+    // Writes a string as a JSON string
+    void writeString(FILE *file, const std::string &text)
+    {
+        fputc('"', file);
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                fputc('\\', file);
+            if ((unsigned char)c >= 0x20)
+                fputc(c, file);
+        }
+        fputc('"', file);
+    }
+
+    double median(std::vector<double> values)
+    {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    }
+
+    // The ways n + m values without ties can be split so that the U statistic of the m is u, for every u
+    std::vector<double> exactUCounts(int n, int m)
+    {
+        // counts[i][j][u] for i of the first sample and j of the second, built up one value at a time
+        std::vector<std::vector<std::vector<double>>> counts(n + 1, std::vector<std::vector<double>>(m + 1));
+        for (int i = 0; i <= n; i++)
+            for (int j = 0; j <= m; j++) {
+                counts[i][j].assign(i * j + 1, 0.0);
+                if (i == 0 || j == 0) {
+                    counts[i][j][0] = 1.0;
+                    continue;
+                }
+                // The largest value is either of the second sample, above all i of the first, or of the first
+                for (int u = 0; u <= i * j; u++)
+                    counts[i][j][u] = (u >= i ? counts[i][j - 1][u - i] : 0.0) + (u <= (i - 1) * j ? counts[i - 1][j][u] : 0.0);
+            }
+        return counts[n][m];
+    }
+
+    // The two sided p-value of the Mann-Whitney U test of the current times against the baseline ones
+    double mannWhitney(const std::vector<double> &baseline, const std::vector<double> &current)
+    {
+        int n = baseline.size();
+        int m = current.size();
+
+        // U counts the pairs where the current time is the slower, ties counting half
+        double u = 0.0;
+        bool ties = false;
+        for (double b : baseline)
+            for (double c : current) {
+                if (c > b)
+                    u += 1.0;
+                else if (c == b) {
+                    u += 0.5;
+                    ties = true;
+                }
+            }
+
+        if (!ties && n <= gEXACT_U_MAX && m <= gEXACT_U_MAX) {
+            std::vector<double> counts = exactUCounts(n, m);
+            double total = 0.0, below = 0.0, above = 0.0;
+            for (size_t k = 0; k < counts.size(); k++) {
+                total += counts[k];
+                if (k <= u)
+                    below += counts[k];
+                if (k >= u)
+                    above += counts[k];
+            }
+            return std::min(1.0, 2 * std::min(below, above) / total);
+        }
+
+        // The normal approximation, its variance reduced by the ties
+        std::vector<double> all(baseline);
+        all.insert(all.end(), current.begin(), current.end());
+        std::sort(all.begin(), all.end());
+
+        double tieTerm = 0.0;
+        for (size_t i = 0; i < all.size();) {
+            size_t j = i;
+            while (j < all.size() && all[j] == all[i])
+                j++;
+            double t = j - i;
+            tieTerm += t * t * t - t;
+            i = j;
+        }
+
+        double total = n + m;
+        double variance = n * m / 12.0 * ((total + 1) - tieTerm / (total * (total - 1)));
+        if (variance <= 0.0)
+            return 1.0;
+
+        double z = (std::fabs(u - n * m / 2.0) - 0.5) / std::sqrt(variance);
+        return std::min(1.0, std::erfc(std::max(0.0, z) / std::sqrt(2.0)));
+    }
+}
+
+void Visualizer::writeBaseline(const std::string &path, const BASELINE &baseline)
+{
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == NULL)
+        throw std::runtime_error("Failed to create the baseline " + path);
+
+    fprintf(file, "{\n  \"format\": \"%s\",\n  \"version\": %d,\n  \"host\": ", gBASELINE_FORMAT, baseline.version);
+    writeString(file, baseline.host);
+    fprintf(file, ",\n  \"created\": ");
+    writeString(file, baseline.created);
+    fprintf(file, ",\n  \"seed\": %u,\n  \"repeats\": %d,\n  \"entries\": [", baseline.seed, baseline.repeats);
+
+    for (size_t e = 0; e < baseline.entries.size(); e++) {
+        const BASELINE_ENTRY &entry = baseline.entries[e];
+
+        fprintf(file, "%s\n    {\"algorithm\": ", e == 0 ? "" : ",");
+        writeString(file, entry.algorithm);
+        fprintf(file, ", \"type\": ");
+        writeString(file, entry.type);
+        fprintf(file, ", \"elements\": %d, \"distribution\": ", entry.elements);
+        writeString(file, entry.distribution);
+        fprintf(file, ", \"cutoff\": %d, \"gaps\": ", entry.cutoff);
+        writeString(file, entry.gaps);
+        fprintf(file, ", \"sorted\": %s, \"times_ms\": [", entry.sorted ? "true" : "false");
+        for (size_t t = 0; t < entry.timesMs.size(); t++)
+            fprintf(file, "%s%.6f", t == 0 ? "" : ", ", entry.timesMs[t]);
+        fprintf(file, "], \"noise\": %.6f}", entry.noise);
+    }
+
+    fprintf(file, "\n  ]\n}\n");
+
+    if (fclose(file) != 0)
+        throw std::runtime_error("Failed to write the baseline " + path);
+}
+
+Visualizer::BASELINE Visualizer::readBaseline(const std::string &path)
+{
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == NULL)
+        throw std::runtime_error("Failed to open the baseline " + path);
+
+    std::string text;
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        text.append(buffer, read);
+    fclose(file);
+
+    JsonValue root;
+    try {
+        root = JsonParser(text).parse();
+    }
+    catch (std::runtime_error &e) {
+        throw std::runtime_error("Invalid baseline " + path + ": " + e.what());
+    }
+
+    if (root["format"].text != gBASELINE_FORMAT)
+        throw std::runtime_error(path + " is not a baseline");
+    if ((int)root["version"].number != gBASELINE_VERSION)
+        throw std::runtime_error("The baseline " + path + " has version " + std::to_string((int)root["version"].number) +
+                                 ", this build reads version " + std::to_string(gBASELINE_VERSION));
+
+    BASELINE baseline;
+    baseline.host = root["host"].text;
+    baseline.created = root["created"].text;
+    baseline.seed = (unsigned)root["seed"].number;
+    baseline.repeats = (int)root["repeats"].number;
+
+    for (const JsonValue &item : root["entries"].items) {
+        BASELINE_ENTRY entry;
+        entry.algorithm = item["algorithm"].text;
+        entry.type = item["type"].text;
+        entry.elements = (int)item["elements"].number;
+        entry.distribution = item["distribution"].text;
+        entry.cutoff = (int)item["cutoff"].number;
+        entry.gaps = item["gaps"].text;
+        entry.sorted = item["sorted"].boolean;
+        for (const JsonValue &time : item["times_ms"].items)
+            entry.timesMs.push_back(time.number);
+        entry.noise = item["noise"].number;
+
+        if (entry.algorithm.empty() || entry.timesMs.empty())
+            throw std::runtime_error("Invalid baseline " + path + ": an entry has no algorithm or no times");
+        baseline.entries.push_back(entry);
+    }
+
+    return baseline;
+}
+
+std::string Visualizer::baselineHost()
+{
+#ifdef _WIN32
+    const char *name = std::getenv("COMPUTERNAME");
+    return name != NULL ? name : "unknown";
+#else
+    char name[256] = {0};
+    if (gethostname(name, sizeof(name) - 1) != 0)
+        return "unknown";
+    return name;
+#endif
+}
+
+Visualizer::TIME_COMPARISON Visualizer::compareTimes(const std::vector<double> &baseline, const std::vector<double> &current, double threshold, double alpha, double noise, unsigned seed)
+{
+    TIME_COMPARISON comparison;
+    if (baseline.empty() || current.empty())
+        return comparison;
+
+    comparison.baselineMs = median(baseline);
+    comparison.currentMs = median(current);
+    if (comparison.baselineMs <= 0.0)
+        return comparison;
+
+    comparison.ratio = comparison.currentMs / comparison.baselineMs;
+    comparison.pValue = mannWhitney(baseline, current);
+
+    // The percentile interval of the ratio of the medians of resampled sets
+    std::mt19937 generator(seed);
+    std::vector<double> ratios;
+    std::vector<double> b(baseline.size()), c(current.size());
+    for (int r = 0; r < gBOOTSTRAP_RESAMPLES; r++) {
+        for (double &value : b)
+            value = baseline[generator() % baseline.size()];
+        for (double &value : c)
+            value = current[generator() % current.size()];
+        double base = median(b);
+        if (base > 0.0)
+            ratios.push_back(median(c) / base);
+    }
+    if (!ratios.empty()) {
+        std::sort(ratios.begin(), ratios.end());
+        comparison.ratioLow = ratios[(size_t)(ratios.size() * alpha / 2)];
+        comparison.ratioHigh = ratios[std::min(ratios.size() - 1, (size_t)(ratios.size() * (1 - alpha / 2)))];
+    }
+
+    bool significant = comparison.pValue < alpha;
+    double change = std::max(threshold, noise);
+    comparison.noise = noise;
+    comparison.regression = significant && comparison.ratio > 1.0 + change && comparison.ratioLow > 1.0 + noise;
+    comparison.improvement = significant && comparison.ratio < 1.0 / (1.0 + change) && comparison.ratioHigh < 1.0 / (1.0 + noise);
+
+    return comparison;
+}
+
+double Visualizer::minimumPValue(int baselineRepeats, int currentRepeats)
+{
+    // The two most extreme splits of the exact distribution, 2 / C(n + m, n)
+    double splits = 1.0;
+    for (int k = 1; k <= currentRepeats; k++)
+        splits = splits * (baselineRepeats + k) / k;
+    return std::min(1.0, 2.0 / splits);
+}
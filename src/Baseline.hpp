@@ -0,0 +1,104 @@
+//
+//  Baseline.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Baseline_hpp
+#define Baseline_hpp
+
+#include <vector>
+#include <string>
+
+namespace Visualizer
+{
+    // The version of the baseline files written, files of another version are refused
+    const int gBASELINE_VERSION = 2;
+
+    /*!
+     * @brief The times of one run of the suite: an algorithm on one element type, size and distribution
+     */
+    typedef struct BASELINE_ENTRY
+    {
+        std::string algorithm;      /*! The command line name of the algorithm */
+        std::string type;           /*! The name of the element type */
+        int elements = 0;
+        std::string distribution;   /*! The name of the input distribution */
+        int cutoff = 0;             /*! The sorting network cutoff it ran with */
+        std::string gaps;           /*! The gap sequence it ran with */
+        bool sorted = true;         /*! Whether every repeat left the array sorted */
+        std::vector<double> timesMs; /*! The time of every repeat, in the order they ran */
+        double noise = 0.0;         /*! The relative spread of the median times of separate processes */
+    } BASELINE_ENTRY;
+
+    /*!
+     * @brief The results of a benchmark suite, stored to compare later runs against
+     */
+    typedef struct BASELINE
+    {
+        int version = gBASELINE_VERSION;
+        std::string host;           /*! The machine that ran the suite */
+        std::string created;        /*! When the suite ran, in UTC */
+        unsigned seed = 42;         /*! The seed of the inputs */
+        int repeats = 0;            /*! The repeats of every run */
+        std::vector<BASELINE_ENTRY> entries;
+    } BASELINE;
+
+    /*!
+     * @brief Writes a baseline as JSON
+     * @throws std::runtime_error if the file can't be written
+     */
+    void writeBaseline(const std::string &path, const BASELINE &baseline);
+
+    /*!
+     * @brief Reads a baseline written by writeBaseline
+     * @throws std::runtime_error if the file can't be read, isn't a baseline or has another version
+     */
+    BASELINE readBaseline(const std::string &path);
+
+    /*!
+     * @brief The name of this machine, as stored in the baselines
+     */
+    std::string baselineHost();
+
+    /*!
+     * @brief The comparison of the times of a run with those of its baseline
+     */
+    typedef struct TIME_COMPARISON
+    {
+        double baselineMs = 0.0; /*! The median time of the baseline */
+        double currentMs = 0.0;  /*! The median time of the run */
+        double ratio = 1.0;      /*! The current median over the baseline one */
+        double ratioLow = 1.0;   /*! The bounds of the bootstrap confidence interval of the ratio */
+        double ratioHigh = 1.0;
+        double pValue = 1.0;     /*! The two sided p-value of the Mann-Whitney U test */
+        double noise = 0.0;      /*! The relative change the interval and the ratio had to clear */
+        bool regression = false; /*! Significantly slower by more than the threshold */
+        bool improvement = false; /*! Significantly faster by more than the threshold */
+    } TIME_COMPARISON;
+
+    /*!
+     * @brief Tests whether the current times come from a slower or faster distribution than the baseline ones
+     * @details The medians are compared, the Mann-Whitney U test gives the significance (exactly
+     *          for up to 20 repeats without ties, with the normal approximation otherwise) and
+     *          2000 resamples of both sets give a 1 - alpha confidence interval of the ratio of
+     *          the medians. The repeats of one process share its memory layout and clock, so they
+     *          vary less than separate processes do: a change is only reported when it's
+     *          significant at alpha, beyond both the threshold and the noise, and the whole
+     *          interval lies beyond the noise on the same side of 1.
+     * @param threshold The relative change below which no change is reported, 0.05 for 5%
+     * @param alpha The significance level, and 1 - alpha the level of the interval
+     * @param noise The relative change separate processes show without any change of the code
+     * @param seed The seed of the resampling, so a comparison is reproducible
+     */
+    TIME_COMPARISON compareTimes(const std::vector<double> &baseline, const std::vector<double> &current, double threshold, double alpha, double noise, unsigned seed);
+
+    /*!
+     * @brief The smallest two sided p-value the U test can give with the given sample sizes,
+     *        when it's above alpha no change can be detected
+     */
+    double minimumPValue(int baselineRepeats, int currentRepeats);
+}
+
+#endif /* Baseline_hpp */
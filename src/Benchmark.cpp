@@ -0,0 +1,1153 @@
+//
+//  Benchmark.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <ctime>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Benchmark.hpp"
+#include "Elements.hpp"
+#include "Registry.hpp"
+#include "ExternalSort.hpp"
+#include "EventFeed.hpp"
+#include "ScalingReport.hpp"
+#include "MemoryTracker.hpp"
+#include "PerfCounter.hpp"
+#include "Records.hpp"
+#include "Verify.hpp"
+#include "Baseline.hpp"
+#include "Trace.hpp"
+
+namespace
+{
+    // The repeats of the runs saved as a baseline, unless --repeats is given
+    const int gBASELINE_REPEATS = 12;
+
+    // The processes, besides this one, that measure how much a run varies from process to process
+    const int gNOISE_PROCESSES = 3;
+
+    // The timed repeats of each of those processes
+    const int gNOISE_REPEATS = 3;
+
+    // Counts the operations yielded by an algorithm
+    struct OpCounter
+    {
+        long long comparisons = 0;
+        long long swaps = 0;
+        long long writes = 0;
+        long long reads = 0;
+
+        void count(const SORT_OP &op)
+        {
+            switch (op.type) {
+                case COMPARE_OP:
+                    comparisons++;
+                    break;
+                case SWAP_OP:
+                    swaps++;
+                    break;
+                case WRITE_OP:
+                    writes++;
+                    break;
+                case READ_OP:
+                    reads++;
+                    break;
+            }
+        }
+    };
+
+    // Splits a comma separated option value
+    std::vector<std::string> splitList(const std::string &value)
+    {
+        std::vector<std::string> items;
+        std::stringstream ss(value);
+        std::string item;
+
+        while (std::getline(ss, item, ','))
+            if (!item.empty())
+                items.push_back(item);
+
+        return items;
+    }
+
+    // Parses a number of bytes with an optional K, M or G suffix
+    long long parseBytes(const std::string &value)
+    {
+        long long bytes = std::stoll(value);
+        switch (value.back()) {
+            case 'G': case 'g':
+                bytes <<= 10;
+                [[fallthrough]];
+            case 'M': case 'm':
+                bytes <<= 10;
+                [[fallthrough]];
+            case 'K': case 'k':
+                bytes <<= 10;
+        }
+        return bytes;
+    }
+
+    // Whether the first count elements of result are the count smallest of sorted, the last of them in place
+    template <typename T>
+    bool isSelected(const std::vector<T> &result, const std::vector<T> &sorted, int count)
+    {
+        std::vector<T> prefix(result.begin(), result.begin() + count);
+        std::sort(prefix.begin(), prefix.end(), Visualizer::TotalLess<T>());
+
+        auto same = [](const T &a, const T &b) { return !Visualizer::TotalLess<T>()(a, b) && !Visualizer::TotalLess<T>()(b, a); };
+        return std::equal(prefix.begin(), prefix.end(), sorted.begin(), same) && (count == 0 || same(result[count - 1], sorted[count - 1]));
+    }
+
+    // Runs an algorithm on copies of the input and returns the median time, the last copy sorted is left in result
+    double timeSort(int sort, const Visualizer::ElementArray &input, int repeats, Visualizer::ElementArray &result, OpCounter &counter)
+    {
+        std::vector<double> times;
+
+        for (int r = 0; r < repeats; r++) {
+            result = input;
+            counter = OpCounter();
+
+            auto start = std::chrono::high_resolution_clock::now();
+            Visualizer::SortGenerator sorting = Visualizer::Registry::instance()[sort].factory(result);
+            while (sorting.next())
+                counter.count(sorting.value());
+            auto end = std::chrono::high_resolution_clock::now();
+
+            times.push_back(Visualizer::Registry::instance().sortTimeMs(sort, start, end));
+        }
+
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    // The relative spread of the median times of separate processes running the same sort, each
+    // after a discarded run, the median of this process being one of them
+    double processNoise(int sort, const Visualizer::ElementArray &input, double medianMs)
+    {
+        std::vector<double> medians{medianMs};
+
+#ifndef _WIN32
+        for (int p = 0; p < gNOISE_PROCESSES; p++) {
+            int channel[2];
+            if (pipe(channel) != 0)
+                break;
+
+            pid_t process = fork();
+            if (process == 0) {
+                // Only this thread exists in the child, which must not touch stdio
+                close(channel[0]);
+                Visualizer::ElementArray result;
+                OpCounter counter;
+                timeSort(sort, input, 1, result, counter);
+                double time = timeSort(sort, input, gNOISE_REPEATS, result, counter);
+                ssize_t written = write(channel[1], &time, sizeof(time));
+                _exit(written == sizeof(time) ? 0 : 1);
+            }
+
+            close(channel[1]);
+            double time;
+            if (process > 0 && read(channel[0], &time, sizeof(time)) == sizeof(time))
+                medians.push_back(time);
+            close(channel[0]);
+            if (process > 0)
+                waitpid(process, NULL, 0);
+        }
+#endif
+
+        std::sort(medians.begin(), medians.end());
+        double median = medians[medians.size() / 2];
+        return median > 0.0 ? (medians.back() - medians.front()) / median : 0.0;
+    }
+
+    // The gap sequence printed for an algorithm, none if it doesn't use one
+    const char *gapsName(int sort)
+    {
+        const Visualizer::Registry &registry = Visualizer::Registry::instance();
+        return registry[sort].usesGapSequence ? gGAP_SEQUENCE_NAMES[registry.gapSequence()].c_str() : "none";
+    }
+}
+
+Visualizer::Benchmark::Benchmark(const BENCHMARK_CONFIG &config)
+    : mConfig(config)
+{
+}
+
+Visualizer::BENCHMARK_CONFIG Visualizer::Benchmark::parseArguments(int argc, char *argv[])
+{
+    BENCHMARK_CONFIG config;
+    bool repeatsGiven = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+
+        if (option == "--headless")
+            continue;
+
+        if (i + 1 >= argc)
+            throw std::runtime_error("Missing value for option " + option);
+        std::string value = argv[++i];
+
+        if (option == "--plugins" || option == "--trace")
+            continue;
+        else if (option == "--sorts") {
+            for (const std::string &name : splitList(value)) {
+                int sort = Registry::instance().find(name);
+                if (sort < 0)
+                    throw std::runtime_error("Unknown sort: " + name);
+                config.sorts.push_back(sort);
+            }
+        }
+        else if (option == "--types") {
+            for (const std::string &name : splitList(value)) {
+                const std::string *type = std::find(gELEMENT_TYPE_NAMES, gELEMENT_TYPE_NAMES + gELEMENT_TYPES_COUNT, name);
+                if (type == gELEMENT_TYPE_NAMES + gELEMENT_TYPES_COUNT)
+                    throw std::runtime_error("Unknown element type: " + name);
+                config.types.push_back((ELEMENT_TYPE)(type - gELEMENT_TYPE_NAMES));
+            }
+        }
+        else if (option == "--sizes") {
+            for (const std::string &size : splitList(value))
+                config.sizes.push_back(std::stoi(size));
+        }
+        else if (option == "--distributions") {
+            for (const std::string &name : splitList(value)) {
+                if (name == "all") {
+                    for (int i = 0; i < gINPUT_DISTRIBUTIONS_COUNT; i++)
+                        config.distributions.push_back((INPUT_DISTRIBUTION)i);
+                    continue;
+                }
+                const std::string *distribution = std::find(gINPUT_DISTRIBUTION_NAMES, gINPUT_DISTRIBUTION_NAMES + gINPUT_DISTRIBUTIONS_COUNT, name);
+                if (distribution == gINPUT_DISTRIBUTION_NAMES + gINPUT_DISTRIBUTIONS_COUNT)
+                    throw std::runtime_error("Unknown input distribution: " + name);
+                config.distributions.push_back((INPUT_DISTRIBUTION)(distribution - gINPUT_DISTRIBUTION_NAMES));
+            }
+        }
+        else if (option == "--cutoffs") {
+            for (const std::string &cutoff : splitList(value)) {
+                int size = std::stoi(cutoff);
+                if (size < 0 || size > gMAX_NETWORK_SIZE)
+                    throw std::runtime_error("Invalid network cutoff: " + cutoff);
+                config.cutoffs.push_back(size);
+            }
+        }
+        else if (option == "--gaps") {
+            for (const std::string &name : splitList(value)) {
+                if (name == "all") {
+                    for (int i = 0; i < gGAP_SEQUENCES_COUNT; i++)
+                        config.gaps.push_back((GAP_SEQUENCE)i);
+                    continue;
+                }
+                const std::string *gaps = std::find(gGAP_SEQUENCE_NAMES, gGAP_SEQUENCE_NAMES + gGAP_SEQUENCES_COUNT, name);
+                if (gaps == gGAP_SEQUENCE_NAMES + gGAP_SEQUENCES_COUNT)
+                    throw std::runtime_error("Unknown gap sequence: " + name);
+                config.gaps.push_back((GAP_SEQUENCE)(gaps - gGAP_SEQUENCE_NAMES));
+            }
+        }
+        else if (option == "--repeats") {
+            config.repeats = std::max(1, std::stoi(value));
+            repeatsGiven = true;
+        }
+        else if (option == "--seed")
+            config.seed = std::stoul(value);
+        else if (option == "--verify") {
+            if (value != "on" && value != "off")
+                throw std::runtime_error("Invalid verify option: " + value + " (on or off)");
+            config.verify = value == "on";
+        }
+        else if (option == "--cache")
+            config.cache = value == "default" ? CacheSimulator::defaultLevels() : CacheSimulator::parseLevels(value);
+        else if (option == "--external") {
+            config.externalMemory = parseBytes(value);
+            if (config.externalMemory <= 0)
+                throw std::runtime_error("Invalid external sort memory: " + value);
+        }
+        else if (option == "--serve")
+            config.serveAddress = value;
+        else if (option == "--scaling") {
+            long long size = parseBytes(value);
+            if (size < 16 || size > (1 << 30))
+                throw std::runtime_error("Invalid scaling size: " + value);
+            config.scalingMax = size;
+        }
+        else if (option == "--k") {
+            for (const std::string &k : splitList(value)) {
+                int count = k == "median" ? 0 : std::stoi(k);
+                if (count < 0)
+                    throw std::runtime_error("Invalid selection k: " + k);
+                config.ks.push_back(count);
+            }
+        }
+        else if (option == "--records") {
+            for (const std::string &payload : splitList(value)) {
+                int bytes = std::stoi(payload);
+                if (std::find(gRECORD_PAYLOADS, gRECORD_PAYLOADS + gRECORD_PAYLOADS_COUNT, bytes) == gRECORD_PAYLOADS + gRECORD_PAYLOADS_COUNT)
+                    throw std::runtime_error("Invalid record payload: " + payload + " (16, 32, 64, 128 or 256)");
+                config.payloads.push_back(bytes);
+            }
+        }
+        else if (option == "--argsort") {
+            for (const std::string &name : splitList(value)) {
+                if (name == "all") {
+                    for (int i = 0; i < gARGSORT_MODES_COUNT; i++)
+                        config.argsort.push_back((ARGSORT_MODE)i);
+                    continue;
+                }
+                const std::string *mode = std::find(gARGSORT_MODE_NAMES, gARGSORT_MODE_NAMES + gARGSORT_MODES_COUNT, name);
+                if (mode == gARGSORT_MODE_NAMES + gARGSORT_MODES_COUNT)
+                    throw std::runtime_error("Unknown argsort mode: " + name + " (direct, indirect or cached)");
+                config.argsort.push_back((ARGSORT_MODE)(mode - gARGSORT_MODE_NAMES));
+            }
+        }
+        else if (option == "--ingest") {
+            for (const std::string &name : splitList(value)) {
+                if (name == "all") {
+                    for (int i = 0; i < gINGEST_STRATEGIES_COUNT; i++)
+                        config.ingest.push_back((INGEST_STRATEGY)i);
+                    continue;
+                }
+                const std::string *strategy = std::find(gINGEST_STRATEGY_NAMES, gINGEST_STRATEGY_NAMES + gINGEST_STRATEGIES_COUNT, name);
+                if (strategy == gINGEST_STRATEGY_NAMES + gINGEST_STRATEGIES_COUNT)
+                    throw std::runtime_error("Unknown ingest strategy: " + name);
+                config.ingest.push_back((INGEST_STRATEGY)(strategy - gINGEST_STRATEGY_NAMES));
+            }
+        }
+        else if (option == "--nodes") {
+            for (const std::string &count : splitList(value)) {
+                int nodes = std::stoi(count);
+                if (nodes < 1 || nodes > gSAMPLE_MAX_NODES)
+                    throw std::runtime_error("Invalid number of nodes: " + count + " (1 to " + std::to_string(gSAMPLE_MAX_NODES) + ")");
+                config.nodes.push_back(nodes);
+            }
+        }
+        else if (option == "--transport") {
+            const std::string *transport = std::find(gSAMPLE_TRANSPORT_NAMES, gSAMPLE_TRANSPORT_NAMES + gSAMPLE_TRANSPORTS_COUNT, value);
+            if (transport == gSAMPLE_TRANSPORT_NAMES + gSAMPLE_TRANSPORTS_COUNT)
+                throw std::runtime_error("Unknown transport: " + value + " (unix or tcp)");
+            config.transport = (SAMPLE_TRANSPORT)(transport - gSAMPLE_TRANSPORT_NAMES);
+        }
+        else if (option == "--ingest-rate")
+            config.ingestRate = std::max(0, std::stoi(value));
+        else if (option == "--save-baseline")
+            config.baselinePath = value;
+        else if (option == "--compare")
+            config.comparePath = value;
+        else if (option == "--threshold") {
+            config.threshold = std::stod(value) / 100.0;
+            if (config.threshold < 0.0)
+                throw std::runtime_error("Invalid threshold: " + value + " (a percentage)");
+        }
+        else if (option == "--alpha") {
+            config.alpha = std::stod(value);
+            if (config.alpha <= 0.0 || config.alpha >= 1.0)
+                throw std::runtime_error("Invalid significance level: " + value + " (between 0 and 1)");
+        }
+        else if (option == "--budget")
+            config.budgetMs = std::max(1.0, std::stod(value));
+        else if (option == "--rate")
+            config.rate = std::max(0, std::stoi(value));
+        else
+            throw std::runtime_error("Unknown option: " + option);
+    }
+
+    // Everything is run by default
+    if (config.sorts.empty())
+        for (int i = 0; i < Registry::instance().size(); i++)
+            if (Registry::instance()[i].selects == !config.ks.empty())
+                config.sorts.push_back(i);
+    if (config.types.empty())
+        for (int i = 0; i < gELEMENT_TYPES_COUNT; i++)
+            config.types.push_back((ELEMENT_TYPE)i);
+    if (config.sizes.empty())
+        config.sizes.push_back(gMAX_ELEMENTS[8]);
+    if (config.distributions.empty())
+        config.distributions.push_back(SHUFFLED_INPUT);
+    if (config.cutoffs.empty())
+        config.cutoffs.push_back(Registry::instance().networkCutoff());
+    if (config.gaps.empty())
+        config.gaps.push_back(Registry::instance().gapSequence());
+
+    // A baseline is only worth saving with enough repeats for the comparisons to reach alpha
+    if (!config.baselinePath.empty() && !repeatsGiven)
+        config.repeats = gBASELINE_REPEATS;
+    if (!config.baselinePath.empty() && minimumPValue(config.repeats, config.repeats) >= config.alpha) {
+        if (repeatsGiven)
+            printf("Warning: with %d repeats no change can be significant at %g when comparing against %s, use more --repeats\n", config.repeats, config.alpha, config.baselinePath.c_str());
+        else
+            while (minimumPValue(config.repeats, config.repeats) >= config.alpha)
+                config.repeats++;
+    }
+
+    return config;
+}
+
+int Visualizer::Benchmark::run()
+{
+    if (!mConfig.serveAddress.empty())
+        return serve();
+    if (mConfig.scalingMax > 0)
+        return scale();
+    if (!mConfig.ks.empty())
+        return select();
+    if (!mConfig.payloads.empty())
+        return sortRecords();
+    if (!mConfig.argsort.empty())
+        return argsort();
+    if (!mConfig.ingest.empty())
+        return ingest();
+    if (!mConfig.nodes.empty())
+        return sampleSort();
+    if (!mConfig.comparePath.empty())
+        return compare();
+
+    if (mConfig.externalMemory > 0) {
+        printf("algorithm,type,key_bytes,elements,cutoff,gaps,memory_bytes,runs,merge_passes,bytes_read,bytes_written,io_wait_ms,run_ms,merge_ms,time_ms,sorted\n");
+
+        for (int size : mConfig.sizes)
+            for (ELEMENT_TYPE type : mConfig.types)
+                for (size_t cutoff = 0; cutoff < mConfig.cutoffs.size(); cutoff++)
+                    for (size_t gaps = 0; gaps < mConfig.gaps.size(); gaps++)
+                        for (int sort : mConfig.sorts)
+                            if ((cutoff == 0 || Registry::instance()[sort].usesNetworkCutoff) && (gaps == 0 || Registry::instance()[sort].usesGapSequence)) {
+                                Registry::instance().setNetworkCutoff(mConfig.cutoffs[cutoff]);
+                                Registry::instance().setGapSequence(mConfig.gaps[gaps]);
+                                runExternal(sort, type, size);
+                            }
+
+        return 0;
+    }
+
+    BASELINE baseline;
+    baseline.host = baselineHost();
+    baseline.seed = mConfig.seed;
+    baseline.repeats = mConfig.repeats;
+
+    printf("algorithm,type,key_bytes,elements,distribution,cutoff,gaps,comparisons,swaps,writes,reads,traffic_bytes,aux_peak_bytes,allocations,stack_peak_bytes,peak_depth,time_ms,branch_misses,verify_ms,sorted");
+    for (const CACHE_LEVEL &level : mConfig.cache)
+        printf(",%s_hits,%s_misses,%s_writebacks", level.name.c_str(), level.name.c_str(), level.name.c_str());
+    printf("\n");
+
+    for (int size : mConfig.sizes)
+        for (ELEMENT_TYPE type : mConfig.types)
+            for (INPUT_DISTRIBUTION distribution : mConfig.distributions)
+                for (size_t cutoff = 0; cutoff < mConfig.cutoffs.size(); cutoff++)
+                    for (size_t gaps = 0; gaps < mConfig.gaps.size(); gaps++)
+                        for (int sort : mConfig.sorts)
+                            if ((cutoff == 0 || Registry::instance()[sort].usesNetworkCutoff) && (gaps == 0 || Registry::instance()[sort].usesGapSequence)) {
+                                Registry::instance().setNetworkCutoff(mConfig.cutoffs[cutoff]);
+                                Registry::instance().setGapSequence(mConfig.gaps[gaps]);
+                                baseline.entries.push_back(runOne(sort, type, size, distribution));
+                            }
+
+    if (!mConfig.baselinePath.empty()) {
+        char created[32];
+        time_t now = time(NULL);
+        strftime(created, sizeof(created), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+        baseline.created = created;
+        writeBaseline(mConfig.baselinePath, baseline);
+    }
+
+    return 0;
+}
+
+Visualizer::BASELINE_ENTRY Visualizer::Benchmark::runOne(int sort, ELEMENT_TYPE type, int size, INPUT_DISTRIBUTION distribution)
+{
+    ElementArray input = makeElementArray(type, size);
+
+    BASELINE_ENTRY entry;
+    entry.algorithm = Registry::instance()[sort].key;
+    entry.type = gELEMENT_TYPE_NAMES[type];
+    entry.elements = size;
+    entry.distribution = gINPUT_DISTRIBUTION_NAMES[distribution];
+    entry.cutoff = Registry::instance()[sort].usesNetworkCutoff ? Registry::instance().networkCutoff() : 0;
+    entry.gaps = gapsName(sort);
+
+    std::visit([&](auto &values) {
+        typedef typename std::decay<decltype(values)>::type::value_type T;
+
+        // Every repeat sorts the same arranged input
+        arrangeElements(values, distribution, mConfig.seed);
+
+        std::vector<double> times;
+        std::vector<double> verifyTimes;
+        OpCounter counter;
+        MemoryTracker memory;
+        PerfCounter branches;
+        bool sorted = true;
+
+        // A selection is checked against a sorted copy as well
+        std::vector<T> reference;
+        if (Registry::instance()[sort].selects) {
+            reference = values;
+            std::sort(reference.begin(), reference.end(), TotalLess<T>());
+        }
+
+        // Every result must hold the elements of the input
+        MULTISET_CHECKSUM checksum = multisetChecksum(values);
+
+        // The first run fills the caches and faults the pages in, it isn't timed
+        {
+            ElementArray array(values);
+            SortGenerator sorting = Registry::instance()[sort].factory(array);
+            while (sorting.next()) {
+            }
+        }
+
+        for (int r = 0; r < mConfig.repeats; r++) {
+            ElementArray array(values);
+            counter = OpCounter();
+            memory.reset();
+
+            auto start = std::chrono::high_resolution_clock::now();
+            {
+                TRACE_SPAN("sort");
+                MemoryTracker::Scope scope(memory);
+                SortGenerator sorting = Registry::instance()[sort].factory(array);
+                while (sorting.next())
+                    counter.count(sorting.value());
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+
+            times.push_back(Registry::instance().sortTimeMs(sort, start, end));
+
+            const std::vector<T> &result = std::get<std::vector<T>>(array);
+            if (Registry::instance()[sort].selects)
+                sorted = sorted && isSelected(result, reference, selectionCount(size, Registry::instance().selectionK()));
+            if (mConfig.verify) {
+                TRACE_SPAN("verify");
+                SORT_VERIFICATION verification = verifySort(result, checksum, !Registry::instance()[sort].selects);
+                verifyTimes.push_back(verification.timeMs);
+                sorted = sorted && verification.valid();
+            }
+        }
+
+        entry.timesMs = times;
+        entry.sorted = sorted;
+        std::sort(times.begin(), times.end());
+
+        // The changes a baseline comparison reports have to exceed how much separate processes differ
+        if (!mConfig.baselinePath.empty() || !mConfig.comparePath.empty())
+            entry.noise = processNoise(sort, ElementArray(values), times[times.size() / 2]);
+
+        // A comparison prints its own table
+        if (!mConfig.comparePath.empty())
+            return;
+
+        std::sort(verifyTimes.begin(), verifyTimes.end());
+
+        // Bytes of keys touched: a comparison reads two keys, a swap reads and writes two, a write moves one
+        long long traffic = (counter.comparisons * 2 + counter.swaps * 4 + counter.writes * 2 + counter.reads) * (long long)sizeof(T);
+
+        const MEMORY_STATS &stats = memory.stats();
+
+        // Branch misses come from a bare run, the counting and tracking having branches of their own
+        long long misses;
+        {
+            ElementArray array(values);
+            SortGenerator sorting = Registry::instance()[sort].factory(array);
+            branches.start();
+            while (sorting.next()) {
+            }
+            misses = branches.stop();
+        }
+
+        printf("%s,%s,%zu,%d,%s,%d,%s,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%d,%.3f,%lld,%.3f,%s",
+               Registry::instance()[sort].key.c_str(), gELEMENT_TYPE_NAMES[type].c_str(), sizeof(T), size, entry.distribution.c_str(),
+               entry.cutoff, entry.gaps.c_str(), counter.comparisons, counter.swaps, counter.writes, counter.reads, traffic,
+               stats.peakBytes, stats.allocations, stats.peakStackBytes, stats.peakDepth, times[times.size() / 2],
+               misses, verifyTimes.empty() ? 0.0 : verifyTimes[verifyTimes.size() / 2],
+               !mConfig.verify && !Registry::instance()[sort].selects ? "unchecked" : sorted ? "yes" : "no");
+
+        // The cache simulation gets its own untimed run
+        if (!mConfig.cache.empty()) {
+            CacheSimulator cache(mConfig.cache);
+            cache.reset(sizeof(T), size);
+
+            ElementArray array(values);
+            SortGenerator sorting = Registry::instance()[sort].factory(array);
+            while (sorting.next())
+                cache.apply(sorting.value());
+
+            for (size_t level = 0; level < mConfig.cache.size(); level++)
+                printf(",%lld,%lld,%lld", cache.stats(level).hits, cache.stats(level).misses, cache.stats(level).writebacks);
+        }
+        printf("\n");
+    }, input);
+
+    return entry;
+}
+
+int Visualizer::Benchmark::compare()
+{
+    BASELINE baseline = readBaseline(mConfig.comparePath);
+
+    // The runs are repeated on the same inputs, as many times as the baseline ran them
+    mConfig.seed = baseline.seed;
+    mConfig.repeats = std::max(1, baseline.repeats);
+
+    if (baseline.host != baselineHost())
+        printf("Warning: the baseline was recorded on %s, not on this machine\n", baseline.host.c_str());
+    if (minimumPValue(mConfig.repeats, mConfig.repeats) >= mConfig.alpha)
+        printf("Warning: with %d repeats no change can be significant at %g, record the baseline with more --repeats\n", mConfig.repeats, mConfig.alpha);
+
+    char level[32];
+    snprintf(level, sizeof(level), "%g%% interval", (1 - mConfig.alpha) * 100);
+    printf("%-12s %-7s %9s %-9s %12s %12s %8s  %-18s %7s %8s  %s\n", "algorithm", "type", "elements", "input", "baseline_ms", "current_ms", "change", level, "noise", "p", "verdict");
+
+    int regressions = 0, improvements = 0, unchanged = 0, missing = 0;
+
+    for (const BASELINE_ENTRY &entry : baseline.entries) {
+        int sort = Registry::instance().find(entry.algorithm);
+        const std::string *type = std::find(gELEMENT_TYPE_NAMES, gELEMENT_TYPE_NAMES + gELEMENT_TYPES_COUNT, entry.type);
+        const std::string *distribution = std::find(gINPUT_DISTRIBUTION_NAMES, gINPUT_DISTRIBUTION_NAMES + gINPUT_DISTRIBUTIONS_COUNT, entry.distribution);
+        const std::string *gaps = std::find(gGAP_SEQUENCE_NAMES, gGAP_SEQUENCE_NAMES + gGAP_SEQUENCES_COUNT, entry.gaps);
+
+        // An algorithm or option this build doesn't have can't be compared
+        if (sort < 0 || type == gELEMENT_TYPE_NAMES + gELEMENT_TYPES_COUNT || distribution == gINPUT_DISTRIBUTION_NAMES + gINPUT_DISTRIBUTIONS_COUNT ||
+            (entry.gaps != "none" && gaps == gGAP_SEQUENCE_NAMES + gGAP_SEQUENCES_COUNT)) {
+            printf("%-12s %-7s %9d %-9s %12s %12s %8s  %-18s %7s %8s  %s\n", entry.algorithm.c_str(), entry.type.c_str(), entry.elements, entry.distribution.c_str(),
+                   "-", "-", "-", "-", "-", "-", "missing");
+            missing++;
+            continue;
+        }
+
+        Registry::instance().setNetworkCutoff(entry.cutoff);
+        if (entry.gaps != "none")
+            Registry::instance().setGapSequence((GAP_SEQUENCE)(gaps - gGAP_SEQUENCE_NAMES));
+
+        BASELINE_ENTRY current = runOne(sort, (ELEMENT_TYPE)(type - gELEMENT_TYPE_NAMES), entry.elements, (INPUT_DISTRIBUTION)(distribution - gINPUT_DISTRIBUTION_NAMES));
+        TIME_COMPARISON comparison = compareTimes(entry.timesMs, current.timesMs, mConfig.threshold, mConfig.alpha, std::max(entry.noise, current.noise), mConfig.seed);
+
+        const char *verdict;
+        if (entry.sorted && !current.sorted) {
+            verdict = "UNSORTED";
+            regressions++;
+        }
+        else if (comparison.regression) {
+            verdict = "SLOWER";
+            regressions++;
+        }
+        else if (comparison.improvement) {
+            verdict = "faster";
+            improvements++;
+        }
+        else {
+            verdict = "same";
+            unchanged++;
+        }
+
+        char interval[32];
+        snprintf(interval, sizeof(interval), "[%+.1f%%, %+.1f%%]", (comparison.ratioLow - 1) * 100, (comparison.ratioHigh - 1) * 100);
+        printf("%-12s %-7s %9d %-9s %12.3f %12.3f %+7.1f%%  %-18s %6.1f%% %8.4f  %s\n", entry.algorithm.c_str(), entry.type.c_str(), entry.elements, entry.distribution.c_str(),
+               comparison.baselineMs, comparison.currentMs, (comparison.ratio - 1) * 100, interval, comparison.noise * 100, comparison.pValue, verdict);
+    }
+
+    printf("\n%d slower, %d faster, %d unchanged, %d missing (threshold %g%%, alpha %g, %d repeats)\n",
+           regressions, improvements, unchanged, missing, mConfig.threshold * 100, mConfig.alpha, mConfig.repeats);
+
+    return regressions > 0 ? 1 : 0;
+}
+
+void Visualizer::Benchmark::runExternal(int sort, ELEMENT_TYPE type, int size)
+{
+    // Only the type of the array matters, the file is filled with random values
+    ElementArray input = makeElementArray(type, 0);
+
+    std::visit([&](auto &values) {
+        typedef typename std::decay<decltype(values)>::type::value_type T;
+
+        EXTERNAL_SORT_CONFIG config;
+        config.memoryBytes = mConfig.externalMemory;
+        config.runSort = sort;
+        ExternalSort externalSort(config);
+
+        std::vector<std::pair<double, EXTERNAL_SORT_STATS>> results;
+        bool sorted = true;
+
+        for (int r = 0; r < mConfig.repeats; r++) {
+            FILE *in = std::tmpfile();
+            FILE *out = std::tmpfile();
+            if (in == NULL || out == NULL)
+                throw std::runtime_error("Failed to create the files of the external sort");
+
+            ExternalSort::writeRandomElements<T>(in, size, mConfig.seed);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            EXTERNAL_SORT_STATS stats = externalSort.sort<T>(in, out);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            results.push_back({std::chrono::duration<double, std::milli>(end - start).count(), stats});
+            sorted = sorted && ExternalSort::verifySorted<T>(out, size);
+
+            fclose(in);
+            fclose(out);
+        }
+
+        // The I/O counters reported are those of the median run
+        std::sort(results.begin(), results.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        const EXTERNAL_SORT_STATS &stats = results[results.size() / 2].second;
+
+        printf("%s,%s,%zu,%d,%d,%s,%lld,%d,%d,%lld,%lld,%.3f,%.3f,%.3f,%.3f,%s\n",
+               Registry::instance()[sort].key.c_str(), gELEMENT_TYPE_NAMES[type].c_str(), sizeof(T), size,
+               Registry::instance()[sort].usesNetworkCutoff ? Registry::instance().networkCutoff() : 0, gapsName(sort), mConfig.externalMemory, stats.runs, stats.mergePasses, stats.bytesRead, stats.bytesWritten,
+               stats.ioWaitMs, stats.runPhaseMs, stats.mergePhaseMs, results[results.size() / 2].first,
+               sorted ? "yes" : "no");
+    }, input);
+}
+
+int Visualizer::Benchmark::scale()
+{
+    ScalingReport report(mConfig.seed, mConfig.budgetMs, mConfig.repeats);
+    std::vector<int> sizes = ScalingReport::sizes(16, mConfig.scalingMax);
+
+    for (ELEMENT_TYPE type : mConfig.types)
+        for (int sort : mConfig.sorts)
+            report.measure(sort, type, sizes);
+
+    report.print();
+    return 0;
+}
+
+int Visualizer::Benchmark::serve()
+{
+    FeedServer server(mConfig.serveAddress);
+    printf("Serving the sorts on %s\n", mConfig.serveAddress.c_str());
+    fflush(stdout);
+
+    std::mt19937 random(mConfig.seed);
+
+    while (true) {
+        for (int size : mConfig.sizes)
+            for (ELEMENT_TYPE type : mConfig.types)
+                for (int sort : mConfig.sorts) {
+                    ElementArray array = makeElementArray(type, size);
+                    OpCounter counter;
+
+                    std::visit([&](auto &values) {
+                        std::shuffle(values.begin(), values.end(), random);
+
+                        auto bits = [](auto value) {
+                            int64_t a = 0;
+                            memcpy(&a, &value, sizeof(value));
+                            return a;
+                        };
+
+                        // Everything a viewer needs to catch up with the sort, sent when it connects
+                        auto describe = [&](std::vector<FEED_RECORD> &records) {
+                            records.push_back(FEED_RECORD{FEED_SORT, {}, sort, 0});
+                            records.push_back(FEED_RECORD{FEED_BEGIN, {}, type, (int64_t)values.size()});
+                            for (size_t i = 0; i < values.size(); i++)
+                                records.push_back(FEED_RECORD{FEED_VALUE, {}, (int32_t)i, bits(values[i])});
+                            records.push_back(FEED_RECORD{FEED_COMPARISONS, {}, 0, counter.comparisons});
+                            records.push_back(FEED_RECORD{FEED_SWAPS, {}, 0, counter.swaps + counter.writes});
+                        };
+
+                        // The viewers already connected get the new array through the feed
+                        std::vector<FEED_RECORD> records;
+                        describe(records);
+                        for (const FEED_RECORD &record : records)
+                            server.publish(record);
+                        server.setSnapshot(describe);
+
+                        auto start = std::chrono::steady_clock::now();
+                        long long ops = 0;
+
+                        SortGenerator sorting = Registry::instance()[sort].factory(array);
+                        while (sorting.next()) {
+                            const SORT_OP &op = sorting.value();
+                            counter.count(op);
+
+                            switch (op.type) {
+                                case COMPARE_OP:
+                                    server.publish(FEED_RECORD{FEED_COMPARE, {}, op.i, op.j});
+                                    break;
+                                case SWAP_OP:
+                                    server.publish(FEED_RECORD{FEED_SWAP, {}, op.i, op.j});
+                                    break;
+                                case WRITE_OP:
+                                    server.publish(FEED_RECORD{FEED_WRITE, {}, op.i, bits(values[op.i])});
+                                    break;
+                                case READ_OP:
+                                    continue;
+                            }
+
+                            if (++ops % 256 != 0)
+                                continue;
+                            server.publish(FEED_RECORD{FEED_COMPARISONS, {}, 0, counter.comparisons});
+                            server.publish(FEED_RECORD{FEED_SWAPS, {}, 0, counter.swaps + counter.writes});
+
+                            // Paced to the rate, the waits are spent preparing the snapshots of new viewers
+                            if (mConfig.rate > 0) {
+                                auto due = start + std::chrono::microseconds(ops * 1000000 / mConfig.rate);
+                                while (std::chrono::steady_clock::now() < due) {
+                                    server.flush();
+                                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                                }
+                            }
+                        }
+
+                        server.publish(FEED_RECORD{FEED_COMPARISONS, {}, 0, counter.comparisons});
+                        server.publish(FEED_RECORD{FEED_SWAPS, {}, 0, counter.swaps + counter.writes});
+                        server.publish(FEED_RECORD{FEED_END, {}, 0, 0});
+
+                        // The sorted array stays on the viewers for a second
+                        for (int wait = 0; wait < 500; wait++) {
+                            server.flush();
+                            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                        }
+                        server.setSnapshot(nullptr);
+                    }, array);
+                }
+    }
+
+    return 0;
+}
+
+int Visualizer::Benchmark::select()
+{
+    int full = Registry::instance().find("pdq");
+
+    printf("algorithm,type,key_bytes,elements,k,comparisons,swaps,writes,time_ms,full_sort,full_comparisons,full_time_ms,speedup,selected\n");
+
+    for (int size : mConfig.sizes) {
+        for (ELEMENT_TYPE type : mConfig.types) {
+            ElementArray input = makeElementArray(type, size);
+
+            std::visit([&](auto &values) {
+                typedef typename std::decay<decltype(values)>::type::value_type T;
+
+                std::shuffle(values.begin(), values.end(), std::mt19937(mConfig.seed));
+                ElementArray shuffled(values);
+
+                // The full sort is the baseline, and its result tells the k smallest
+                ElementArray sorted;
+                OpCounter fullCounter;
+                double fullTime = timeSort(full, shuffled, mConfig.repeats, sorted, fullCounter);
+                const std::vector<T> &reference = std::get<std::vector<T>>(sorted);
+
+                for (int k : mConfig.ks) {
+                    Registry::instance().setSelectionK(k);
+                    int count = selectionCount(size, k);
+
+                    for (int sort : mConfig.sorts) {
+                        if (!Registry::instance()[sort].selects)
+                            continue;
+
+                        ElementArray result;
+                        OpCounter counter;
+                        double time = timeSort(sort, shuffled, mConfig.repeats, result, counter);
+
+                        printf("%s,%s,%zu,%d,%d,%lld,%lld,%lld,%.3f,%s,%lld,%.3f,%.2f,%s\n",
+                               Registry::instance()[sort].key.c_str(), gELEMENT_TYPE_NAMES[type].c_str(), sizeof(T), size, count,
+                               counter.comparisons, counter.swaps, counter.writes, time, Registry::instance()[full].key.c_str(),
+                               fullCounter.comparisons, fullTime, time > 0 ? fullTime / time : 0.0,
+                               isSelected(std::get<std::vector<T>>(result), reference, count) ? "yes" : "no");
+                    }
+                }
+            }, input);
+        }
+    }
+
+    return 0;
+}
+
+int Visualizer::Benchmark::sortRecords()
+{
+    printf("algorithm,payload_bytes,record_bytes,layout,elements,comparisons,swaps,writes,moved_bytes,time_ms,sorted\n");
+
+    for (int size : mConfig.sizes)
+        for (int payload : mConfig.payloads)
+            for (int sort : mConfig.sorts)
+                if (!Registry::instance()[sort].selects)
+                    runRecords(sort, payload, size);
+
+    return 0;
+}
+
+void Visualizer::Benchmark::runRecords(int sort, int payload, int size)
+{
+    // The keys are the int64 ladder, shuffled
+    std::vector<int64_t> keys;
+    fillElements(keys, size);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(mConfig.seed));
+
+    RecordArray input = makeRecordArray(payload);
+
+    std::visit([&](auto &records) {
+        typedef typename std::decay<decltype(records)>::type::value_type R;
+
+        if constexpr (!std::is_same<R, KEY_INDEX>::value) {
+            records.resize(size);
+            for (int i = 0; i < size; i++)
+                fillRecord(records[i], keys[i]);
+
+            // Array of structs: the algorithm moves the whole records
+            {
+                std::vector<double> times;
+                OpCounter counter;
+                bool sorted = true;
+
+                for (int r = 0; r < mConfig.repeats; r++) {
+                    RecordArray array(records);
+                    counter = OpCounter();
+
+                    auto start = std::chrono::high_resolution_clock::now();
+                    SortGenerator sorting = Registry::instance()[sort].factory(array);
+                    while (sorting.next())
+                        counter.count(sorting.value());
+                    auto end = std::chrono::high_resolution_clock::now();
+                    times.push_back(Registry::instance().sortTimeMs(sort, start, end));
+
+                    const std::vector<R> &result = std::get<std::vector<R>>(array);
+                    sorted = sorted && std::is_sorted(result.begin(), result.end()) &&
+                             std::all_of(result.begin(), result.end(), [](const R &record) { return recordIntact(record); });
+                }
+
+                std::sort(times.begin(), times.end());
+                long long moved = (counter.swaps * 2 + counter.writes) * (long long)sizeof(R);
+
+                printf("%s,%d,%zu,aos,%d,%lld,%lld,%lld,%lld,%.3f,%s\n", Registry::instance()[sort].key.c_str(), payload, sizeof(R), size,
+                       counter.comparisons, counter.swaps, counter.writes, moved, times[times.size() / 2], sorted ? "yes" : "no");
+            }
+
+            // Struct of arrays: the algorithm moves the keys and their index, the payloads are permuted once at the end
+            {
+                typedef decltype(R::payload) PAYLOAD;
+                std::vector<PAYLOAD> payloads(size);
+                for (int i = 0; i < size; i++)
+                    std::memcpy(payloads[i], records[i].payload, sizeof(PAYLOAD));
+
+                std::vector<double> times;
+                OpCounter counter;
+                bool sorted = true;
+
+                for (int r = 0; r < mConfig.repeats; r++) {
+                    RecordArray array(std::in_place_type<std::vector<KEY_INDEX>>, size);
+                    std::vector<KEY_INDEX> &pairs = std::get<std::vector<KEY_INDEX>>(array);
+                    for (int i = 0; i < size; i++)
+                        pairs[i] = {records[i].key, i};
+                    std::vector<PAYLOAD> permuted(size);
+                    counter = OpCounter();
+
+                    auto start = std::chrono::high_resolution_clock::now();
+                    SortGenerator sorting = Registry::instance()[sort].factory(array);
+                    while (sorting.next())
+                        counter.count(sorting.value());
+                    auto permuting = std::chrono::high_resolution_clock::now();
+                    for (int i = 0; i < size; i++)
+                        std::memcpy(permuted[i], payloads[pairs[i].index], sizeof(PAYLOAD));
+                    auto end = std::chrono::high_resolution_clock::now();
+                    times.push_back(Registry::instance().sortTimeMs(sort, start, permuting) + std::chrono::duration<double, std::milli>(end - permuting).count());
+
+                    sorted = sorted && std::is_sorted(pairs.begin(), pairs.end());
+                    for (int i = 0; i < size && sorted; i++)
+                        sorted = std::memcmp(permuted[i], &pairs[i].key, sizeof(int64_t)) == 0;
+                }
+
+                std::sort(times.begin(), times.end());
+                long long moved = (counter.swaps * 2 + counter.writes) * (long long)sizeof(KEY_INDEX) + (long long)size * sizeof(PAYLOAD);
+
+                printf("%s,%d,%zu,soa,%d,%lld,%lld,%lld,%lld,%.3f,%s\n", Registry::instance()[sort].key.c_str(), payload, sizeof(KEY_INDEX) + sizeof(PAYLOAD), size,
+                       counter.comparisons, counter.swaps, counter.writes, moved, times[times.size() / 2], sorted ? "yes" : "no");
+            }
+        }
+    }, input);
+}
+
+int Visualizer::Benchmark::argsort()
+{
+    printf("algorithm,type,elements,mode,element_bytes,comparisons,swaps,writes,moved_bytes,time_ms,sorted\n");
+
+    for (int size : mConfig.sizes)
+        for (ELEMENT_TYPE type : mConfig.types)
+            for (int sort : mConfig.sorts)
+                if (!Registry::instance()[sort].selects)
+                    for (ARGSORT_MODE mode : mConfig.argsort)
+                        runArgsort(sort, type, size, mode);
+
+    return 0;
+}
+
+void Visualizer::Benchmark::runArgsort(int sort, ELEMENT_TYPE type, int size, ARGSORT_MODE mode)
+{
+    ElementArray input = makeElementArray(type, size);
+
+    std::visit([&](auto &values) {
+        typedef typename std::decay<decltype(values)>::type::value_type T;
+        std::shuffle(values.begin(), values.end(), std::mt19937(mConfig.seed));
+
+        MULTISET_CHECKSUM checksum = multisetChecksum(values);
+        std::vector<double> times;
+        OpCounter counter;
+        int elementBytes = sizeof(T);
+        bool sorted = true;
+
+        for (int r = 0; r < mConfig.repeats; r++) {
+            ElementArray array(values);
+            IndexArray indices;
+            counter = OpCounter();
+
+            auto start = std::chrono::high_resolution_clock::now();
+            auto extracted = start;
+            {
+                TRACE_SPAN("sort");
+                SortGenerator sorting;
+                if (mode == DIRECT_SORT)
+                    sorting = Registry::instance()[sort].factory(array);
+                else {
+                    indices = makeIndexArray(mode, input);
+                    extracted = std::chrono::high_resolution_clock::now();
+                    sorting = Registry::instance()[sort].factory(indices, input);
+                }
+                while (sorting.next())
+                    counter.count(sorting.value());
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            times.push_back(std::chrono::duration<double, std::milli>(extracted - start).count() + Registry::instance().sortTimeMs(sort, extracted, end));
+
+            if (mode != DIRECT_SORT) {
+                elementBytes = std::visit([](const auto &order) { return (int)sizeof(order[0]); }, indices);
+                array = gatherKeys(indices, values);
+            }
+            if (mConfig.verify)
+                sorted = sorted && verifySort(std::get<std::vector<T>>(array), checksum, true).valid();
+        }
+
+        std::sort(times.begin(), times.end());
+        long long moved = (counter.swaps * 2 + counter.writes) * (long long)elementBytes;
+
+        printf("%s,%s,%d,%s,%d,%lld,%lld,%lld,%lld,%.3f,%s\n", Registry::instance()[sort].key.c_str(), gELEMENT_TYPE_NAMES[type].c_str(), size,
+               gARGSORT_MODE_NAMES[mode].c_str(), elementBytes, counter.comparisons, counter.swaps, counter.writes, moved,
+               times[times.size() / 2], mConfig.verify ? (sorted ? "yes" : "no") : "unchecked");
+    }, input);
+}
+
+int Visualizer::Benchmark::ingest()
+{
+    printf("strategy,type,elements,rate,comparisons,writes,merges,p50_ns,p99_ns,p999_ns,max_ns,throughput,sorted\n");
+
+    for (int size : mConfig.sizes)
+        for (ELEMENT_TYPE type : mConfig.types)
+            for (INGEST_STRATEGY strategy : mConfig.ingest)
+                runIngest(strategy, type, size);
+
+    return 0;
+}
+
+void Visualizer::Benchmark::runIngest(INGEST_STRATEGY strategy, ELEMENT_TYPE type, int size)
+{
+    ElementArray input = makeElementArray(type, size);
+
+    std::visit([&](auto &arrivals) {
+        typedef typename std::decay<decltype(arrivals)>::type::value_type T;
+        std::shuffle(arrivals.begin(), arrivals.end(), std::mt19937(mConfig.seed));
+
+        StreamIngest<T> structure(strategy);
+        std::vector<double> latencies(size);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < size; i++) {
+            auto arrival = std::chrono::high_resolution_clock::now();
+
+            // On a schedule, an element that arrived while the last insert ran waits for it
+            if (mConfig.ingestRate > 0) {
+                auto due = start + std::chrono::nanoseconds((long long)i * 1000000000LL / mConfig.ingestRate);
+                if (arrival < due)
+                    std::this_thread::sleep_until(due);
+                arrival = due;
+            }
+
+            structure.insert(arrivals[i]);
+            auto end = std::chrono::high_resolution_clock::now();
+            latencies[i] = std::chrono::duration<double, std::nano>(end - arrival).count();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        // The LSM runs are merged for the check, outside of the time
+        INGEST_STATS stats = structure.stats();
+        structure.compact();
+        std::vector<T> result;
+        structure.layout(result);
+
+        std::vector<T> sorted(arrivals);
+        std::sort(sorted.begin(), sorted.end(), TotalLess<T>());
+        auto same = [](const T &a, const T &b) { return !TotalLess<T>()(a, b) && !TotalLess<T>()(b, a); };
+        bool valid = result.size() == sorted.size() && std::equal(result.begin(), result.end(), sorted.begin(), same);
+
+        INGEST_LATENCY latency = latencyPercentiles(latencies);
+        printf("%s,%s,%d,%d,%lld,%lld,%lld,%.0f,%.0f,%.0f,%.0f,%.0f,%s\n", gINGEST_STRATEGY_NAMES[strategy].c_str(), gELEMENT_TYPE_NAMES[type].c_str(),
+               size, mConfig.ingestRate, stats.comparisons, stats.writes, stats.merges, latency.p50, latency.p99, latency.p999, latency.max,
+               seconds > 0 ? size / seconds : 0.0, valid ? "yes" : "no");
+    }, input);
+}
+
+int Visualizer::Benchmark::sampleSort()
+{
+    printf("algorithm,type,elements,nodes,transport,local_sort_ms,merge_ms,comm_ms,comm_bytes,setup_ms,imbalance,time_ms,sorted\n");
+
+    for (int size : mConfig.sizes)
+        for (ELEMENT_TYPE type : mConfig.types)
+            for (int nodes : mConfig.nodes)
+                for (int sort : mConfig.sorts)
+                    if (!Registry::instance()[sort].selects)
+                        runSampleSort(sort, type, size, nodes);
+
+    return 0;
+}
+
+void Visualizer::Benchmark::runSampleSort(int sort, ELEMENT_TYPE type, int size, int nodes)
+{
+    ElementArray input = makeElementArray(type, size);
+
+    std::visit([&](auto &values) {
+        typedef typename std::decay<decltype(values)>::type::value_type T;
+        std::shuffle(values.begin(), values.end(), std::mt19937(mConfig.seed));
+        MULTISET_CHECKSUM checksum = multisetChecksum(values);
+
+        SAMPLE_SORT_CONFIG config;
+        config.nodes = nodes;
+        config.transport = mConfig.transport;
+        config.localSort = sort;
+        SampleSort sampleSort(config);
+
+        std::vector<SAMPLE_SORT_STATS> results;
+        bool sorted = true;
+
+        for (int r = 0; r < mConfig.repeats; r++) {
+            std::vector<T> result(values);
+            results.push_back(sampleSort.sort(result));
+            if (mConfig.verify)
+                sorted = sorted && verifySort(result, checksum).valid();
+        }
+
+        // The counters reported are those of the median run
+        std::sort(results.begin(), results.end(), [](const auto &a, const auto &b) { return a.timeMs < b.timeMs; });
+        const SAMPLE_SORT_STATS &stats = results[results.size() / 2];
+
+        double localSortMs = 0.0, mergeMs = 0.0, commMs = 0.0;
+        for (const SAMPLE_NODE_STATS &node : stats.nodes) {
+            localSortMs = std::max(localSortMs, node.localSortMs);
+            mergeMs = std::max(mergeMs, node.mergeMs);
+            commMs = std::max(commMs, node.commMs);
+        }
+
+        printf("%s,%s,%d,%d,%s,%.3f,%.3f,%.3f,%lld,%.3f,%.3f,%.3f,%s\n", Registry::instance()[sort].key.c_str(), gELEMENT_TYPE_NAMES[type].c_str(),
+               size, nodes, gSAMPLE_TRANSPORT_NAMES[mConfig.transport].c_str(), localSortMs, mergeMs, commMs, stats.commBytes(), stats.setupMs,
+               stats.imbalance(), stats.timeMs, !mConfig.verify ? "unchecked" : sorted ? "yes" : "no");
+    }, input);
+}
@@ -0,0 +1,181 @@
+//
+//  Benchmark.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Benchmark_hpp
+#define Benchmark_hpp
+
+#include <vector>
+#include <string>
+
+#include "Utilities.hpp"
+#include "CacheSimulator.hpp"
+#include "StreamIngest.hpp"
+#include "SampleSort.hpp"
+#include "Argsort.hpp"
+#include "Baseline.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief The options of a headless benchmark run
+     */
+    typedef struct BENCHMARK_CONFIG
+    {
+        std::vector<int> sorts;             /*! The algorithms to run (their index in the Registry) */
+        std::vector<ELEMENT_TYPE> types;    /*! The element types to run them on */
+        std::vector<int> sizes;             /*! The numbers of elements to run them on */
+        std::vector<INPUT_DISTRIBUTION> distributions; /*! The orders of the elements before the sort */
+        std::vector<int> cutoffs;           /*! The sorting network cutoffs of quick sort and merge sort */
+        std::vector<GAP_SEQUENCE> gaps;     /*! The gap sequences of shell sort */
+        std::vector<int> ks;                /*! The k of the selection algorithms (0 for the median), empty to sort */
+        std::vector<int> payloads;          /*! The payload bytes of the records sorted, empty to sort bare keys */
+        std::vector<ARGSORT_MODE> argsort;  /*! Whether the elements, their indices or their cached keys are moved, empty for the elements only */
+        int repeats = 3;                    /*! How many times each run is repeated (the median time is reported), more when saving a baseline */
+        unsigned seed = 42;                 /*! The seed of the shuffle, so runs are reproducible */
+        bool verify = true;                 /*! Whether every result is checked to be a sorted permutation of the input */
+        std::vector<CACHE_LEVEL> cache;     /*! The simulated cache hierarchy, empty to skip the simulation */
+        long long externalMemory = 0;       /*! The memory budget of the external sort, 0 to sort in memory */
+        std::string serveAddress;           /*! The address the sorts are streamed on, empty to print the CSV */
+        int rate = 20000;                   /*! The operations streamed per second, 0 for as fast as possible */
+        std::vector<INGEST_STRATEGY> ingest; /*! The structures the elements are streamed into, empty to sort */
+        int ingestRate = 0;                 /*! The elements arriving per second, 0 for as fast as possible */
+        std::vector<int> nodes;             /*! The worker processes of the sample sort, empty to sort in this process */
+        SAMPLE_TRANSPORT transport = UNIX_TRANSPORT; /*! The sockets between the workers of the sample sort */
+        int scalingMax = 0;                 /*! The largest size of the scaling report, 0 to skip it */
+        double budgetMs = 1000.0;           /*! The longest run of the scaling report before its sizes stop growing */
+        std::string baselinePath;           /*! The file the times of every run are saved to as a baseline, empty to skip it */
+        std::string comparePath;            /*! The baseline whose runs are repeated and compared, empty to print the CSV */
+        double threshold = 0.05;            /*! The relative change of the median time below which no change is reported */
+        double alpha = 0.05;                /*! The significance level of the comparisons */
+    } BENCHMARK_CONFIG;
+
+    /*!
+     * @brief Runs the algorithms without a window and prints their statistics as CSV
+     */
+    class Benchmark
+    {
+    public:
+        /*!
+         * @brief Benchmark constructor
+         * @param config The options of the run
+         */
+        Benchmark(const BENCHMARK_CONFIG &config);
+
+        /*!
+         * @brief Parses the command line options of the headless mode
+         * @details --sorts quick,merge --types int32,double --sizes 1000,10000 --distributions shuffled,sorted,reversed,nearly,few|all --cutoffs 0,16 --gaps knuth,ciura|all --repeats 3 --seed 42 --verify on|off
+         *          --cache default|L1:32K:8,L2:256K:8 --external 64M --serve unix:PATH|tcp:PORT --rate 20000
+         *          --scaling 4M --budget 1000 --k 10,1000,median --records 16,256
+         *          --ingest binary,lsm,btree|all --ingest-rate 100000 --nodes 2,4,8 --transport unix|tcp
+         *          --argsort direct,indirect,cached|all --save-baseline FILE --compare FILE --threshold 5 --alpha 0.05
+         *          (--plugins and --trace are handled by main)
+         * @throws std::runtime_error if an option is not valid
+         */
+        static BENCHMARK_CONFIG parseArguments(int argc, char *argv[]);
+
+        /*!
+         * @brief Runs every combination of algorithm, element type, size, cutoff and gap sequence
+         * @details Algorithms that don't use the network cutoff or the gap sequence only run with the first one.
+         * @return The exit code of the program
+         */
+        int run();
+
+    private:
+        BENCHMARK_CONFIG mConfig; /*! The options of the run */
+
+        /*!
+         * @brief Runs a single algorithm on a single element type, size and distribution and prints its
+         *        CSV row, unless comparing with a baseline
+         * @details An untimed run comes first. When saving or comparing a baseline the run is also
+         *          timed in separate processes, whose spread is its noise.
+         * @return The times of the repeats
+         */
+        BASELINE_ENTRY runOne(int sort, ELEMENT_TYPE type, int size, INPUT_DISTRIBUTION distribution);
+
+        /*!
+         * @brief Repeats every run of the baseline with the same seed and repeats, tests whether
+         *        its times changed and prints a table of the differences
+         * @return 1 if a run got significantly slower or no longer sorts, 0 otherwise
+         */
+        int compare();
+
+        /*!
+         * @brief Sorts a file of the given element type and size with the external sort, the
+         *        algorithm sorting the chunks, and prints its CSV row
+         */
+        void runExternal(int sort, ELEMENT_TYPE type, int size);
+
+        /*!
+         * @brief Streams the sorts to the viewers connected to the serve address, over and over
+         * @details Never returns, the server runs until the process is killed.
+         */
+        int serve();
+
+        /*!
+         * @brief Fits the growth of every algorithm over the sizes from 16 to the scaling maximum
+         *        and prints the fits and crossovers
+         */
+        int scale();
+
+        /*!
+         * @brief Runs the selection algorithms for every k and compares each with a full sort of
+         *        the same array by pattern-defeating quick sort
+         */
+        int select();
+
+        /*!
+         * @brief Sorts records of every payload size with each algorithm, both as an array of
+         *        structs and as a struct of arrays, and prints the bytes moved and the time
+         */
+        int sortRecords();
+
+        /*!
+         * @brief Runs a single algorithm on records of one payload size in both layouts and prints their CSV rows
+         */
+        void runRecords(int sort, int payload, int size);
+
+        /*!
+         * @brief Sorts every array directly, through its indices and through its indices with
+         *        cached keys, and prints the bytes moved and the time of each
+         */
+        int argsort();
+
+        /*!
+         * @brief Runs a single algorithm on one element type and size in one argsort mode and prints its CSV row
+         * @details The time of the indirect modes includes creating the indices and extracting the keys,
+         *          not permuting the elements by the sorted indices.
+         */
+        void runArgsort(int sort, ELEMENT_TYPE type, int size, ARGSORT_MODE mode);
+
+        /*!
+         * @brief Streams the elements into every ingest structure and prints the latency
+         *        percentiles of the inserts and the sustained throughput
+         */
+        int ingest();
+
+        /*!
+         * @brief Streams a shuffled array into one structure and prints its CSV row
+         * @details With an ingest rate the elements arrive on a fixed schedule and the latency of an
+         *          insert runs from its arrival, so a structure falling behind queues the next ones.
+         */
+        void runIngest(INGEST_STRATEGY strategy, ELEMENT_TYPE type, int size);
+
+        /*!
+         * @brief Sorts the arrays with the sample sort for every number of nodes, each algorithm
+         *        sorting the shards, and prints the local and communication costs
+         */
+        int sampleSort();
+
+        /*!
+         * @brief Runs the sample sort of one array and prints its CSV row
+         * @details The times of the nodes are those of the slowest one, the bytes those of every node.
+         */
+        void runSampleSort(int sort, ELEMENT_TYPE type, int size, int nodes);
+    };
+}
+
+#endif /* Benchmark_hpp */
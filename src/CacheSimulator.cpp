@@ -0,0 +1,157 @@
+//
+//  CacheSimulator.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <stdexcept>
+#include <sstream>
+
+#include "CacheSimulator.hpp"
+
+Visualizer::CacheSimulator::CacheSimulator(const std::vector<CACHE_LEVEL> &levels)
+    : mLevels(levels)
+{
+    reset(mElementSize, 0);
+}
+
+void Visualizer::CacheSimulator::reset(int elementSize, int elements)
+{
+    mElementSize = elementSize;
+    mClock = 0;
+
+    mWays.assign(mLevels.size(), std::vector<Way>());
+    for (size_t level = 0; level < mLevels.size(); level++)
+        mWays[level].assign(mLevels[level].size / mLevels[level].lineSize, Way());
+
+    mStats.assign(mLevels.size(), CACHE_STATS());
+    mIndexMisses.assign(elements, 0);
+}
+
+void Visualizer::CacheSimulator::apply(const SORT_OP &op)
+{
+    switch (op.type) {
+        case COMPARE_OP:
+            access(op.i, false);
+            access(op.j, false);
+            break;
+        case SWAP_OP:
+            access(op.i, false);
+            access(op.j, false);
+            access(op.i, true);
+            access(op.j, true);
+            break;
+        case WRITE_OP:
+            if (op.j >= 0)
+                access(op.j, false);
+            access(op.i, true);
+            break;
+        case READ_OP:
+            access(op.i, false);
+            break;
+    }
+}
+
+void Visualizer::CacheSimulator::access(int index, bool write)
+{
+    if (index < 0 || mLevels.empty())
+        return;
+
+    mClock++;
+    uint64_t address = (uint64_t)index * mElementSize;
+
+    // Go down the hierarchy until a level holds the line, every level missed gets filled
+    for (size_t level = 0; level < mLevels.size(); level++) {
+        if (lookup(level, address, write))
+            return;
+
+        if (index < (int)mIndexMisses.size())
+            mIndexMisses[index]++;
+    }
+}
+
+bool Visualizer::CacheSimulator::lookup(int level, uint64_t address, bool write)
+{
+    const CACHE_LEVEL &geometry = mLevels[level];
+    uint64_t line = address / geometry.lineSize;
+    uint64_t sets = mWays[level].size() / geometry.associativity;
+    Way *set = &mWays[level][(line % sets) * geometry.associativity];
+    uint64_t tag = line / sets;
+
+    Way *victim = set;
+    for (int way = 0; way < geometry.associativity; way++) {
+        if (set[way].valid && set[way].tag == tag) {
+            set[way].lastUse = mClock;
+            set[way].dirty = set[way].dirty || write;
+            mStats[level].hits++;
+            return true;
+        }
+
+        // An empty way is always the victim, otherwise the least recently used one
+        if (!victim->valid)
+            continue;
+        if (!set[way].valid || set[way].lastUse < victim->lastUse)
+            victim = &set[way];
+    }
+
+    mStats[level].misses++;
+    if (victim->valid && victim->dirty)
+        mStats[level].writebacks++;
+
+    victim->valid = true;
+    victim->tag = tag;
+    victim->lastUse = mClock;
+    victim->dirty = write;
+    return false;
+}
+
+std::vector<Visualizer::CACHE_LEVEL> Visualizer::CacheSimulator::parseLevels(const std::string &description)
+{
+    std::vector<CACHE_LEVEL> levels;
+    std::stringstream list(description);
+    std::string item;
+
+    while (std::getline(list, item, ',')) {
+        std::stringstream fields(item);
+        std::string name, size, ways, line;
+
+        std::getline(fields, name, ':');
+        std::getline(fields, size, ':');
+        std::getline(fields, ways, ':');
+        std::getline(fields, line, ':');
+
+        if (name.empty() || size.empty() || ways.empty())
+            throw std::runtime_error("Invalid cache level: " + item);
+
+        CACHE_LEVEL level;
+        level.name = name;
+        level.associativity = std::stoi(ways);
+        level.lineSize = line.empty() ? 64 : std::stoi(line);
+
+        // Sizes accept a K or M suffix
+        level.size = std::stoi(size);
+        if (size.back() == 'K' || size.back() == 'k')
+            level.size *= 1024;
+        else if (size.back() == 'M' || size.back() == 'm')
+            level.size *= 1024 * 1024;
+
+        if (level.associativity <= 0 || level.lineSize <= 0 || level.size < level.lineSize * level.associativity ||
+            level.size % (level.lineSize * level.associativity) != 0)
+            throw std::runtime_error("Invalid cache geometry: " + item);
+
+        levels.push_back(level);
+    }
+
+    return levels;
+}
+
+std::vector<Visualizer::CACHE_LEVEL> Visualizer::CacheSimulator::defaultLevels()
+{
+    return parseLevels("L1:32K:8,L2:256K:8,LLC:8M:16");
+}
+
+std::vector<Visualizer::CACHE_LEVEL> Visualizer::CacheSimulator::windowLevels()
+{
+    return parseLevels("L1:256:2,L2:1K:4,LLC:2K:8");
+}
@@ -0,0 +1,135 @@
+//
+//  CacheSimulator.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef CacheSimulator_hpp
+#define CacheSimulator_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "Utilities.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief A struct that represents the geometry of a cache level
+     */
+    typedef struct CACHE_LEVEL
+    {
+        std::string name;  /*! The name used in the reports, e.g. L1 */
+        int size;          /*! The capacity in bytes */
+        int associativity; /*! The number of ways of each set */
+        int lineSize;      /*! The size of a line in bytes */
+    } CACHE_LEVEL;
+
+    /*!
+     * @brief A struct that represents the counters of a cache level
+     */
+    typedef struct CACHE_STATS
+    {
+        long long hits = 0;
+        long long misses = 0;
+        long long writebacks = 0; /*! Dirty lines evicted to the next level */
+    } CACHE_STATS;
+
+    /*!
+     * @brief Simulates a write-back, write-allocate cache hierarchy with LRU replacement
+     * @details The array is laid out from address 0, element i occupying
+     *          [i * elementSize, (i + 1) * elementSize). An access that misses a level goes on
+     *          to the next one and fills every level it missed. Nothing depends on the host
+     *          machine, so the counters are the same everywhere.
+     */
+    class CacheSimulator
+    {
+    public:
+        /*!
+         * @brief CacheSimulator constructor
+         * @param levels The cache levels, from the closest to the farthest
+         */
+        CacheSimulator(const std::vector<CACHE_LEVEL> &levels = std::vector<CACHE_LEVEL>());
+
+        /*!
+         * @brief Empties the caches and resets the counters
+         * @param elementSize The size in bytes of an element of the array
+         * @param elements The number of elements of the array
+         */
+        void reset(int elementSize, int elements);
+
+        /*!
+         * @brief Feeds the reads and writes of an operation of an algorithm into the caches
+         */
+        void apply(const SORT_OP &op);
+
+        /*!
+         * @brief Simulates a single access to an element
+         * @param index The index of the element
+         * @param write Whether the element is written
+         */
+        void access(int index, bool write);
+
+        /*!
+         * @brief The geometry of the levels
+         */
+        const std::vector<CACHE_LEVEL> &levels() const { return mLevels; }
+
+        /*!
+         * @brief The counters of the level at the given position
+         */
+        const CACHE_STATS &stats(int level) const { return mStats[level]; }
+
+        /*!
+         * @brief The misses (summed over every level) caused by each element of the array
+         */
+        const std::vector<long long> &indexMisses() const { return mIndexMisses; }
+
+        /*!
+         * @brief Whether the hierarchy has at least one level
+         */
+        bool enabled() const { return !mLevels.empty(); }
+
+        /*!
+         * @brief Parses a hierarchy like L1:32K:8,L2:256K:8,LLC:8M:16 (name:size:ways[:line])
+         * @throws std::runtime_error if the description is not valid
+         */
+        static std::vector<CACHE_LEVEL> parseLevels(const std::string &description);
+
+        /*!
+         * @brief A hierarchy shaped like a desktop CPU, used by the headless mode
+         */
+        static std::vector<CACHE_LEVEL> defaultLevels();
+
+        /*!
+         * @brief The same shape scaled down so the arrays shown in the window overflow it
+         */
+        static std::vector<CACHE_LEVEL> windowLevels();
+
+    private:
+        struct Way
+        {
+            uint64_t tag = 0;
+            uint64_t lastUse = 0;
+            bool valid = false;
+            bool dirty = false;
+        };
+
+        std::vector<CACHE_LEVEL> mLevels;       /*! The geometry of the levels */
+        std::vector<std::vector<Way>> mWays;    /*! The ways of every set of every level, set after set */
+        std::vector<CACHE_STATS> mStats;        /*! The counters of every level */
+        std::vector<long long> mIndexMisses;    /*! The misses caused by each element */
+        uint64_t mClock = 0;                    /*! Timestamp of the accesses, used by LRU */
+        int mElementSize = 4;                   /*! The size of an element in bytes */
+
+        /*!
+         * @brief Looks a line up in a level, filling it on a miss
+         * @return true on a hit
+         */
+        bool lookup(int level, uint64_t address, bool write);
+    };
+}
+
+#endif /* CacheSimulator_hpp */
@@ -0,0 +1,246 @@
+//
+//  CostModel.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+
+#include "CostModel.hpp"
+#include "Elements.hpp"
+#include "Registry.hpp"
+
+namespace
+{
+    using namespace Visualizer;
+
+    // The size of the arrays arranged in every distribution to measure its features
+    const int gFEATURE_ARRAY_SIZE = 4096;
+
+    double median(std::vector<double> values)
+    {
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    }
+
+    // How far apart the orders described by two sets of features are
+    double featureDistance(const INPUT_FEATURES &a, const INPUT_FEATURES &b)
+    {
+        double descents = a.descents - b.descents;
+        double inversions = a.inversions - b.inversions;
+        double duplicates = a.duplicates - b.duplicates;
+        return std::sqrt(descents * descents + inversions * inversions + duplicates * duplicates);
+    }
+
+    // The features of an array of the given type arranged in a distribution
+    INPUT_FEATURES distributionFeatures(ELEMENT_TYPE type, INPUT_DISTRIBUTION distribution)
+    {
+        ElementArray array = makeElementArray(type, gFEATURE_ARRAY_SIZE);
+        return std::visit([distribution](auto &values) {
+            arrangeElements(values, distribution, 42);
+            return sampleFeatures(values, 42);
+        }, array);
+    }
+}
+
+template <typename T>
+Visualizer::INPUT_FEATURES Visualizer::sampleFeatures(const std::vector<T> &array, unsigned seed)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    INPUT_FEATURES features;
+    TotalLess<T> less;
+    int n = array.size();
+    if (n < 2)
+        return features;
+
+    std::mt19937 generator(seed);
+    int descents = 0, inversions = 0;
+
+    for (int s = 0; s < gFEATURE_SAMPLES; s++) {
+        int i = generator() % (n - 1);
+        descents += less(array[i + 1], array[i]);
+
+        int a = generator() % n, b = generator() % n;
+        if (a == b)
+            b = (a + 1) % n;
+        if (a > b)
+            std::swap(a, b);
+        inversions += less(array[b], array[a]);
+    }
+
+    features.descents = (double)descents / gFEATURE_SAMPLES;
+    features.inversions = (double)inversions / gFEATURE_SAMPLES;
+
+    // One element from each of as many strides, positions drawn with replacement would repeat even when the elements don't
+    std::vector<T> sample;
+    if (n <= 2 * gFEATURE_SAMPLES)
+        sample = array;
+    else
+        for (int s = 0; s < gFEATURE_SAMPLES; s++)
+            sample.push_back(array[(long long)s * n / gFEATURE_SAMPLES + generator() % (n / gFEATURE_SAMPLES)]);
+    std::sort(sample.begin(), sample.end(), less);
+
+    int repeated = 0;
+    for (size_t i = 1; i < sample.size(); i++)
+        repeated += !less(sample[i - 1], sample[i]);
+    features.duplicates = (double)repeated / sample.size();
+
+    // The NaNs sort last, the range ends at the last number
+    size_t last = sample.size();
+    while (last > 1 && isNaN(sample[last - 1]))
+        last--;
+    features.range = isNaN(sample[0]) ? 0.0 : (double)sample[last - 1] - (double)sample[0];
+
+    auto end = std::chrono::high_resolution_clock::now();
+    features.sampleMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    return features;
+}
+
+void Visualizer::CostModel::calibrate(const BASELINE &baseline)
+{
+    mFits.clear();
+
+    // The runs of a built-in sort on one element type and distribution, its median time at every size
+    // (runs with another network cutoff or gap sequence get their own fit, they don't scale alike)
+    struct GROUP
+    {
+        std::string algorithm;
+        std::string type;
+        std::string distribution;
+        int cutoff;
+        std::string gaps;
+        std::vector<std::pair<double, double>> points;
+    };
+    std::vector<GROUP> groups;
+
+    for (const BASELINE_ENTRY &entry : baseline.entries) {
+        int sort = Registry::instance().find(entry.algorithm);
+        if (sort < 0 || Registry::instance()[sort].isPlugin || Registry::instance()[sort].selects || !entry.sorted || entry.elements < 2)
+            continue;
+
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const GROUP &g) {
+            return g.algorithm == entry.algorithm && g.type == entry.type && g.distribution == entry.distribution &&
+                   g.cutoff == entry.cutoff && g.gaps == entry.gaps;
+        });
+        if (group == groups.end())
+            group = groups.insert(groups.end(), {entry.algorithm, entry.type, entry.distribution, entry.cutoff, entry.gaps, {}});
+
+        double time = median(entry.timesMs);
+        if (time > 0.0)
+            group->points.push_back({(double)entry.elements, time});
+    }
+
+    for (const GROUP &group : groups) {
+        // A single size leaves no exponent to fit, and guessing one would rank the algorithms alike at every size
+        if (group.points.size() < 2)
+            continue;
+
+        const std::string *type = std::find(gELEMENT_TYPE_NAMES, gELEMENT_TYPE_NAMES + gELEMENT_TYPES_COUNT, group.type);
+        const std::string *distribution = std::find(gINPUT_DISTRIBUTION_NAMES, gINPUT_DISTRIBUTION_NAMES + gINPUT_DISTRIBUTIONS_COUNT, group.distribution);
+        if (type == gELEMENT_TYPE_NAMES + gELEMENT_TYPES_COUNT || distribution == gINPUT_DISTRIBUTION_NAMES + gINPUT_DISTRIBUTIONS_COUNT)
+            continue;
+
+        COST_FIT fit;
+        fit.algorithm = group.algorithm;
+        fit.type = group.type;
+        fit.cutoff = group.cutoff;
+        fit.gaps = group.gaps;
+        fit.features = distributionFeatures((ELEMENT_TYPE)(type - gELEMENT_TYPE_NAMES), (INPUT_DISTRIBUTION)(distribution - gINPUT_DISTRIBUTION_NAMES));
+
+        // Least squares on the logarithms, centered on the mean log size
+        double meanX = 0.0, meanY = 0.0;
+        for (const auto &point : group.points) {
+            meanX += std::log(point.first);
+            meanY += std::log(point.second);
+        }
+        meanX /= group.points.size();
+        meanY /= group.points.size();
+
+        double sxx = 0.0, sxy = 0.0;
+        for (const auto &point : group.points) {
+            sxx += (std::log(point.first) - meanX) * (std::log(point.first) - meanX);
+            sxy += (std::log(point.first) - meanX) * (std::log(point.second) - meanY);
+        }
+
+        if (sxx <= 0.0)
+            continue;
+
+        fit.elements = std::exp(meanX);
+        fit.timeMs = std::exp(meanY);
+        // The sizes measured are few, exponents beyond those of the algorithms are noise
+        fit.exponent = std::max(0.5, std::min(2.5, sxy / sxx));
+
+        mFits.push_back(fit);
+    }
+
+    if (mFits.empty())
+        throw std::runtime_error("The baseline holds no sorted run of a built-in algorithm at two sizes or more to calibrate the cost model");
+}
+
+double Visualizer::CostModel::predict(int sort, ELEMENT_TYPE type, int elements, const INPUT_FEATURES &features) const
+{
+    const ALGORITHM &entry = Registry::instance()[sort];
+    const std::string &algorithm = entry.key;
+
+    // The fits of the cutoff and gap sequence the algorithm runs with now, as the benchmark records them
+    int cutoff = entry.usesNetworkCutoff ? Registry::instance().networkCutoff() : 0;
+    std::string gaps = entry.usesGapSequence ? gGAP_SEQUENCE_NAMES[Registry::instance().gapSequence()] : "none";
+    auto matches = [&](const COST_FIT &fit) { return fit.algorithm == algorithm && fit.cutoff == cutoff && fit.gaps == gaps; };
+
+    // The fits of the element type, those of every type when it wasn't calibrated
+    bool typed = std::any_of(mFits.begin(), mFits.end(), [&](const COST_FIT &fit) { return matches(fit) && fit.type == gELEMENT_TYPE_NAMES[type]; });
+
+    double n = std::max(elements, 2);
+    double weights = 0.0, logTime = 0.0;
+
+    for (const COST_FIT &fit : mFits) {
+        if (!matches(fit) || (typed && fit.type != gELEMENT_TYPE_NAMES[type]))
+            continue;
+
+        double time = fit.timeMs * std::pow(n / fit.elements, fit.exponent);
+
+        // The closer distributions weigh more, one with the same features decides alone
+        double distance = featureDistance(features, fit.features);
+        double weight = 1.0 / (distance * distance + 1e-4);
+        weights += weight;
+        logTime += weight * std::log(time);
+    }
+
+    return weights > 0.0 ? std::exp(logTime / weights) : -1.0;
+}
+
+int Visualizer::CostModel::choose(ELEMENT_TYPE type, int elements, const INPUT_FEATURES &features, double &predictedMs) const
+{
+    int best = -1;
+    predictedMs = -1.0;
+
+    for (int sort = 0; sort < Registry::instance().size(); sort++) {
+        if (Registry::instance()[sort].isPlugin || Registry::instance()[sort].selects)
+            continue;
+
+        double time = predict(sort, type, elements, features);
+        if (time >= 0.0 && (best < 0 || time < predictedMs)) {
+            best = sort;
+            predictedMs = time;
+        }
+    }
+
+    return best;
+}
+
+#define INSTANTIATE_SAMPLE_FEATURES(T) \
+    template Visualizer::INPUT_FEATURES Visualizer::sampleFeatures<T>(const std::vector<T> &, unsigned);
+
+INSTANTIATE_SAMPLE_FEATURES(int32_t)
+INSTANTIATE_SAMPLE_FEATURES(int64_t)
+INSTANTIATE_SAMPLE_FEATURES(uint64_t)
+INSTANTIATE_SAMPLE_FEATURES(float)
+INSTANTIATE_SAMPLE_FEATURES(double)
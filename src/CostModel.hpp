@@ -0,0 +1,99 @@
+//
+//  CostModel.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef CostModel_hpp
+#define CostModel_hpp
+
+#include <vector>
+#include <string>
+
+#include "Utilities.hpp"
+#include "Baseline.hpp"
+
+namespace Visualizer
+{
+    // The elements sampled to measure the features of an array
+    const int gFEATURE_SAMPLES = 1024;
+
+    /*!
+     * @brief What a few samples tell about the order of an array
+     */
+    typedef struct INPUT_FEATURES
+    {
+        double descents = 0.5;   /*! The share of neighbours out of order: 0 in runs, 0.5 shuffled, 1 reversed */
+        double inversions = 0.5; /*! The share of pairs of elements out of order, same scale */
+        double duplicates = 0.0; /*! The share of the sampled elements equal to another one */
+        double range = 0.0;      /*! The largest sampled value minus the smallest (NaNs left out) */
+        double sampleMs = 0.0;   /*! The time the sampling took */
+    } INPUT_FEATURES;
+
+    /*!
+     * @brief Samples the features of an array in time independent of its size
+     * @details Random neighbours give the descents, random pairs the inversions, and one element
+     *          of every stride sorted the duplicates, or the whole array when it isn't larger than
+     *          twice the samples.
+     * @param seed The seed of the positions sampled
+     */
+    template <typename T>
+    INPUT_FEATURES sampleFeatures(const std::vector<T> &array, unsigned seed);
+
+    /*!
+     * @brief Predicts the time of the algorithms on an array from headless results
+     * @details The baseline runs of every algorithm, element type, input distribution, network
+     *          cutoff and gap sequence are fitted with a power of the size, those that ran at a
+     *          single size are left out. Each distribution gets the features of an array arranged
+     *          that way, and an array is predicted to take the geometric mean of the fits of the
+     *          distributions, weighted by how close their features are to its own. Only the fits
+     *          with the cutoff and gap sequence the algorithm would run with now are used. The
+     *          value range doesn't enter the model, the algorithms only compare elements.
+     */
+    class CostModel
+    {
+    public:
+        /*!
+         * @brief Fits the model to the runs of a baseline written by --save-baseline
+         * @throws std::runtime_error if the baseline holds no run of a built-in algorithm at two sizes at least
+         */
+        void calibrate(const BASELINE &baseline);
+
+        bool empty() const { return mFits.empty(); }
+
+        /*!
+         * @brief The predicted milliseconds of an algorithm, -1 if it wasn't calibrated with the
+         *        network cutoff and gap sequence selected in the Registry
+         * @param sort The index of the algorithm in the Registry
+         */
+        double predict(int sort, ELEMENT_TYPE type, int elements, const INPUT_FEATURES &features) const;
+
+        /*!
+         * @brief Picks the built-in algorithm predicted to be the fastest, selections left out
+         * @param predictedMs Receives its predicted time
+         * @return The index of the algorithm in the Registry, -1 if none was calibrated
+         */
+        int choose(ELEMENT_TYPE type, int elements, const INPUT_FEATURES &features, double &predictedMs) const;
+
+    private:
+        /*!
+         * @brief The time of an algorithm on one element type and distribution as a function of the size
+         */
+        typedef struct COST_FIT
+        {
+            std::string algorithm;
+            std::string type;
+            int cutoff = 0;           /*! The sorting network cutoff it ran with */
+            std::string gaps;         /*! The gap sequence it ran with */
+            INPUT_FEATURES features;  /*! The features of the distribution */
+            double elements = 1.0;    /*! The size the fit is centered on */
+            double timeMs = 0.0;      /*! The fitted time at that size */
+            double exponent = 1.0;    /*! The power of the size */
+        } COST_FIT;
+
+        std::vector<COST_FIT> mFits;
+    };
+}
+
+#endif /* CostModel_hpp */
@@ -0,0 +1,223 @@
+//
+//  Elements.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Elements_hpp
+#define Elements_hpp
+
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <algorithm>
+#include <type_traits>
+
+#include "Utilities.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief The array to be sorted, one alternative for each ELEMENT_TYPE (same order as the enum)
+     */
+    typedef std::variant<std::vector<int32_t>,
+                         std::vector<int64_t>,
+                         std::vector<uint64_t>,
+                         std::vector<float>,
+                         std::vector<double>> ElementArray;
+
+    /*!
+     * @brief Strict weak ordering used by every algorithm
+     * @details Integers use the natural order. Floating point values use the IEEE 754 totalOrder,
+     *          so -0.0 sorts before +0.0 and (positive) NaNs sort after +infinity instead of
+     *          breaking the ordering like operator< would.
+     */
+    template <typename T, typename Enable = void>
+    struct TotalLess
+    {
+        bool operator()(const T &a, const T &b) const { return a < b; }
+    };
+
+    template <typename T>
+    struct TotalLess<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+    {
+        typedef typename std::conditional<sizeof(T) == 4, int32_t, int64_t>::type Bits;
+
+        /*!
+         * @brief Maps the bits of a float to a signed integer with the same total order
+         * @param value The value to map
+         */
+        static Bits key(T value)
+        {
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(T));
+            // Negative values have their magnitude bits flipped so they compare in reverse
+            return bits ^ (Bits)((typename std::make_unsigned<Bits>::type)(bits >> (sizeof(T) * 8 - 1)) >> 1);
+        }
+
+        bool operator()(const T &a, const T &b) const { return key(a) < key(b); }
+    };
+
+    /*!
+     * @brief Fills the array with the value ladder used for the given type
+     * @details int32 holds 1..n like the original array, int64 and uint64 spread the values over
+     *          the whole key width, floating point arrays hold values in [-1, 1) plus a -0.0 and
+     *          a NaN so the total ordering is always exercised.
+     * @param array The array to fill
+     * @param n The number of elements
+     */
+    template <typename T>
+    void fillElements(std::vector<T> &array, int n)
+    {
+        array.resize(n);
+
+        for (int i = 0; i < n; i++) {
+            if constexpr (std::is_same<T, int32_t>::value)
+                array[i] = i + 1;
+            else if constexpr (std::is_same<T, int64_t>::value)
+                array[i] = ((int64_t)i - n / 2) * (int64_t)0x100000001LL;
+            else if constexpr (std::is_same<T, uint64_t>::value)
+                array[i] = (uint64_t)(i + 1) * (std::numeric_limits<uint64_t>::max() / (uint64_t)n);
+            else
+                array[i] = (T)(((double)i - n / 2) / (n / 2 > 0 ? n / 2 : 1));
+        }
+
+        if constexpr (std::is_floating_point<T>::value) {
+            if (n > 2) {
+                array[0] = (T)-0.0;
+                array[n - 1] = std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+    }
+
+    /*!
+     * @brief Arranges the elements of an array filled by fillElements in an input distribution
+     * @param array The array to arrange
+     * @param distribution The order to put the elements in
+     * @param seed The seed of the random choices, a shuffle is the same as std::shuffle with it
+     */
+    template <typename T>
+    void arrangeElements(std::vector<T> &array, INPUT_DISTRIBUTION distribution, unsigned seed)
+    {
+        int n = array.size();
+        std::mt19937 generator(seed);
+
+        if (distribution != SHUFFLED_INPUT)
+            std::sort(array.begin(), array.end(), TotalLess<T>());
+
+        switch (distribution) {
+            case SHUFFLED_INPUT:
+                std::shuffle(array.begin(), array.end(), generator);
+                break;
+            case SORTED_INPUT:
+                break;
+            case REVERSED_INPUT:
+                std::reverse(array.begin(), array.end());
+                break;
+            case NEARLY_SORTED_INPUT:
+                for (int swaps = std::max(1, n / 100); swaps > 0 && n > 1; swaps--)
+                    std::swap(array[generator() % n], array[generator() % n]);
+                break;
+            case FEW_UNIQUE_INPUT: {
+                // Every element takes one of 16 values spread over the range, the NaN of floating point arrays included
+                std::vector<T> values(array);
+                for (int i = 0; i < n; i++)
+                    array[i] = values[(long long)(i % 16) * (n - 1) / 15];
+                std::shuffle(array.begin(), array.end(), generator);
+                break;
+            }
+        }
+    }
+
+    /*!
+     * @brief Creates an array of the given type filled by fillElements
+     * @param type The type of the elements
+     * @param n The number of elements
+     */
+    inline ElementArray makeElementArray(ELEMENT_TYPE type, int n)
+    {
+        ElementArray array;
+
+        switch (type) {
+            case INT32_ELEMENTS:
+                array.emplace<INT32_ELEMENTS>();
+                break;
+            case INT64_ELEMENTS:
+                array.emplace<INT64_ELEMENTS>();
+                break;
+            case UINT64_ELEMENTS:
+                array.emplace<UINT64_ELEMENTS>();
+                break;
+            case FLOAT_ELEMENTS:
+                array.emplace<FLOAT_ELEMENTS>();
+                break;
+            case DOUBLE_ELEMENTS:
+                array.emplace<DOUBLE_ELEMENTS>();
+                break;
+        }
+
+        std::visit([n](auto &values) { fillElements(values, n); }, array);
+        return array;
+    }
+
+    /*!
+     * @brief Whether the value is a NaN (always false for integers)
+     */
+    template <typename T>
+    bool isNaN(T value)
+    {
+        if constexpr (std::is_floating_point<T>::value)
+            return std::isnan(value);
+        else
+            return false;
+    }
+
+    /*!
+     * @brief Finds the range of the non NaN values of the array
+     * @param array The array to scan
+     * @param min Set to the smallest value
+     * @param max Set to the largest value
+     */
+    template <typename T>
+    void valueRange(const std::vector<T> &array, double &min, double &max)
+    {
+        min = std::numeric_limits<double>::max();
+        max = std::numeric_limits<double>::lowest();
+
+        for (const T &value : array) {
+            if (isNaN(value))
+                continue;
+            min = std::min(min, (double)value);
+            max = std::max(max, (double)value);
+        }
+
+        if (min > max)
+            min = max = 0.0;
+    }
+
+    /*!
+     * @brief Maps a value to the height fraction of its bar
+     * @details The smallest value gets 1/n of the height and the largest the whole height, which
+     *          matches the original 1..n bars. NaNs are drawn full height.
+     * @param value The value to normalize
+     * @param min The smallest value of the array
+     * @param max The largest value of the array
+     * @param n The number of elements
+     */
+    template <typename T>
+    double normalizeElement(T value, double min, double max, int n)
+    {
+        if (isNaN(value) || max <= min)
+            return 1.0;
+
+        double base = 1.0 / n;
+        return base + (1.0 - base) * (((double)value - min) / (max - min));
+    }
+}
+
+#endif /* Elements_hpp */
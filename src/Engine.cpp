@@ -7,58 +7,83 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <climits>
 #include <ctime>
 #include <stdexcept>
 #include <numeric>
 #include <cmath>
 #include <sstream>
+#include <iomanip>
+#include <algorithm>
 
 #include "Engine.hpp"
 
 Visualizer::Engine::Engine(const COUPLE size)
-    : mWindowSize(size), mUsableWidth(size.x - (size.x / 4)), mNumbersArray(gMAX_ELEMENTS[mCurrentElementsNumber])
+    : mWindowSize(size), mUsableWidth(size.x - (size.x / 4))
 {
 
     // Initialize the engine
     if (!init())
         throw std::runtime_error("Failed to initialize!");
 
-    // Fill the array with numbers from 1 to gMAX_ELEMENTS[mCurrentElementsNumber]
-    std::iota(mNumbersArray.begin(), mNumbersArray.end(), 1);
+    // Fill the array with gMAX_ELEMENTS[mCurrentElementsNumber] values of the current element type
+    fillArray();
 
-    // Fill the array with numbers from 1 to gMAX_ELEMENTS[mCurrentElementsNumber]
-    // fill_array();
     // Shuffle the array
     shuffle();
 }
 
 Visualizer::Engine::Engine(const COUPLE size, const char *window_title)
-    : mWindowSize(size), mWindowTitle(window_title), mUsableWidth(size.x - (size.x / 4)), mNumbersArray(gMAX_ELEMENTS[mCurrentElementsNumber])
+    : mWindowSize(size), mWindowTitle(window_title), mUsableWidth(size.x - (size.x / 4))
 {
 
     // Initialize the engine
     if (!init())
         throw std::runtime_error("Failed to initialize!");
 
-    // Fill the array with numbers from 1 to gMAX_ELEMENTS[mCurrentElementsNumber]
-    std::iota(mNumbersArray.begin(), mNumbersArray.end(), 1);
+    // Fill the array with gMAX_ELEMENTS[mCurrentElementsNumber] values of the current element type
+    fillArray();
 
-    // Fill the array with numbers from 1 to gMAX_ELEMENTS[mCurrentElementsNumber]
-    // fill_array();
     // Shuffle the array
     shuffle();
 }
 
 Visualizer::Engine::~Engine()
 {
+    // Stop the external sort, the sample sort and the scaling report before anything they report to goes away
+    stopExternalSort();
+    stopSampleSort();
+    stopScaling();
+
+    // Close the audio device before SDL quits
+    mSonifier.close();
+
     // Deallocate memory destroying the elements used by the textures
     mSortNameTexture->free();
     mInfoPanelTexture->free();
+    mKeysTexture->free();
     mSpeedTexture->free();
     mSwapsTexture->free();
     mComparisonsTexture->free();
     mTimeTexture->free();
     mElementNumberTexture->free();
+    mElementTypeTexture->free();
+    mCutoffTexture->free();
+    mGapsTexture->free();
+    mSelectionTexture->free();
+    mVerifyTexture->free();
+    mIngestTexture->free();
+    mPlaybackTexture->free();
+    mArgsortTexture->free();
+    mInputTexture->free();
+    mAutoTexture->free();
+    mIngestStatsTexture->free();
+    mCacheTexture->free();
+    mExternalTexture->free();
+    mSampleTexture->free();
+    mMemoryTexture->free();
+    mScalingTexture->free();
+    mPlotLabelTexture->free();
 
     // Close the fonts
     TTF_CloseFont(mRobotoSmall);
@@ -84,12 +109,24 @@ void Visualizer::Engine::run()
 {
     // Main loop flag
     while (mIsRunning) {
+        TRACE_SPAN("frame");
+
         // Handle events on queue
         handleEvents();
 
-        // If the user requested a sort, sort the array
-        if (mRequestSort)
-            sort();
+        // If the user requested a sort, run the next steps of the sort
+        if (mFeed || mAttached)
+            receiveFeed();
+        else if (mRequestSort && mIsExternalMode)
+            stepExternalSort();
+        else if (mRequestSort && mIsScalingMode)
+            stepScaling();
+        else if (mRequestSort && mIsIngestMode)
+            stepIngest();
+        else if (mRequestSort && mIsSampleMode)
+            stepSampleSort();
+        else if (mRequestSort)
+            stepSort();
 
         // If the user requested a shuffle, shuffle the array
         if (mRequestShuffle)
@@ -162,11 +199,15 @@ bool Visualizer::Engine::init()
 
     // Sort name texture
     mSortNameTexture = new LTexture(mRenderer, mRobotoLarge);
-    mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+    mSortNameTexture->loadFromRenderedText(Registry::instance()[mCurrentSort].name, gFontColor);
 
     // Info panel texture
     mInfoPanelTexture = new LTexture(mRenderer, mRobotoSmall);
-    mInfoPanelTexture->loadFromRenderedText(gINFO_TEXT, gFontColor, true, 0, {0, 20, 0, 0});    // 20px padding on the right
+    mInfoPanelTexture->loadFromRenderedText(Registry::instance().infoText() + gINFO_TEXT, gFontColor, true, 0, {0, 20, 0, 0});    // 20px padding on the right
+
+    // Keys texture
+    mKeysTexture = new LTexture(mRenderer, mRobotoSmall);
+    mKeysTexture->loadFromRenderedText(" F1 - keys", gFontColor, false, mInfoPanelTexture->getWidth());
 
     // Speed texture
     mSpeedTexture = new LTexture(mRenderer, mRobotoSmall);
@@ -189,6 +230,71 @@ bool Visualizer::Engine::init()
     element_number_text << " Elements: " << gMAX_ELEMENTS[mCurrentElementsNumber] << " J/K";
     mElementNumberTexture->loadFromRenderedText(element_number_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
 
+    // Element type texture
+    mElementTypeTexture = new LTexture(mRenderer, mRobotoSmall);
+    std::stringstream element_type_text;
+    element_type_text << " Type: " << gELEMENT_TYPE_NAMES[mCurrentElementType] << " T";
+    mElementTypeTexture->loadFromRenderedText(element_type_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Sorting network cutoff texture
+    mCutoffTexture = new LTexture(mRenderer, mRobotoSmall);
+    std::stringstream cutoff_text;
+    cutoff_text << " Cutoff: " << Registry::instance().networkCutoff() << " R";
+    mCutoffTexture->loadFromRenderedText(cutoff_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Shell sort gap sequence texture
+    mGapsTexture = new LTexture(mRenderer, mRobotoSmall);
+    std::stringstream gaps_text;
+    gaps_text << " Gaps: " << gGAP_SEQUENCE_NAMES[Registry::instance().gapSequence()] << " F";
+    mGapsTexture->loadFromRenderedText(gaps_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Selection k texture
+    mSelectionTexture = new LTexture(mRenderer, mRobotoSmall);
+    mSelectionTexture->loadFromRenderedText(selectionText(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Verification texture
+    mVerifyTexture = new LTexture(mRenderer, mRobotoSmall);
+
+    // Ingest strategy texture
+    mIngestTexture = new LTexture(mRenderer, mRobotoSmall);
+    std::stringstream ingest_text;
+    ingest_text << " Ingest: " << gINGEST_STRATEGY_NAMES[mIngestStrategy] << " 6";
+    mIngestTexture->loadFromRenderedText(ingest_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Ingest statistics texture
+    mIngestStatsTexture = new LTexture(mRenderer, mRobotoSmall);
+
+    // Playback duration texture
+    mPlaybackTexture = new LTexture(mRenderer, mRobotoSmall);
+    mPlaybackTexture->loadFromRenderedText(" Playback: speed 9", gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Argsort mode texture
+    mArgsortTexture = new LTexture(mRenderer, mRobotoSmall);
+    mArgsortTexture->loadFromRenderedText(" Argsort: direct 0", gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Input distribution texture
+    mInputTexture = new LTexture(mRenderer, mRobotoSmall);
+    mInputTexture->loadFromRenderedText(" Input: shuffled L/R", gFontColor, false, mInfoPanelTexture->getWidth());
+
+    // Auto mode texture
+    mAutoTexture = new LTexture(mRenderer, mRobotoSmall);
+
+    // Cache statistics texture
+    mCacheTexture = new LTexture(mRenderer, mRobotoSmall);
+
+    // External sort statistics texture
+    mExternalTexture = new LTexture(mRenderer, mRobotoSmall);
+
+    // Sample sort nodes texture
+    mSampleTexture = new LTexture(mRenderer, mRobotoSmall);
+
+    // Memory statistics texture
+    mMemoryTexture = new LTexture(mRenderer, mRobotoSmall);
+
+    // Scaling report textures
+    mScalingTexture = new LTexture(mRenderer, mRobotoSmall);
+    mPlotLabelTexture = new LTexture(mRenderer, mRobotoSmall);
+
     // Set background color
     SDL_SetRenderDrawColor(mRenderer, gBackgroundColor.r, gBackgroundColor.g, gBackgroundColor.b, gBackgroundColor.a);
     return true;
@@ -196,6 +302,8 @@ bool Visualizer::Engine::init()
 
 void Visualizer::Engine::handleEvents()
 {
+    TRACE_SPAN("handleEvents");
+
     SDL_Event e;
 
     // Handle events on queue
@@ -220,10 +328,13 @@ void Visualizer::Engine::handleEvents()
 
                 // Resize the texture
                 mSortNameTexture->setFontSize(fontSizeLarge);
-                mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                mSortNameTexture->loadFromRenderedText(Registry::instance()[mCurrentSort].name, gFontColor);
 
                 mInfoPanelTexture->setFontSize(fontSizeSmall);
-                mInfoPanelTexture->loadFromRenderedText(gINFO_TEXT, gFontColor, true, 0, {0, 20, 0, 0});
+                mInfoPanelTexture->loadFromRenderedText(Registry::instance().infoText() + gINFO_TEXT, gFontColor, true, 0, {0, 20, 0, 0});
+
+                mKeysTexture->setFontSize(fontSizeSmall);
+                mKeysTexture->loadFromRenderedText(" F1 - keys", gFontColor, false, mInfoPanelTexture->getWidth());
 
                 mSpeedTexture->setFontSize(fontSizeSmall);
                 std::stringstream speed_text;
@@ -235,6 +346,55 @@ void Visualizer::Engine::handleEvents()
                 elements_text << " Elements: " << gMAX_ELEMENTS[mCurrentElementsNumber] << "J/K";
                 mElementNumberTexture->loadFromRenderedText(elements_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
 
+                mElementTypeTexture->setFontSize(fontSizeSmall);
+                std::stringstream type_text;
+                type_text << " Type: " << gELEMENT_TYPE_NAMES[mCurrentElementType] << " T";
+                mElementTypeTexture->loadFromRenderedText(type_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mCutoffTexture->setFontSize(fontSizeSmall);
+                std::stringstream cutoff_text;
+                cutoff_text << " Cutoff: " << Registry::instance().networkCutoff() << " R";
+                mCutoffTexture->loadFromRenderedText(cutoff_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mGapsTexture->setFontSize(fontSizeSmall);
+                std::stringstream gaps_text;
+                gaps_text << " Gaps: " << gGAP_SEQUENCE_NAMES[Registry::instance().gapSequence()] << " F";
+                mGapsTexture->loadFromRenderedText(gaps_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mSelectionTexture->setFontSize(fontSizeSmall);
+                mSelectionTexture->loadFromRenderedText(selectionText(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mIngestTexture->setFontSize(fontSizeSmall);
+                std::stringstream ingest_text;
+                ingest_text << " Ingest: " << gINGEST_STRATEGY_NAMES[mIngestStrategy] << " 6";
+                mIngestTexture->loadFromRenderedText(ingest_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mPlaybackTexture->setFontSize(fontSizeSmall);
+                std::stringstream playback_text;
+                playback_text << " Playback: ";
+                if (mPlaybackSeconds > 0)
+                    playback_text << mPlaybackSeconds << "s 9";
+                else
+                    playback_text << "speed 9";
+                mPlaybackTexture->loadFromRenderedText(playback_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mArgsortTexture->setFontSize(fontSizeSmall);
+                mArgsortTexture->loadFromRenderedText(" Argsort: " + gARGSORT_MODE_NAMES[mArgsortMode] + " 0", gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mInputTexture->setFontSize(fontSizeSmall);
+                mInputTexture->loadFromRenderedText(" Input: " + gINPUT_DISTRIBUTION_NAMES[mInputDistribution] + " L/R", gFontColor, false, mInfoPanelTexture->getWidth());
+
+                mAutoTexture->setFontSize(fontSizeSmall);
+
+                mIngestStatsTexture->setFontSize(fontSizeSmall);
+                mVerifyTexture->setFontSize(fontSizeSmall);
+                mCacheTexture->setFontSize(fontSizeSmall);
+                mExternalTexture->setFontSize(fontSizeSmall);
+                mSampleTexture->setFontSize(fontSizeSmall);
+                mMemoryTexture->setFontSize(fontSizeSmall);
+                mScalingTexture->setFontSize(fontSizeSmall);
+                mPlotLabelTexture->setFontSize(fontSizeSmall);
+
                 mSwapsTexture->setFontSize(fontSizeSmall);
                 std::stringstream swap_text;
                 swap_text << " Swaps: " << mSwapsCount;
@@ -258,96 +418,141 @@ void Visualizer::Engine::handleEvents()
                 case SDLK_ESCAPE:
                     mIsRunning = false;
                     break;
-                // User presses the B key
-                case SDLK_b:
-                    // If the array is not sorted and if the current sort is not already bubble sort
-                    if (!mRequestSort && mCurrentSort != BUBBLE_SORT) {
-                        // Set the current sort to bubble sort
-                        mCurrentSort = BUBBLE_SORT;
-                        // Load the text for bubble sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the X key
+                case SDLK_x:
+                    // Turns the cache simulation on and off
+                    if (!mRequestSort) {
+                        mIsCacheMode = !mIsCacheMode;
+                        resetCache();
+                    }
+                    break;
+                // User presses the A key
+                case SDLK_a:
+                    // Turns the sound on and off
+                    if (mSonifier.isOpen())
+                        mSonifier.close();
+                    else
+                        mSonifier.open();
+                    break;
+                // User presses the D key
+                case SDLK_d:
+                    // Switches between sorting the array and the external sort of a file
+                    if (!mRequestSort) {
+                        mIsExternalMode = !mIsExternalMode;
+                        mIsScalingMode = false;
+                        mIsIngestMode = false;
+                        mIsSampleMode = false;
+                        mRequestShuffle = true;
+                    }
+                    break;
+                // User presses the O key
+                case SDLK_o:
+                    // Switches between sorting the array and the scaling plot of every algorithm
+                    if (!mRequestSort) {
+                        mIsScalingMode = !mIsScalingMode;
+                        mIsExternalMode = false;
+                        mIsIngestMode = false;
+                        mIsSampleMode = false;
+                        mRequestShuffle = true;
                     }
                     break;
-                // User presses the Q key
-                case SDLK_q:
-                    // If the array is not sorted and if the current sort is not already quick sort
-                    if (!mRequestSort && mCurrentSort != QUICK_SORT) {
-                        // Set the current sort to quick sort
-                        mCurrentSort = QUICK_SORT;
-                        // Load the text for quick sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the 5 key
+                case SDLK_5:
+                    // Switches between sorting the array and streaming it into the ingest structure
+                    if (!mRequestSort) {
+                        mIsIngestMode = !mIsIngestMode;
+                        mIsExternalMode = false;
+                        mIsScalingMode = false;
+                        mIsSampleMode = false;
+                        mRequestShuffle = true;
                     }
                     break;
-                // User presses the C key
-                case SDLK_c:
-                    // If the array is not sorted and if the current sort is not already cocktail sort
-                    if (!mRequestSort && mCurrentSort != COCKTAIL_SORT) {
-                        // Set the current sort to cocktail sort
-                        mCurrentSort = COCKTAIL_SORT;
-                        // Load the text for cocktail sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the 7 key
+                case SDLK_7:
+                    // Switches between sorting the array and the sample sort of worker processes
+                    if (!mRequestSort) {
+                        mIsSampleMode = !mIsSampleMode;
+                        mIsExternalMode = false;
+                        mIsScalingMode = false;
+                        mIsIngestMode = false;
+                        mRequestShuffle = true;
                     }
                     break;
-                // User presses the E key
-                case SDLK_e:
-                    // If the array is not sorted and if the current sort is not already shell sort
-                    if (!mRequestSort && mCurrentSort != SHELL_SORT) {
-                        // Set the current sort to shell sort
-                        mCurrentSort = SHELL_SORT;
-                        // Load the text for shell sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the 6 key
+                case SDLK_6:
+                    if (!mRequestSort) {
+                        // Cycles through the structures keeping the streamed elements sorted
+                        mIngestStrategy = (INGEST_STRATEGY)((mIngestStrategy + 1) % gINGEST_STRATEGIES_COUNT);
+                        std::stringstream is;
+                        is << " Ingest: " << gINGEST_STRATEGY_NAMES[mIngestStrategy] << " 6";
+                        mIngestTexture->loadFromRenderedText(is.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+                        if (mIsIngestMode)
+                            mRequestShuffle = true;
                     }
                     break;
-                // User presses the H key
-                case SDLK_h:
-                    // If the array is not sorted and if the current sort is not already heap sort
-                    if (!mRequestSort && mCurrentSort != HEAP_SORT) {
-                        // Set the current sort to heap sort
-                        mCurrentSort = HEAP_SORT;
-                        // Load the text for heap sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the 9 key
+                case SDLK_9:
+                    if (!mRequestSort) {
+                        // Cycles through the durations the sort is played back in, whatever its length
+                        int playback = std::find(gPLAYBACK_SECONDS, gPLAYBACK_SECONDS + gPLAYBACK_SECONDS_COUNT, mPlaybackSeconds) - gPLAYBACK_SECONDS;
+                        mPlaybackSeconds = gPLAYBACK_SECONDS[(playback + 1) % gPLAYBACK_SECONDS_COUNT];
+                        std::stringstream pb;
+                        pb << " Playback: ";
+                        if (mPlaybackSeconds > 0)
+                            pb << mPlaybackSeconds << "s 9";
+                        else
+                            pb << "speed 9";
+                        mPlaybackTexture->loadFromRenderedText(pb.str(), gFontColor, false, mInfoPanelTexture->getWidth());
                     }
                     break;
-                // User presses the M key
-                case SDLK_m:
-                    // If the array is not sorted and if the current sort is not already merge sort
-                    if (!mRequestSort && mCurrentSort != MERGE_SORT) {
-                        // Set the current sort to merge sort
-                        mCurrentSort = MERGE_SORT;
-                        // Load the text for merge sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the 0 key
+                case SDLK_0:
+                    if (!mRequestSort) {
+                        // Cycles through sorting the elements, their indices and their indices with cached keys
+                        mArgsortMode = (ARGSORT_MODE)((mArgsortMode + 1) % gARGSORT_MODES_COUNT);
+                        mArgsortTexture->loadFromRenderedText(" Argsort: " + gARGSORT_MODE_NAMES[mArgsortMode] + " 0", gFontColor, false, mInfoPanelTexture->getWidth());
                     }
                     break;
-                // User presses the L key
-                case SDLK_l:
-                    // If the array is not sorted and if the current sort is not already selection sort
-                    if (!mRequestSort && mCurrentSort != SELECTION_SORT) {
-                        // Set the current sort to selection sort
-                        mCurrentSort = SELECTION_SORT;
-                        // Load the text for selection sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the R key
+                case SDLK_r:
+                    if (!mRequestSort) {
+                        // Cycles through the partition sizes sorted by a network
+                        int cutoff = std::find(gNETWORK_CUTOFFS, gNETWORK_CUTOFFS + gNETWORK_CUTOFFS_COUNT, Registry::instance().networkCutoff()) - gNETWORK_CUTOFFS;
+                        Registry::instance().setNetworkCutoff(gNETWORK_CUTOFFS[(cutoff + 1) % gNETWORK_CUTOFFS_COUNT]);
+                        std::stringstream co;
+                        co << " Cutoff: " << Registry::instance().networkCutoff() << " R";
+                        mCutoffTexture->loadFromRenderedText(co.str(), gFontColor, false, mInfoPanelTexture->getWidth());
                     }
                     break;
-                // User presses the I key
-                case SDLK_i:
-                    // If the array is not sorted and if the current sort is not already insertion sort
-                    if (!mRequestSort && mCurrentSort != INSERTION_SORT) {
-                        // Set the current sort to insertion sort
-                        mCurrentSort = INSERTION_SORT;
-                        // Load the text for insertion sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the F key
+                case SDLK_f:
+                    if (!mRequestSort) {
+                        // Cycles through the gap sequences of shell sort
+                        Registry::instance().setGapSequence((GAP_SEQUENCE)((Registry::instance().gapSequence() + 1) % gGAP_SEQUENCES_COUNT));
+                        std::stringstream gs;
+                        gs << " Gaps: " << gGAP_SEQUENCE_NAMES[Registry::instance().gapSequence()] << " F";
+                        mGapsTexture->loadFromRenderedText(gs.str(), gFontColor, false, mInfoPanelTexture->getWidth());
                     }
                     break;
-                // User presses the G key
-                case SDLK_g:
-                    // If the array is not sorted and if the current sort is not already gnome sort
-                    if (!mRequestSort && mCurrentSort != GNOME_SORT) {
-                        // Set the current sort to gnome sort
-                        mCurrentSort = GNOME_SORT;
-                        // Load the text for gnome sort
-                        mSortNameTexture->loadFromRenderedText(gSORT_NAMES[mCurrentSort], gFontColor);
+                // User presses the Z key
+                case SDLK_z:
+                    if (!mRequestSort) {
+                        // Cycles through the number of smallest elements the selection algorithms put first
+                        int k = std::find(gSELECTION_KS, gSELECTION_KS + gSELECTION_KS_COUNT, Registry::instance().selectionK()) - gSELECTION_KS;
+                        Registry::instance().setSelectionK(gSELECTION_KS[(k + 1) % gSELECTION_KS_COUNT]);
+                        mSelectionTexture->loadFromRenderedText(selectionText(), gFontColor, false, mInfoPanelTexture->getWidth());
                     }
                     break;
+                // User presses the F1 key
+                case SDLK_F1:
+                    // Switches between listing the keys and the statistics
+                    mIsHelpShown = !mIsHelpShown;
+                    break;
+                // User presses the TAB key
+                case SDLK_TAB:
+                    // Selects the next algorithm, plugins included
+                    selectSort((mCurrentSort + 1) % Registry::instance().size());
+                    break;
                 // User presses the SPACEBAR key
                 case SDLK_SPACE:
                     // If the array is not sorted
@@ -355,19 +560,50 @@ void Visualizer::Engine::handleEvents()
                         // Stops and starts the sort
                         mRequestSort = true;
                     }
-                    else if (mRequestSort) {
+                    else if (mRequestSort && !mIsExternalMode && !mIsScalingMode && !mIsSampleMode) {
                         // Fast forwards the sort
                         mIsFastForward = true;
                     }
                     break;
+                // User presses the P key
+                case SDLK_p:
+                    // Pauses and resumes the running sort
+                    if (mRequestSort && !mIsFastForward && !mIsExternalMode && !mIsScalingMode && !mIsSampleMode) {
+                        mIsPaused = !mIsPaused;
+                    }
+                    break;
+                // User presses the N key
+                case SDLK_n:
+                    // Runs a single step of the paused sort
+                    if (mIsPaused) {
+                        mRequestStep = true;
+                    }
+                    break;
                 // User presses the S key
                 case SDLK_s:
                     // If the array is sorted
-                    if (mIsSorted) {
+                    if (mIsSorted && !mFeed && !mAttached) {
                         // Shuffles the array
                         mRequestShuffle = true;
                     }
                     break;
+                // User presses the left or right arrow key
+                case SDLK_LEFT:
+                case SDLK_RIGHT:
+                    if (!mRequestSort && !mFeed && !mAttached) {
+                        // Cycles through the orders the shuffle leaves the elements in
+                        int step = e.key.keysym.sym == SDLK_RIGHT ? 1 : gINPUT_DISTRIBUTIONS_COUNT - 1;
+                        mInputDistribution = (INPUT_DISTRIBUTION)((mInputDistribution + step) % gINPUT_DISTRIBUTIONS_COUNT);
+                        mInputTexture->loadFromRenderedText(" Input: " + gINPUT_DISTRIBUTION_NAMES[mInputDistribution] + " L/R", gFontColor, false, mInfoPanelTexture->getWidth());
+                        mRequestShuffle = true;
+                    }
+                    break;
+                // User presses the ENTER key
+                case SDLK_RETURN:
+                    // Switches between sorting with the selected algorithm and the one predicted to be the fastest
+                    if (!mRequestSort)
+                        mIsAutoMode = !mIsAutoMode;
+                    break;
                 // User presses the down arrow key
                 case SDLK_DOWN:
                     if (mCurrentDrawSpeed > 0) {
@@ -404,8 +640,8 @@ void Visualizer::Engine::handleEvents()
                         std::stringstream en;
                         en << " Elements: " << gMAX_ELEMENTS[mCurrentElementsNumber] << " J/K";
                         mElementNumberTexture->loadFromRenderedText(en.str(), gFontColor, false, mInfoPanelTexture->getWidth());
-                        mNumbersArray.resize(gMAX_ELEMENTS[mCurrentElementsNumber]);
-                        std::iota(mNumbersArray.begin(), mNumbersArray.end(), 1);
+                        mSelectionTexture->loadFromRenderedText(selectionText(), gFontColor, false, mInfoPanelTexture->getWidth());
+                        fillArray();
                         shuffle();
                     }
                     break;
@@ -417,421 +653,660 @@ void Visualizer::Engine::handleEvents()
                         std::stringstream en;
                         en << " Elements: " << gMAX_ELEMENTS[mCurrentElementsNumber] << " J/K";
                         mElementNumberTexture->loadFromRenderedText(en.str(), gFontColor, false, mInfoPanelTexture->getWidth());
-                        mNumbersArray.resize(gMAX_ELEMENTS[mCurrentElementsNumber]);
-                        std::iota(mNumbersArray.begin(), mNumbersArray.end(), 1);
+                        mSelectionTexture->loadFromRenderedText(selectionText(), gFontColor, false, mInfoPanelTexture->getWidth());
+                        fillArray();
+                        shuffle();
+                    }
+                    break;
+                // User presses the T key
+                case SDLK_t:
+                    if (!mRequestSort) {
+                        // Cycles through the element types
+                        mCurrentElementType = (ELEMENT_TYPE)((mCurrentElementType + 1) % gELEMENT_TYPES_COUNT);
+                        std::stringstream et;
+                        et << " Type: " << gELEMENT_TYPE_NAMES[mCurrentElementType] << " T";
+                        mElementTypeTexture->loadFromRenderedText(et.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+                        fillArray();
                         shuffle();
                     }
                     break;
+                default:
+                    // Selects the algorithm bound to the key, if any
+                    int sort = Registry::instance().findHotkey(e.key.keysym.sym);
+                    if (sort >= 0)
+                        selectSort(sort);
+                    break;
             }
         }
     }
 }
 
-void Visualizer::Engine::sort()
+void Visualizer::Engine::selectSort(int sort)
 {
-    // Start the timer
-    mStart = std::chrono::high_resolution_clock::now();
-    // Sorts the array based on the current sort selected
-    switch (mCurrentSort) {
-        case BUBBLE_SORT:
-            bubbleSort();
-            break;
-        case QUICK_SORT:
-            quickSort(0, gMAX_ELEMENTS[mCurrentElementsNumber] - 1);
-            break;
-        case COCKTAIL_SORT:
-            cocktailSort();
-            break;
-        case SHELL_SORT:
-            shellSort();
-            break;
-        case HEAP_SORT:
-            heapSort();
-            break;
-        case MERGE_SORT:
-            mergeSort(0, gMAX_ELEMENTS[mCurrentElementsNumber] - 1);
-            break;
-        case SELECTION_SORT:
-            selectionSort();
-            break;
-        case INSERTION_SORT:
-            insertionSort();
-            break;
-        case GNOME_SORT:
-            gnomeSort();
-            break;
+    // If the array is not sorted and if the current sort is not already the selected one
+    if (!mRequestSort && mCurrentSort != sort) {
+        // Set the current sort
+        mCurrentSort = sort;
+        // Load the text for the sort
+        mSortNameTexture->loadFromRenderedText(Registry::instance()[mCurrentSort].name, gFontColor);
     }
+}
 
-    // Stop the timer
+void Visualizer::Engine::countPlayback()
+{
+    TRACE_SPAN("countPlayback");
+
+    ElementArray copy = mNumbersArray;
+    IndexArray indices = mIndices;
+    SortGenerator counting = mArgsortMode == DIRECT_SORT ? Registry::instance()[mCurrentSort].factory(copy)
+                                                         : Registry::instance()[mCurrentSort].factory(indices, mArgsortKeys);
+
+    // The reads don't take a step of the sort when drawn, so they aren't played back either
+    mPlaybackOps = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (counting.next())
+        if (counting.value().type != READ_OP)
+            mPlaybackOps++;
     auto end = std::chrono::high_resolution_clock::now();
-    mElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - mStart).count();
-    // The array is sorted
-    mIsSorted = true;
-    // The request is stopped
-    mRequestSort = false;
-    // Reset the swap element
-    mSwapElement = -1;
-    // Reset the compare elements
-    mCompareElement = -1;
+    counting.reset();
+
+    mTrueSortMs = Registry::instance().sortTimeMs(mCurrentSort, start, end);
 }
 
-void Visualizer::Engine::cocktailSort()
+void Visualizer::Engine::chooseSort()
 {
-    bool swapped = true;
-    int start = 0;
-    int end = gMAX_ELEMENTS[mCurrentElementsNumber] - 1;
+    TRACE_SPAN("chooseSort");
 
-    while (swapped) {
-        swapped = false;
+    std::visit([this](const auto &array) { mFeatures = sampleFeatures(array, (unsigned)time(NULL)); }, mNumbersArray);
 
-        for (int i = start; i < end; ++i) {
-            mComparisonsCount++;
-            if (mNumbersArray[i] > mNumbersArray[i + 1]) {
-                std::swap(mNumbersArray[i], mNumbersArray[i + 1]);
-                mSwapsCount++;
-                mSwapElement = i + 1;
-                swapped = true;
-                if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-                    handleEvents();
-                    if (!mIsRunning) return;
-                    draw();
-                }
-            }
-        }
-        if (!swapped)
-            break;
+    int sort = mCostModel.choose(mCurrentElementType, gMAX_ELEMENTS[mCurrentElementsNumber], mFeatures, mPredictedMs);
+    if (sort < 0)
+        return;
 
-        swapped = false;
-        end--;
-
-        for (int i = end - 1; i >= start; --i) {
-            mComparisonsCount++;
-            if (mNumbersArray[i] > mNumbersArray[i + 1]) {
-                std::swap(mNumbersArray[i], mNumbersArray[i + 1]);
-                mSwapsCount++;
-                mSwapElement = i;
-                swapped = true;
-                if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-                    handleEvents();
-                    if (!mIsRunning) return;
-                    draw();
-                }
-            }
-        }
+    mCurrentSort = sort;
+    mSortNameTexture->loadFromRenderedText(Registry::instance()[mCurrentSort].name, gFontColor);
+    mHasDecision = true;
+}
 
-        start++;
-    }
+void Visualizer::Engine::loadCostModel(const std::string &path)
+{
+    mCostModel.calibrate(readBaseline(path));
 }
 
-void Visualizer::Engine::quickSort(int low, int high)
+void Visualizer::Engine::startSort()
 {
-    if (low < high) {
-        int pi = partition(low, high);
+    // An argsort moves indices into a copy of the elements, the array only shows the keys they point to
+    if (mArgsortMode != DIRECT_SORT) {
+        mArgsortKeys = mNumbersArray;
+        mIndices = makeIndexArray(mArgsortMode, mArgsortKeys);
+    }
 
-        // If the sort is stopped or the application is closed while inside of partition, stop the sort
-        if (!mIsRunning) return;
+    // The auto mode picks the algorithm before anything runs
+    mHasDecision = false;
+    if (mIsAutoMode && !mCostModel.empty())
+        chooseSort();
+
+    // The operations to play back are counted first, the memory of that run is forgotten;
+    // that run also times the decision of the auto mode
+    mIsPlayback = mPlaybackSeconds > 0;
+    if (mIsPlayback || mHasDecision)
+        countPlayback();
+    mPlayedOps = 0;
+    mPlaybackMs = 0.0;
+
+    // Creates the generator of the current sort, it only runs when stepped
+    mMemory.reset();
+
+    // A selection only settles part of the array, the sorted copy tells which positions are final
+    mFinalArray = mNumbersArray;
+    std::visit([this](auto &array) {
+        typedef typename std::decay<decltype(array)>::type::value_type T;
+        if (Registry::instance()[mCurrentSort].selects)
+            std::sort(array.begin(), array.end(), TotalLess<T>());
+        else
+            array.clear();
+    }, mFinalArray);
+
+    if (mArgsortMode == DIRECT_SORT)
+        mSortStepper = Registry::instance()[mCurrentSort].factory(mNumbersArray);
+    else
+        mSortStepper = Registry::instance()[mCurrentSort].factory(mIndices, mArgsortKeys);
+
+    // The result is checked against the elements the sort starts with
+    std::visit([this](const auto &array) { mInputChecksum = multisetChecksum(array); }, mNumbersArray);
+
+    // The caches start cold for every sort
+    resetCache();
 
-        quickSort(low, pi - 1);
-        quickSort(pi + 1, high);
-    }
+    // Start the timer
+    mStart = std::chrono::high_resolution_clock::now();
+    mLastStep = mStart;
 }
 
-int Visualizer::Engine::partition(int low, int high)
+void Visualizer::Engine::stepSort()
 {
-    int pivot = mNumbersArray[high];
-    int i = (low - 1);
+    TRACE_SPAN("stepSort");
 
-    for (int j = low; j <= high - 1; j++) {
-        if (mNumbersArray[j] < pivot) {
-            i++;
-            std::swap(mNumbersArray[i], mNumbersArray[j]);
-            mSwapsCount++;
-            if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-                handleEvents();
-                if (!mIsRunning) return -1;
-                mSwapElement = j;
-                draw();
-            }
-        }
+    // The allocations of the sort are counted while it runs, and its frames when they are freed
+    MemoryTracker::Scope scope(mMemory);
+
+    if (!mSortStepper)
+        startSort();
+
+    auto now = std::chrono::high_resolution_clock::now();
+    double frameMs = std::chrono::duration<double, std::milli>(now - mLastStep).count();
+    mLastStep = now;
+
+    // While paused only the steps requested with N are run
+    if (mIsPaused && !mRequestStep)
+        return;
+
+    long long steps = mIsPaused ? 1 : gSPEEDS[mCurrentDrawSpeed];
+    mRequestStep = false;
+
+    // A playback runs the operations due at a uniform rate by now, all that are left once the time is up
+    if (mIsPlayback && !mIsPaused) {
+        mPlaybackMs += frameMs;
+        double share = mPlaybackMs / (mPlaybackSeconds * 1000.0);
+        steps = share >= 1.0 ? LLONG_MAX : (long long)std::ceil(mPlaybackOps * share) - mPlayedOps;
     }
-    std::swap(mNumbersArray[i + 1], mNumbersArray[high]);
-    mSwapsCount++;
-    // If fast forward is enabled, draw the array on the screen immediately
-    if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] && !mIsFastForward) {
-        handleEvents();
-        if (!mIsRunning) return -1;
-        mSwapElement = high;
-        draw();
+    mSonifier.beginFrame();
+
+    // Fast forward runs the sort to the end within this frame
+    while (mIsFastForward || steps-- > 0) {
+        if (!mSortStepper.next()) {
+            verifyArray();
+            finishSort();
+            return;
+        }
+        if (mArgsortMode != DIRECT_SORT)
+            gather(mSortStepper.value());
+        apply(mSortStepper.value());
+
+        // Reads into temporaries are only visible to the cache simulation, they don't use up the frame
+        if (mSortStepper.value().type == READ_OP)
+            steps++;
+        else
+            mPlayedOps++;
     }
-    return (i + 1);
 }
 
-void Visualizer::Engine::bubbleSort()
+void Visualizer::Engine::startExternalSort()
 {
-    bool swapped;
-    for (int i = 0; i < gMAX_ELEMENTS[mCurrentElementsNumber] - 1; i++) {
-        swapped = false;
-        for (int j = 0; j < gMAX_ELEMENTS[mCurrentElementsNumber] - i - 1; j++) {
-            mComparisonsCount++;
-            if (mNumbersArray[j] > mNumbersArray[j + 1]) {
-                std::swap(mNumbersArray[j], mNumbersArray[j + 1]);
-                swapped = true;
-                mSwapsCount++;
-                mSwapElement = j + 1;
-                if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-                    handleEvents();
-                    if (!mIsRunning) return;
-                    draw();
-                }
+    ELEMENT_TYPE type = mCurrentElementType;
+    long long elements = gMAX_ELEMENTS[mCurrentElementsNumber] * 1024LL;
+
+    // The memory budget gives 48 runs, the blocks are small enough to merge 31 of them at a time
+    EXTERNAL_SORT_CONFIG config;
+    std::visit([&](const auto &array) { config.memoryBytes = elements * sizeof(array[0]) / 16; }, mNumbersArray);
+    config.blockBytes = config.memoryBytes / 64;
+    config.runSort = mCurrentSort;
+
+    mExternalSort.reset(new ExternalSort(config));
+    ExternalSort *externalSort = mExternalSort.get();
+    mExternalFinished = false;
+
+    mExternalThread = std::thread([this, externalSort, type, elements]() {
+        TRACE_THREAD("external sort");
+        TRACE_SPAN("external sort");
+        ElementArray input = makeElementArray(type, 0);
+        std::visit([&](const auto &array) {
+            typedef typename std::decay<decltype(array)>::type::value_type T;
+
+            FILE *in = std::tmpfile();
+            FILE *out = std::tmpfile();
+            try {
+                if (in == NULL || out == NULL)
+                    throw std::runtime_error("Failed to create the files of the external sort");
+
+                ExternalSort::writeRandomElements<T>(in, elements, time(NULL));
+                externalSort->sort<T>(in, out);
             }
-        }
+            catch (std::runtime_error &e) {
+                printf("%s\n", e.what());
+            }
+
+            if (in != NULL)
+                fclose(in);
+            if (out != NULL)
+                fclose(out);
+        }, input);
+
+        mExternalFinished = true;
+    });
+
+    // Start the timer
+    mStart = std::chrono::high_resolution_clock::now();
+}
 
-        if (!swapped) break;
+void Visualizer::Engine::stepExternalSort()
+{
+    if (!mExternalSort)
+        startExternalSort();
+
+    if (mExternalFinished) {
+        mExternalThread.join();
+        finishSort();
     }
 }
 
-void Visualizer::Engine::shellSort()
+void Visualizer::Engine::stopExternalSort()
 {
-    for (int gap = gMAX_ELEMENTS[mCurrentElementsNumber] / 2; gap > 0; gap /= 2) {
+    if (mExternalThread.joinable()) {
+        mExternalSort->cancel();
+        mExternalThread.join();
+    }
+}
 
-        for (int i = gap; i < gMAX_ELEMENTS[mCurrentElementsNumber]; i += 1) {
+void Visualizer::Engine::startScaling()
+{
+    ELEMENT_TYPE type = mCurrentElementType;
 
-            int temp = mNumbersArray[i], j;
+    mScalingReport.reset(new ScalingReport(time(NULL), 200.0));
+    ScalingReport *report = mScalingReport.get();
+    mScalingFinished = false;
 
-            for (j = i; j >= gap && mNumbersArray[j - gap] > temp; j -= gap) {
-                mNumbersArray[j] = mNumbersArray[j - gap];
-                mSwapsCount++;
-                if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-                    handleEvents();
-                    if (!mIsRunning) return;
-                    draw();
-                }
-            }
+    mScalingThread = std::thread([this, report, type]() {
+        TRACE_THREAD("scaling report");
+        std::vector<int> sizes = ScalingReport::sizes(16, 1 << 20);
+        for (int sort = 0; sort < Registry::instance().size(); sort++)
+            if (!Registry::instance()[sort].selects)
+                report->measure(sort, type, sizes);
 
-            mNumbersArray[j] = temp;
-        }
+        mScalingFinished = true;
+    });
+
+    // Start the timer
+    mStart = std::chrono::high_resolution_clock::now();
+}
+
+void Visualizer::Engine::stepScaling()
+{
+    if (!mScalingReport)
+        startScaling();
+
+    if (mScalingFinished) {
+        mScalingThread.join();
+        finishSort();
     }
 }
 
-void Visualizer::Engine::heapify(int n, int i)
+void Visualizer::Engine::stopScaling()
 {
-    int largest = i;
-    int l = 2 * i + 1;
-    int r = 2 * i + 2;
+    if (mScalingThread.joinable()) {
+        mScalingReport->cancel();
+        mScalingThread.join();
+    }
+}
 
-    if (l < n && mNumbersArray[l] > mNumbersArray[largest])
-        largest = l;
+void Visualizer::Engine::startSampleSort()
+{
+    // The nodes pause after each phase so the window shows them, shorter at higher speeds
+    SAMPLE_SORT_CONFIG config;
+    config.nodes = gSAMPLE_NODES;
+    config.localSort = Registry::instance()[mCurrentSort].selects ? PDQ_SORT : mCurrentSort;
+    config.phaseDelayMs = 1000 / gSPEEDS[mCurrentDrawSpeed];
+
+    mSampleSort.reset(new SampleSort(config));
+    SampleSort *sampleSort = mSampleSort.get();
+    mSampleFinished = false;
+
+    std::visit([&](const auto &array) { mInputChecksum = multisetChecksum(array); }, mNumbersArray);
+    ElementArray input = mNumbersArray;
+
+    mSampleThread = std::thread([this, sampleSort, input]() mutable {
+        TRACE_THREAD("sample sort");
+        std::visit([&](auto &array) {
+            try {
+                sampleSort->sort(array);
+            }
+            catch (std::runtime_error &e) {
+                printf("%s\n", e.what());
+            }
+        }, input);
 
-    if (r < n && mNumbersArray[r] > mNumbersArray[largest])
-        largest = r;
+        mSampleFinished = true;
+    });
 
-    if (largest != i) {
-        std::swap(mNumbersArray[i], mNumbersArray[largest]);
-        mSwapsCount++;
-        if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-            handleEvents();
-            if (!mIsRunning) return;
-            draw();
-        }
-        heapify(n, largest);
-    }
+    // Start the timer
+    mStart = std::chrono::high_resolution_clock::now();
 }
 
-void Visualizer::Engine::heapSort()
+void Visualizer::Engine::stepSampleSort()
 {
-    for (int i = gMAX_ELEMENTS[mCurrentElementsNumber] / 2 - 1; i >= 0; i--)
-        heapify(gMAX_ELEMENTS[mCurrentElementsNumber], i);
+    TRACE_SPAN("stepSampleSort");
 
-    for (int i = gMAX_ELEMENTS[mCurrentElementsNumber] - 1; i > 0; i--) {
+    if (!mSampleSort)
+        startSampleSort();
 
-        std::swap(mNumbersArray[0], mNumbersArray[i]);
+    // Read before the snapshot, so the last one is taken once the workers are done
+    bool finished = mSampleFinished;
+    std::visit([this](auto &array) { mSampleSort->snapshot(array, mSampleOwners); }, mNumbersArray);
 
-        mSwapsCount++;
-        if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-            handleEvents();
-            if (!mIsRunning) return;
-            draw();
-        }
-        heapify(i, 0);
+    if (finished) {
+        mSampleThread.join();
+        verifyArray();
+        finishSort();
+    }
+}
+
+void Visualizer::Engine::stopSampleSort()
+{
+    if (mSampleThread.joinable()) {
+        mSampleSort->cancel();
+        mSampleThread.join();
     }
 }
 
-void Visualizer::Engine::mergeSort(int l, int r)
+void Visualizer::Engine::startIngest()
 {
-    if (l >= r)
-        return; // Returns recursively
+    mIngest.reset(new AnyStreamIngest());
+    std::visit([this](const auto &array) {
+        typedef typename std::decay<decltype(array)>::type::value_type T;
+        mIngest->emplace<StreamIngest<T>>(mIngestStrategy);
+    }, mNumbersArray);
 
-    int mid = l + (r - l) / 2;
-    mergeSort(l, mid);
-    mergeSort(mid + 1, r);
-    merge(l, mid, r);
+    mIngestLatencies.clear();
+    mArrived = 0;
+
+    // Start the timer
+    mStart = std::chrono::high_resolution_clock::now();
 }
 
-void Visualizer::Engine::merge(int left, int mid, int right)
+void Visualizer::Engine::stepIngest()
 {
-    int subArrayOne = mid - left + 1;
-    int subArrayTwo = right - mid;
+    TRACE_SPAN("stepIngest");
+
+    if (!mIngest)
+        startIngest();
+
+    // While paused only the arrivals requested with N are streamed
+    if (mIsPaused && !mRequestStep)
+        return;
+
+    long long arrivals = mIsPaused ? 1 : gSPEEDS[mCurrentDrawSpeed];
+    mRequestStep = false;
+    mSonifier.beginFrame();
+
+    bool done = false;
+    std::visit([&](auto &array) {
+        typedef typename std::decay<decltype(array)>::type::value_type T;
+        StreamIngest<T> &structure = std::get<StreamIngest<T>>(*mIngest);
+        int n = array.size();
+
+        // Fast forward streams the rest of the array within this frame
+        T value = T();
+        while ((mIsFastForward || arrivals-- > 0) && mArrived < n) {
+            value = array[mArrived++];
+            auto start = std::chrono::high_resolution_clock::now();
+            structure.insert(value);
+            auto end = std::chrono::high_resolution_clock::now();
+            mIngestLatencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
 
-    // Create temp arrays
-    int *leftArray = new int[subArrayOne];
-    int *rightArray = new int[subArrayTwo];
+        done = mArrived == n;
+        if (done)
+            structure.compact();
 
-    // Copy data to temp arrays leftArray[] and rightArray[]
-    for (int i = 0; i < subArrayOne; i++)
-        leftArray[i] = mNumbersArray[left + i];
-    for (int j = 0; j < subArrayTwo; j++)
-        rightArray[j] = mNumbersArray[mid + 1 + j];
+        // The structure takes the front of the array, the elements still to arrive keep the back
+        std::vector<T> layout;
+        structure.layout(layout);
+        std::copy(layout.begin(), layout.end(), array.begin());
 
-    int indexOfSubArrayOne = 0;    // Initial index of first sub-array
-    int indexOfSubArrayTwo = 0;    // Initial index of second sub-array
-    int indexOfMergedArray = left; // Initial index of merged array
+        // The last element streamed in is highlighted where it landed
+        auto same = [&](const T &other) { return !TotalLess<T>()(value, other) && !TotalLess<T>()(other, value); };
+        mSwapElement = mArrived > 0 ? std::find_if(layout.begin(), layout.end(), same) - layout.begin() : -1;
+        mComparisonsCount = structure.stats().comparisons;
+        mSwapsCount = structure.stats().writes;
+    }, mNumbersArray);
 
-    // Merge the temp arrays back into array[left..right]
-    while (indexOfSubArrayOne < subArrayOne && indexOfSubArrayTwo < subArrayTwo) {
-        mSwapsCount++;
-        if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-            handleEvents();
-            if (!mIsRunning) return;
-            draw();
-        }
-        if (leftArray[indexOfSubArrayOne] <= rightArray[indexOfSubArrayTwo]) {
-            mNumbersArray[indexOfMergedArray] = leftArray[indexOfSubArrayOne];
-            indexOfSubArrayOne++;
-        }
-        else {
-            mNumbersArray[indexOfMergedArray] = rightArray[indexOfSubArrayTwo];
-            indexOfSubArrayTwo++;
-        }
-        mSwapElement = indexOfMergedArray;
-        indexOfMergedArray++;
-    }
+    sonify(mSwapElement);
 
-    while (indexOfSubArrayOne < subArrayOne) {
-        mNumbersArray[indexOfMergedArray] = leftArray[indexOfSubArrayOne];
-        mSwapsCount++;
-        if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-            handleEvents();
-            if (!mIsRunning) return;
-            draw();
-        }
+    if (done)
+        finishSort();
+}
 
-        indexOfSubArrayOne++;
-        indexOfMergedArray++;
-    }
+void Visualizer::Engine::connectFeed(const std::string &address)
+{
+    mFeed.reset(new FeedClient(address));
 
-    while (indexOfSubArrayTwo < subArrayTwo)
-    {
-        mNumbersArray[indexOfMergedArray] = rightArray[indexOfSubArrayTwo];
-        mSwapsCount++;
-        if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward)
-        {
-            // Handle events every few iterations
-            handleEvents();
-            if (!mIsRunning)
-            {
-                return;
+    // The keys that change the array or the sort are locked while viewing
+    mRequestSort = true;
+    mStart = std::chrono::high_resolution_clock::now();
+}
+
+void Visualizer::Engine::attach(const std::string &name)
+{
+    mAttached.reset(new ShmTraceReader(name));
+    mSortNameTexture->loadFromRenderedText("Attached to " + name, gFontColor);
+
+    // The keys that change the array or the sort are locked while attached
+    mRequestSort = true;
+    mStart = std::chrono::high_resolution_clock::now();
+}
+
+void Visualizer::Engine::receiveFeed()
+{
+    TRACE_SPAN("receiveFeed");
+
+    mFeedRecords.clear();
+    bool open = mFeed ? mFeed->receive(mFeedRecords) : mAttached->receive(mFeedRecords);
+    mSonifier.beginFrame();
+
+    for (const FEED_RECORD &record : mFeedRecords) {
+        switch (record.kind) {
+            case FEED_HELLO:
+                if (record.i != gFEED_VERSION || record.a != gFEED_MAGIC)
+                    throw std::runtime_error("The server streams an incompatible feed");
+                break;
+            case FEED_SORT:
+                // Plugins are only known if the viewer loaded the same ones
+                if (record.i >= 0 && record.i < Registry::instance().size()) {
+                    mCurrentSort = record.i;
+                    mSortNameTexture->loadFromRenderedText(Registry::instance()[mCurrentSort].name, gFontColor);
+                }
+                break;
+            case FEED_BEGIN:
+                if (record.i < 0 || record.i >= gELEMENT_TYPES_COUNT || record.a < 0)
+                    throw std::runtime_error("The server streams an invalid array");
+                mCurrentElementType = (ELEMENT_TYPE)record.i;
+                mNumbersArray = makeElementArray(mCurrentElementType, record.a);
+                mIsSorted = false;
+                mSwapElement = -1;
+                mCompareElement = -1;
+                mStart = std::chrono::high_resolution_clock::now();
+                resetCache();
+                {
+                    std::stringstream et;
+                    et << " Type: " << gELEMENT_TYPE_NAMES[mCurrentElementType] << " T";
+                    mElementTypeTexture->loadFromRenderedText(et.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+                    std::stringstream en;
+                    en << " Elements: " << record.a << " J/K";
+                    mElementNumberTexture->loadFromRenderedText(en.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+                }
+                break;
+            case FEED_VALUE:
+            case FEED_WRITE:
+                std::visit([&](auto &array) {
+                    if (record.i >= 0 && record.i < (int)array.size())
+                        memcpy(&array[record.i], &record.a, sizeof(array[0]));
+                }, mNumbersArray);
+                if (record.kind == FEED_WRITE)
+                    apply(SORT_OP{WRITE_OP, record.i, -1});
+                break;
+            case FEED_COMPARE:
+            case FEED_SWAP: {
+                bool valid = true;
+                std::visit([&](auto &array) {
+                    valid = record.i >= 0 && record.i < (int)array.size() && record.a >= 0 && record.a < (int)array.size();
+                    if (valid && record.kind == FEED_SWAP)
+                        std::swap(array[record.i], array[record.a]);
+                }, mNumbersArray);
+                if (valid)
+                    apply(SORT_OP{record.kind == FEED_SWAP ? SWAP_OP : COMPARE_OP, record.i, (int)record.a});
+                break;
+            }
+            case FEED_COMPARISONS:
+                mComparisonsCount = record.a;
+                break;
+            case FEED_SWAPS:
+                mSwapsCount = record.a;
+                break;
+            case FEED_END: {
+                auto end = std::chrono::high_resolution_clock::now();
+                mElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - mStart).count();
+                mIsSorted = true;
+                mSwapElement = -1;
+                mCompareElement = -1;
+                break;
             }
-            draw();
         }
+    }
+
+    // The bars are scaled to the values received this frame
+    if (!mFeedRecords.empty())
+        std::visit([this](const auto &array) { valueRange(array, mMinValue, mMaxValue); }, mNumbersArray);
 
-        indexOfSubArrayTwo++;
-        indexOfMergedArray++;
+    if (!open) {
+        printf(mFeed ? "The server closed the feed\n" : "The traced program stopped tracing\n");
+        mFeed.reset();
+        mAttached.reset();
+        finishSort();
     }
-    delete[] leftArray;
-    delete[] rightArray;
 }
 
-void Visualizer::Engine::selectionSort()
+void Visualizer::Engine::apply(const SORT_OP &op)
 {
-    int i, j, min_idx;
-    for (i = 0; i < gMAX_ELEMENTS[mCurrentElementsNumber] - 1; i++) {
-        min_idx = i;
-        for (j = i + 1; j < gMAX_ELEMENTS[mCurrentElementsNumber]; j++) {
+    if (mIsCacheMode)
+        mCache.apply(op);
 
+    switch (op.type) {
+        case COMPARE_OP:
             mComparisonsCount++;
-            if (mNumbersArray[j] < mNumbersArray[min_idx]){
-                min_idx = j;
-                mSwapElement = min_idx;
-            }
-
-            mCompareElement = j;
-            if (mComparisonsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-                handleEvents();
-                if (!mIsRunning) return;
-                draw();
-            }
-        }
-
-        if (min_idx != i) {
-            std::swap(mNumbersArray[min_idx], mNumbersArray[i]);
+            mCompareElement = op.j;
+            sonify(op.j);
+            break;
+        case SWAP_OP:
             mSwapsCount++;
-        }
+            mSwapElement = op.j;
+            sonify(op.j);
+            break;
+        case WRITE_OP:
+            mSwapsCount++;
+            mSwapElement = op.i;
+            sonify(op.i);
+            break;
+        case READ_OP:
+            break;
     }
 }
 
-void Visualizer::Engine::insertionSort()
+void Visualizer::Engine::gather(const SORT_OP &op)
 {
-    int i, key, j;
-    for (i = 1; i < gMAX_ELEMENTS[mCurrentElementsNumber]; i++) {
-        key = mNumbersArray[i];
-        j = i - 1;
-        mSwapElement = i;
+    if (op.type != SWAP_OP && op.type != WRITE_OP)
+        return;
+
+    std::visit([&](auto &array) {
+        typedef typename std::decay<decltype(array)>::type::value_type T;
+        const std::vector<T> &keys = std::get<std::vector<T>>(mArgsortKeys);
+
+        // A write only changes its destination, a swap both positions
+        if (op.i >= 0)
+            array[op.i] = keys[indexAt(mIndices, op.i)];
+        if (op.type == SWAP_OP && op.j >= 0)
+            array[op.j] = keys[indexAt(mIndices, op.j)];
+    }, mNumbersArray);
+}
 
-        while (j >= 0 && mNumbersArray[j] > key) {
-            mComparisonsCount++;
-            mNumbersArray[j + 1] = mNumbersArray[j];
-            j = j - 1;
+void Visualizer::Engine::sonify(int index)
+{
+    if (!mSonifier.isOpen() || index < 0)
+        return;
 
-            mCompareElement = j;
+    // The tone is as high as the bar of the element
+    std::visit([&](const auto &array) {
+        mSonifier.play(normalizeElement(array[index], mMinValue, mMaxValue, array.size()));
+    }, mNumbersArray);
+}
 
-            if (mComparisonsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward) {
-                handleEvents();
-                if (!mIsRunning) return;
-                draw();
-            }
-        }
+void Visualizer::Engine::resetCache()
+{
+    // An argsort moves its indices, not the elements
+    int elementBytes = mArgsortMode == DIRECT_SORT ? std::visit([](const auto &array) { return (int)sizeof(array[0]); }, mNumbersArray)
+                                                   : std::visit([](const auto &order) { return (int)sizeof(order[0]); }, mIndices);
+    std::visit([&](const auto &array) { mCache.reset(elementBytes, array.size()); }, mNumbersArray);
+}
 
-        mNumbersArray[j + 1] = key;
-        mSwapsCount++;
-    }
+void Visualizer::Engine::setCacheLevels(const std::vector<CACHE_LEVEL> &levels)
+{
+    mCache = CacheSimulator(levels);
+    resetCache();
 }
 
-void Visualizer::Engine::gnomeSort(){
-    int index = 0;
+void Visualizer::Engine::verifyArray()
+{
+    TRACE_SPAN("verifyArray");
 
-    while (index < gMAX_ELEMENTS[mCurrentElementsNumber]) {
-        mComparisonsCount++;
-        if (index == 0)
-            index++;
-        if (mNumbersArray[index] >= mNumbersArray[index - 1])
-            index++;
-        else {
-            std::swap(mNumbersArray[index], mNumbersArray[index - 1]);
-            index--;
-            mSwapsCount++;
-            if (mSwapsCount % gSPEEDS[mCurrentDrawSpeed] == 0 && !mIsFastForward)
-            {
-                handleEvents();
-                if (!mIsRunning) return;
-                mSwapElement = index;
-                draw();
-            }
-        }
-    }
+    // The sample sort always sorts the whole array
+    bool selects = Registry::instance()[mCurrentSort].selects && !mIsSampleMode;
+    std::visit([&](const auto &array) { mVerification = verifySort(array, mInputChecksum, !selects); }, mNumbersArray);
+    mIsVerified = true;
+
+    if (!mVerification.valid())
+        printf("%s %s\n", Registry::instance()[mCurrentSort].name.c_str(),
+               mVerification.permutation ? "left the array out of order" : "lost or changed elements of the array");
+}
+
+void Visualizer::Engine::finishSort()
+{
+    // Stop the timer
+    auto end = std::chrono::high_resolution_clock::now();
+    mElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - mStart).count();
+    // Release the coroutine frames
+    mSortStepper.reset();
+    // The array is sorted
+    mIsSorted = true;
+    // The request is stopped
+    mRequestSort = false;
+    // The sort is not paused anymore
+    mIsPaused = false;
+    // Reset the swap element
+    mSwapElement = -1;
+    // Reset the compare elements
+    mCompareElement = -1;
+}
+
+void Visualizer::Engine::fillArray()
+{
+    mNumbersArray = makeElementArray(mCurrentElementType, gMAX_ELEMENTS[mCurrentElementsNumber]);
+    std::visit([this](const auto &array) { valueRange(array, mMinValue, mMaxValue); }, mNumbersArray);
 }
 
 void Visualizer::Engine::shuffle()
 {
+    TRACE_SPAN("shuffle");
+
+    // Start again from the filled array, the few distinct values of an earlier input order would stay otherwise
+    if (!mFeed && !mAttached)
+        fillArray();
+
     // Shuffle the array
     srand(time(NULL));
 
-    for (int i = 0; i < gMAX_ELEMENTS[mCurrentElementsNumber]; i++) {
-        int random = rand() % gMAX_ELEMENTS[mCurrentElementsNumber];
-        std::swap(mNumbersArray[i], mNumbersArray[random]);
-        // Draw the array every 10% of the way through the shuffle
-        if (i % (gMAX_ELEMENTS[mCurrentElementsNumber] / 10) == 0)
-            draw();
-    }
+    std::visit([this](auto &array) {
+        int n = array.size();
+        for (int i = 0; i < n; i++) {
+            int random = rand() % n;
+            std::swap(array[i], array[random]);
+            // Draw the array every 10% of the way through the shuffle
+            if (i % (n / 10) == 0)
+                draw();
+        }
+
+        // The other input orders start from the shuffle, the few distinct values are spread at random
+        if (mInputDistribution != SHUFFLED_INPUT)
+            arrangeElements(array, mInputDistribution, rand());
+    }, mNumbersArray);
 
     //! Draw the array one last time (I MIGHT NEED TO ADD THIS TO THE SORTING ALGORITHMS AS WELL)
     draw();
@@ -849,10 +1324,50 @@ void Visualizer::Engine::shuffle()
     mElapsed = 0.000;
     // Reset the speed change flag
     mHasSpeedChanged = false;
+    // Reset the cache counters
+    resetCache();
+    // Reset the memory counters
+    mMemory.reset();
+    // The next sort may run at the speed
+    mIsPlayback = false;
+    // The auto mode decides again for the new array
+    mHasDecision = false;
+    mPredictedMs = 0.0;
+    // Forget the last external sort, sample sort and scaling report
+    mExternalSort.reset();
+    mSampleSort.reset();
+    mSampleOwners.clear();
+    mScalingReport.reset();
+    // Forget the verification of the last sort
+    mIsVerified = false;
+    // Forget the last ingest structure
+    mIngest.reset();
+    mIngestLatencies.clear();
+    mArrived = 0;
+    // Forget the indices of the last argsort
+    mIndices = IndexArray();
+    mArgsortKeys = ElementArray();
+    // Forget the positions settled by the last selection
+    std::visit([](auto &array) { array.clear(); }, mFinalArray);
+}
+
+std::string Visualizer::Engine::selectionText() const
+{
+    int k = Registry::instance().selectionK();
+    std::stringstream text;
+    text << " k: ";
+    if (k == 0)
+        text << "median (" << selectionCount(gMAX_ELEMENTS[mCurrentElementsNumber], k) << ")";
+    else
+        text << selectionCount(gMAX_ELEMENTS[mCurrentElementsNumber], k);
+    text << " Z";
+    return text.str();
 }
 
 void Visualizer::Engine::draw()
 {
+    TRACE_SPAN("draw");
+
     // Clear the screen
     SDL_RenderClear(mRenderer);
 
@@ -863,48 +1378,71 @@ void Visualizer::Engine::draw()
 
     spacing += mSortNameTexture->getHeight() + mWindowSize.y / 15;
 
-    // Render the info text
-    mInfoPanelTexture->render((mWindowSize.x - mUsableWidth - mInfoPanelTexture->getWidth()) / 2, spacing);
+    int left = (mWindowSize.x - mUsableWidth - mInfoPanelTexture->getWidth()) / 2;
 
-    spacing += mInfoPanelTexture->getHeight();
+    // Render the key listing the controls
+    mKeysTexture->render(left, spacing);
 
-    // Render the speed text
-    mSpeedTexture->render((mWindowSize.x - mUsableWidth - mInfoPanelTexture->getWidth()) / 2, spacing);
+    spacing += mKeysTexture->getHeight();
 
-    spacing += mSpeedTexture->getHeight();
+    // The statistics are stacked from here, in another column over the bars once past the bottom of the window
+    int top = spacing;
+    int column = 0;
 
-    // Render the elements number text
-    mElementNumberTexture->render((mWindowSize.x - mUsableWidth - mInfoPanelTexture->getWidth()) / 2, spacing);
-
-    spacing += mElementNumberTexture->getHeight();
+    // The keys replace the statistics, they are drawn over the array at the end like the columns past the first
+    std::vector<std::pair<LTexture *, SDL_Point>> overlay;
+    auto stack = [&](LTexture *texture) {
+        if (mIsHelpShown)
+            return;
+        if (spacing > top && spacing + texture->getHeight() > mWindowSize.y) {
+            column++;
+            spacing = top;
+        }
+        if (column == 0)
+            texture->render(left, spacing);
+        else
+            overlay.push_back({texture, {left + column * mInfoPanelTexture->getWidth(), spacing}});
+        spacing += texture->getHeight();
+    };
+
+    stack(mSpeedTexture);
+    stack(mElementNumberTexture);
+    stack(mElementTypeTexture);
+    stack(mCutoffTexture);
+    stack(mGapsTexture);
+    stack(mSelectionTexture);
+    stack(mIngestTexture);
+    stack(mPlaybackTexture);
+    stack(mArgsortTexture);
+    stack(mInputTexture);
 
     // Update the swap text
     std::stringstream swap_text;
     swap_text << " Swaps: " << mSwapsCount;
     mSwapsTexture->loadFromRenderedText(swap_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
     // Render the swap text
-    mSwapsTexture->render((mWindowSize.x - mUsableWidth - mInfoPanelTexture->getWidth()) / 2, spacing);
-
-    spacing += mSwapsTexture->getHeight();
+    stack(mSwapsTexture);
 
     // Update the comparisons text
     std::stringstream compare_text;
     compare_text << " Compare: " << mComparisonsCount;
     mComparisonsTexture->loadFromRenderedText(compare_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
     // Render the comparisons text
-    mComparisonsTexture->render((mWindowSize.x - mUsableWidth - mInfoPanelTexture->getWidth()) / 2, spacing);
-
-    spacing += mElementNumberTexture->getHeight();
+    stack(mComparisonsTexture);
 
     // Update time
-    if(mRequestSort) {
+    if(mRequestSort && !mIsSorted) {
         auto end = std::chrono::high_resolution_clock::now();
         mElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - mStart).count();
     }
 
     // Update the time text
     std::stringstream time_text;
-    if(!mIsFastForward && !mHasSpeedChanged)
+    if(mIsPaused)
+        time_text << " Time: " << "Paused";
+    else if(mIsPlayback && !mIsFastForward)
+        time_text << " Time: " << std::fixed << std::setprecision(1) << mTrueSortMs << "ms / " << mPlaybackMs / 1000.0 << "s";
+    else if(!mIsFastForward && !mHasSpeedChanged)
         time_text << " Time: " << mElapsed / 1000.0 << "s";
     else if(mIsFastForward)
         time_text << " Time: " << "Skipped";
@@ -913,17 +1451,156 @@ void Visualizer::Engine::draw()
 
     mTimeTexture->loadFromRenderedText(time_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
     // Render the time text
-    mTimeTexture->render((mWindowSize.x - mUsableWidth - mInfoPanelTexture->getWidth()) / 2, spacing);
+    stack(mTimeTexture);
+
+    // Render whether the last sort left a sorted permutation of its input
+    if (mIsVerified) {
+        std::stringstream verify_text;
+        verify_text << " Verified: ";
+        if (!mVerification.permutation)
+            verify_text << "lost elements";
+        else if (!mVerification.sorted)
+            verify_text << "not sorted";
+        else
+            verify_text << "ok " << std::fixed << std::setprecision(2) << mVerification.timeMs << "ms";
+        mVerifyTexture->loadFromRenderedText(verify_text.str(), gFontColor, false, mInfoPanelTexture->getWidth());
+        stack(mVerifyTexture);
+    }
 
-    // Render the array
-    draw_rects();
+    // Render the memory used besides the array and the deepest recursion
+    if (!mIsExternalMode && !mIsScalingMode && !mIsIngestMode && !mIsSampleMode) {
+        const MEMORY_STATS &stats = mMemory.stats();
+        std::stringstream memory_text;
+        memory_text << " Memory: " << (stats.peakBytes + 1023) / 1024 << "KB peak \n"
+                    << " Allocs: " << stats.allocations << " Depth: " << stats.peakDepth << " \n"
+                    << " Stack: " << (stats.peakStackBytes + 1023) / 1024 << "KB peak \n";
+        mMemoryTexture->loadFromRenderedText(memory_text.str(), gFontColor, true, mInfoPanelTexture->getWidth());
+        stack(mMemoryTexture);
+    }
+
+    // Render the algorithm the auto mode picked, its predicted and unthrottled times and what it saw of the array
+    if (mIsAutoMode) {
+        std::stringstream auto_text;
+        if (mCostModel.empty())
+            auto_text << " Auto: not calibrated \n (--calibration FILE) \n";
+        else if (!mHasDecision && mPredictedMs < 0.0)
+            auto_text << " Auto: no run with this \n cutoff and gaps (R/F) \n";
+        else if (!mHasDecision)
+            auto_text << " Auto: on start ENTER \n";
+        else
+            auto_text << " Auto: " << Registry::instance()[mCurrentSort].key << " ENTER \n"
+                      << std::fixed << std::setprecision(2)
+                      << " Predicted: " << mPredictedMs << "ms \n"
+                      << " Actual: " << mTrueSortMs << "ms \n"
+                      << " Desc: " << mFeatures.descents << " Inv: " << mFeatures.inversions << " \n"
+                      << " Dups: " << mFeatures.duplicates << " Range: " << std::defaultfloat << std::setprecision(3) << mFeatures.range << " \n";
+        mAutoTexture->loadFromRenderedText(auto_text.str(), gFontColor, true, mInfoPanelTexture->getWidth());
+        stack(mAutoTexture);
+    }
+
+    // Render the latencies of the inserts and the throughput they sustain
+    if (mIsIngestMode) {
+        INGEST_LATENCY latency = latencyPercentiles(mIngestLatencies);
+        double total = std::accumulate(mIngestLatencies.begin(), mIngestLatencies.end(), 0.0);
+        std::stringstream ingest_text;
+        ingest_text << " Arrived: " << mArrived << "/" << gMAX_ELEMENTS[mCurrentElementsNumber] << " \n"
+                    << " p50: " << (long long)latency.p50 << "ns p99: " << (long long)latency.p99 << "ns \n"
+                    << " p99.9: " << (long long)latency.p999 << "ns max: " << (long long)latency.max << "ns \n"
+                    << " Throughput: " << (long long)(total > 0 ? mIngestLatencies.size() * 1e9 / total : 0) << "/s \n";
+        mIngestStatsTexture->loadFromRenderedText(ingest_text.str(), gFontColor, true, mInfoPanelTexture->getWidth());
+        stack(mIngestStatsTexture);
+    }
+
+    // Render the hits and misses of every cache level
+    if (mIsCacheMode) {
+        std::stringstream cache_text;
+        for (size_t level = 0; level < mCache.levels().size(); level++) {
+            const CACHE_STATS &stats = mCache.stats(level);
+            long long accesses = stats.hits + stats.misses;
+            cache_text << " " << mCache.levels()[level].name << ": " << stats.misses << " miss "
+                       << (accesses > 0 ? (100 * stats.hits) / accesses : 100) << "% \n";
+        }
+        mCacheTexture->loadFromRenderedText(cache_text.str(), gFontColor, true, mInfoPanelTexture->getWidth());
+        stack(mCacheTexture);
+    }
+
+    // Render the progress of the external sort instead of the array
+    if (mIsExternalMode) {
+        EXTERNAL_SORT_STATUS status = mExternalSort ? mExternalSort->status() : EXTERNAL_SORT_STATUS();
+        std::stringstream external_text;
+        external_text << " Runs: " << status.stats.runs << "/" << status.expectedRuns << " Pass: " << status.stats.mergePasses << " \n"
+                      << " Read: " << status.stats.bytesRead / (1024 * 1024) << "MB Written: " << status.stats.bytesWritten / (1024 * 1024) << "MB \n"
+                      << " I/O wait: " << (long long)status.stats.ioWaitMs << "ms \n";
+        mExternalTexture->loadFromRenderedText(external_text.str(), gFontColor, true, mInfoPanelTexture->getWidth());
+        stack(mExternalTexture);
+
+        draw_external();
+    }
+    else if (mIsSampleMode) {
+        SAMPLE_SORT_STATS stats = mSampleSort ? mSampleSort->status() : SAMPLE_SORT_STATS();
+        auto bytes = [](long long count) {
+            std::stringstream text;
+            if (count < 10 * 1024)
+                text << count << "B";
+            else
+                text << count / 1024 << "KB";
+            return text.str();
+        };
+        std::stringstream sample_text;
+        sample_text << " Nodes: " << gSAMPLE_NODES << " Sent: " << bytes(stats.commBytes()) << " \n";
+        for (size_t node = 0; node < stats.nodes.size(); node++) {
+            const SAMPLE_NODE_STATS &info = stats.nodes[node];
+            sample_text << " " << node << ": " << gSAMPLE_PHASE_NAMES[info.phase] << " " << bytes(info.bytesSent) << "/" << bytes(info.bytesReceived)
+                        << " " << std::fixed << std::setprecision(1) << info.localSortMs << "+" << info.commMs << "ms \n";
+        }
+        mSampleTexture->loadFromRenderedText(sample_text.str(), gFontColor, true, mInfoPanelTexture->getWidth());
+        stack(mSampleTexture);
+
+        draw_sample();
+    }
+    else if (mIsScalingMode) {
+        std::vector<SCALING_CURVE> curves = mScalingReport ? mScalingReport->curves() : std::vector<SCALING_CURVE>();
+        std::stringstream scaling_text;
+        scaling_text << " Measured: " << curves.size() << "/" << Registry::instance().size() << " \n"
+                     << " Largest run: " << (curves.empty() ? 0 : curves.back().samples.back().n) << " \n";
+        mScalingTexture->loadFromRenderedText(scaling_text.str(), gFontColor, true, mInfoPanelTexture->getWidth());
+        stack(mScalingTexture);
+
+        draw_scaling();
+    }
+    else {
+        // Render the array
+        draw_rects();
+
+        if (mIsIngestMode)
+            draw_ingest();
+    }
+
+    // Render the statistics that didn't fit under the others
+    for (auto &placed : overlay)
+        placed.first->render(placed.second.x, placed.second.y);
+
+    // Render the keys in as many columns as the window height needs, over the array
+    if (mIsHelpShown) {
+        int rows = std::max(1, (mWindowSize.y - top) / TTF_FontLineSkip(mRobotoSmall));
+        int columnHeight = rows * TTF_FontLineSkip(mRobotoSmall);
+        for (int y = 0, x = left; y < mInfoPanelTexture->getHeight(); y += columnHeight, x += mInfoPanelTexture->getWidth()) {
+            SDL_Rect clip = {0, y, mInfoPanelTexture->getWidth(), std::min(columnHeight, mInfoPanelTexture->getHeight() - y)};
+            mInfoPanelTexture->render(x, top, &clip);
+        }
+    }
 
     // Update the screen
-    SDL_RenderPresent(mRenderer);
+    {
+        TRACE_SPAN("SDL_RenderPresent");
+        SDL_RenderPresent(mRenderer);
+    }
 }
 
 void Visualizer::Engine::draw_rects()
 {
+    TRACE_SPAN("draw_rects");
+
     // Each element in the array is a rectangle
     SDL_FRect rect;
 
@@ -936,33 +1613,307 @@ void Visualizer::Engine::draw_rects()
     int endColorG = 0x2b;
     int endColorB = 0xe0;
 
-    // Calculate the color step
-    double colorStepR = (endColorR - startColorR) / (double)gMAX_ELEMENTS[mCurrentElementsNumber];
-    double colorStepG = (endColorG - startColorG) / (double)gMAX_ELEMENTS[mCurrentElementsNumber];
-    double colorStepB = (endColorB - startColorB) / (double)gMAX_ELEMENTS[mCurrentElementsNumber];
-
-    // Draw the rectangles
-    for (int i = 0; i < gMAX_ELEMENTS[mCurrentElementsNumber]; i++) {
-        // Set the color of each rectangle (red if it's the element being swapped)
-        if(mCompareElement == i)
-            SDL_SetRenderDrawColor(mRenderer, 0x00, 0xFF, 0x00, 0xFF);
-        else if(mSwapElement == i)
-            SDL_SetRenderDrawColor(mRenderer, 0xFF, 0x00, 0x00, 0xFF);
-        else  
-            SDL_SetRenderDrawColor(mRenderer, startColorR + colorStepR * mNumbersArray[i], startColorG + colorStepG * mNumbersArray[i], startColorB + colorStepB * mNumbersArray[i], 0xFF);
-        // Set the width of the rectangle to the width of the window divided by the number of elements in the array
-        rect.w = (float)mUsableWidth / gMAX_ELEMENTS[mCurrentElementsNumber];
-        // Set the height of the rectangle
-        rect.h = ((float)mWindowSize.y / gMAX_ELEMENTS[mCurrentElementsNumber]) * mNumbersArray[i];
-        // Set the x coordinate by multiplying the index by the width of the rectangle
+    // The cache heatmap strip takes the bottom of the window
+    int barsBottom = mIsCacheMode ? mWindowSize.y - mWindowSize.y / 30 : mWindowSize.y;
+
+    std::visit([&](const auto &array) {
+        typedef typename std::decay<decltype(array)>::type::value_type T;
+        int n = array.size();
+
+        // The positions a selection settles, the sorted copy is empty for the other algorithms
+        const std::vector<T> *final = std::get_if<std::vector<T>>(&mFinalArray);
+        int selected = final != nullptr && (int)final->size() == n ? selectionCount(n, Registry::instance().selectionK()) : 0;
+
+        // Draw the rectangles
+        for (int i = 0; i < n; i++) {
+            // Fraction of the window height covered by the element, whatever the value range of the type
+            double height = normalizeElement(array[i], mMinValue, mMaxValue, n);
+
+            // Whether the element is among the k smallest and in its final place (once done, the k smallest are final as a set)
+            bool settled = i < selected && (mIsSorted || (!TotalLess<T>()(array[i], (*final)[i]) && !TotalLess<T>()((*final)[i], array[i])));
+
+            // Set the color of each rectangle (red if it's the element being swapped, yellow for NaNs, teal once selected)
+            if(mCompareElement == i)
+                SDL_SetRenderDrawColor(mRenderer, 0x00, 0xFF, 0x00, 0xFF);
+            else if(mSwapElement == i)
+                SDL_SetRenderDrawColor(mRenderer, 0xFF, 0x00, 0x00, 0xFF);
+            else if(settled)
+                SDL_SetRenderDrawColor(mRenderer, 0x1F, 0xB5, 0xA8, 0xFF);
+            else if(isNaN(array[i]))
+                SDL_SetRenderDrawColor(mRenderer, 0xFF, 0xD7, 0x00, 0xFF);
+            else
+                SDL_SetRenderDrawColor(mRenderer, startColorR + (endColorR - startColorR) * height, startColorG + (endColorG - startColorG) * height, startColorB + (endColorB - startColorB) * height, 0xFF);
+            // Set the width of the rectangle to the width of the window divided by the number of elements in the array
+            rect.w = (float)mUsableWidth / n;
+            // Set the height of the rectangle
+            rect.h = barsBottom * height;
+            // Set the x coordinate by multiplying the index by the width of the rectangle
+            rect.x = i * rect.w + (mWindowSize.x - mUsableWidth);
+            // Set the y coordinate by subtracting the height of the rectangle from the bottom of the bars
+            rect.y = barsBottom - rect.h;
+
+            // Draw the rectangle
+            SDL_RenderFillRectF(mRenderer, &rect);
+        }
+
+        // The boundary of the k smallest
+        if (selected > 0 && selected < n) {
+            SDL_FRect boundary = {selected * (float)mUsableWidth / n + (mWindowSize.x - mUsableWidth) - 1, 0, 2, (float)barsBottom};
+            SDL_SetRenderDrawColor(mRenderer, 0x1F, 0xB5, 0xA8, 0xFF);
+            SDL_RenderFillRectF(mRenderer, &boundary);
+        }
+    }, mNumbersArray);
+
+    if (mIsCacheMode)
+        draw_cache_heatmap(barsBottom);
+
+    // Set background color
+    SDL_SetRenderDrawColor(mRenderer, gBackgroundColor.r, gBackgroundColor.g, gBackgroundColor.b, gBackgroundColor.a);
+}
+
+void Visualizer::Engine::draw_ingest()
+{
+    int n = gMAX_ELEMENTS[mCurrentElementsNumber];
+    float width = (float)mUsableWidth / n;
+    int barsBottom = mIsCacheMode ? mWindowSize.y - mWindowSize.y / 30 : mWindowSize.y;
+
+    // A thin line after every run or leaf, the last one ends the structure
+    std::vector<int> blocks;
+    if (mIngest)
+        std::visit([&](const auto &structure) { blocks = structure.blocks(); }, *mIngest);
+
+    SDL_FRect line = {0, 0, 1, (float)barsBottom};
+    SDL_SetRenderDrawColor(mRenderer, 0x1F, 0xB5, 0xA8, 0xFF);
+
+    int end = 0;
+    for (int size : blocks) {
+        end += size;
+        line.x = end * width + (mWindowSize.x - mUsableWidth);
+        SDL_RenderFillRectF(mRenderer, &line);
+    }
+
+    // The elements still to arrive are after the thicker line
+    if (mArrived > 0 && mArrived < n) {
+        line.x = mArrived * width + (mWindowSize.x - mUsableWidth) - 1;
+        line.w = 3;
+        SDL_SetRenderDrawColor(mRenderer, 0xFF, 0xD7, 0x00, 0xFF);
+        SDL_RenderFillRectF(mRenderer, &line);
+    }
+
+    // Set background color
+    SDL_SetRenderDrawColor(mRenderer, gBackgroundColor.r, gBackgroundColor.g, gBackgroundColor.b, gBackgroundColor.a);
+}
+
+void Visualizer::Engine::draw_cache_heatmap(int top)
+{
+    const std::vector<long long> &misses = mCache.indexMisses();
+    int n = misses.size();
+    if (n == 0)
+        return;
+
+    // Each cell covers the indices under one bar, the hottest cell is drawn red
+    long long hottest = *std::max_element(misses.begin(), misses.end());
+
+    SDL_FRect rect;
+    rect.w = (float)mUsableWidth / n;
+    rect.h = mWindowSize.y - top;
+    rect.y = top;
+
+    for (int i = 0; i < n; i++) {
+        double heat = hottest > 0 ? (double)misses[i] / hottest : 0.0;
+        SDL_SetRenderDrawColor(mRenderer, 0x20 + 0xDF * heat, 0x20 + 0x40 * (1.0 - heat), 0x40 * (1.0 - heat), 0xFF);
         rect.x = i * rect.w + (mWindowSize.x - mUsableWidth);
-        // Set the y coordinate by subtracting the height of the rectangle from the height of the window
-        rect.y = mWindowSize.y - rect.h;
+        SDL_RenderFillRectF(mRenderer, &rect);
+    }
+}
 
-        // Draw the rectangle
+void Visualizer::Engine::draw_external()
+{
+    EXTERNAL_SORT_STATUS status = mExternalSort ? mExternalSort->status() : EXTERNAL_SORT_STATUS();
+
+    // The progress strip takes the bottom of the window
+    int barsBottom = mWindowSize.y - mWindowSize.y / 30;
+
+    // While the runs are written there is a bar for each run to come, while they are merged one for each run of the pass
+    bool merging = status.phase == EXTERNAL_MERGE || status.phase == EXTERNAL_DONE;
+    int n = merging ? status.runLengths.size() : status.expectedRuns;
+    long long total = 0;
+    for (long long length : status.runLengths)
+        total += length;
+
+    SDL_FRect rect;
+    for (int i = 0; i < (int)status.runLengths.size() && n > 0; i++) {
+        double height = 1.0;
+        if (merging && status.runLengths[i] > 0)
+            height -= (double)status.runConsumed[i] / status.runLengths[i];
+
+        // The runs go from the start to the end color like the bars of the array
+        double shade = (double)(i + 1) / n;
+        SDL_SetRenderDrawColor(mRenderer, 0xf3 + (0x69 - 0xf3) * shade, 0xee + (0x2b - 0xee) * shade, 0xfc + (0xe0 - 0xfc) * shade, 0xFF);
+
+        rect.w = (float)mUsableWidth / n;
+        rect.h = barsBottom * height;
+        rect.x = i * rect.w + (mWindowSize.x - mUsableWidth);
+        rect.y = barsBottom - rect.h;
         SDL_RenderFillRectF(mRenderer, &rect);
     }
 
+    // Elements written by the current phase (the run phase writes every element once, a merge pass the runs it merges)
+    long long target = merging ? total : status.stats.elements;
+    double progress = target > 0 ? (double)status.outputWritten / target : 0.0;
+
+    SDL_SetRenderDrawColor(mRenderer, 0x00, 0xC0, 0x60, 0xFF);
+    rect.x = mWindowSize.x - mUsableWidth;
+    rect.y = barsBottom;
+    rect.w = mUsableWidth * progress;
+    rect.h = mWindowSize.y - barsBottom;
+    SDL_RenderFillRectF(mRenderer, &rect);
+
     // Set background color
     SDL_SetRenderDrawColor(mRenderer, gBackgroundColor.r, gBackgroundColor.g, gBackgroundColor.b, gBackgroundColor.a);
-}
\ No newline at end of file
+}
+
+void Visualizer::Engine::draw_sample()
+{
+    TRACE_SPAN("draw_sample");
+
+    SAMPLE_SORT_STATS stats = mSampleSort ? mSampleSort->status() : SAMPLE_SORT_STATS();
+
+    // Each element takes the color of the node holding it, the shards and then the parts of the output
+    SDL_FRect rect;
+    std::visit([&](const auto &array) {
+        int n = array.size();
+        for (int i = 0; i < n; i++) {
+            int node = i < (int)mSampleOwners.size() ? mSampleOwners[i] : i * gSAMPLE_NODES / n;
+            const SDL_Color &color = gPLOT_COLORS[node % (sizeof(gPLOT_COLORS) / sizeof(gPLOT_COLORS[0]))];
+            SDL_SetRenderDrawColor(mRenderer, color.r, color.g, color.b, 0xFF);
+
+            rect.w = (float)mUsableWidth / n;
+            rect.h = mWindowSize.y * normalizeElement(array[i], mMinValue, mMaxValue, n);
+            rect.x = i * rect.w + (mWindowSize.x - mUsableWidth);
+            rect.y = mWindowSize.y - rect.h;
+            SDL_RenderFillRectF(mRenderer, &rect);
+        }
+    }, mNumbersArray);
+
+    // The bytes sent by each node (row) to every other one (column), brighter for more
+    int nodes = stats.nodes.size();
+    long long most = 1;
+    for (const SAMPLE_NODE_STATS &node : stats.nodes)
+        for (long long bytes : node.sentTo)
+            most = std::max(most, bytes);
+
+    float cell = mWindowSize.y / 6.0f / std::max(1, nodes);
+    float left = mWindowSize.x - mUsableWidth + cell / 2;
+    float top = cell / 2;
+    for (int from = 0; from < nodes; from++) {
+        const SDL_Color &color = gPLOT_COLORS[from % (sizeof(gPLOT_COLORS) / sizeof(gPLOT_COLORS[0]))];
+        for (int to = 0; to < nodes; to++) {
+            double share = (double)stats.nodes[from].sentTo[to] / most;
+            SDL_SetRenderDrawColor(mRenderer, gGridColor.r + (color.r - gGridColor.r) * share, gGridColor.g + (color.g - gGridColor.g) * share,
+                                   gGridColor.b + (color.b - gGridColor.b) * share, 0xFF);
+            rect = {left + to * cell, top + from * cell, cell - 1, cell - 1};
+            SDL_RenderFillRectF(mRenderer, &rect);
+        }
+    }
+
+    // Set background color
+    SDL_SetRenderDrawColor(mRenderer, gBackgroundColor.r, gBackgroundColor.g, gBackgroundColor.b, gBackgroundColor.a);
+}
+
+void Visualizer::Engine::draw_scaling()
+{
+    std::vector<SCALING_CURVE> curves = mScalingReport ? mScalingReport->curves() : std::vector<SCALING_CURVE>();
+
+    // The plot takes the area of the bars, with a margin for the labels
+    int margin = mWindowSize.y / 12;
+    float left = mWindowSize.x - mUsableWidth + margin;
+    float right = mWindowSize.x - margin / 2;
+    float top = margin / 2;
+    float bottom = mWindowSize.y - margin;
+
+    // The axes span whole decades around the samples, log10 of the size and of the time in ms
+    double minX = 1.0, maxX = 2.0, minY = -3.0, maxY = 0.0;
+    bool empty = true;
+    for (const SCALING_CURVE &curve : curves) {
+        for (const SCALING_SAMPLE &sample : curve.samples) {
+            if (sample.metrics[TIME_METRIC] <= 0)
+                continue;
+            double x = std::log10(sample.n);
+            double y = std::log10(sample.metrics[TIME_METRIC]);
+            minX = empty ? x : std::min(minX, x);
+            maxX = empty ? x : std::max(maxX, x);
+            minY = empty ? y : std::min(minY, y);
+            maxY = empty ? y : std::max(maxY, y);
+            empty = false;
+        }
+    }
+    minX = std::floor(minX);
+    maxX = std::max(std::ceil(maxX), minX + 1);
+    minY = std::floor(minY);
+    maxY = std::max(std::ceil(maxY), minY + 1);
+
+    auto toX = [&](double n) { return (float)(left + (std::log10(n) - minX) / (maxX - minX) * (right - left)); };
+    auto toY = [&](double ms) { return (float)(bottom - (std::log10(ms) - minY) / (maxY - minY) * (bottom - top)); };
+
+    // A grid line and a label for every decade
+    for (int decade = minX; decade <= maxX; decade++) {
+        float x = toX(std::pow(10.0, decade));
+        SDL_SetRenderDrawColor(mRenderer, gGridColor.r, gGridColor.g, gGridColor.b, gGridColor.a);
+        SDL_RenderDrawLineF(mRenderer, x, top, x, bottom);
+
+        std::stringstream label;
+        label << "10^" << decade << (decade == maxX ? " n" : "");
+        mPlotLabelTexture->loadFromRenderedText(label.str(), gFontColor);
+        mPlotLabelTexture->render(x - mPlotLabelTexture->getWidth() / 2, bottom + 4);
+    }
+    for (int decade = minY; decade <= maxY; decade++) {
+        float y = toY(std::pow(10.0, decade));
+        SDL_SetRenderDrawColor(mRenderer, gGridColor.r, gGridColor.g, gGridColor.b, gGridColor.a);
+        SDL_RenderDrawLineF(mRenderer, left, y, right, y);
+
+        std::stringstream label;
+        label << "10^" << decade << "ms";
+        mPlotLabelTexture->loadFromRenderedText(label.str(), gFontColor);
+        mPlotLabelTexture->render(left - mPlotLabelTexture->getWidth() - 4, y - mPlotLabelTexture->getHeight() / 2);
+    }
+
+    float legend = top;
+    for (const SCALING_CURVE &curve : curves) {
+        const SDL_Color &color = gPLOT_COLORS[curve.sort % gPLOT_COLORS_COUNT];
+        SDL_SetRenderDrawColor(mRenderer, color.r, color.g, color.b, color.a);
+
+        // The samples joined by lines
+        std::vector<SDL_FPoint> points;
+        for (const SCALING_SAMPLE &sample : curve.samples) {
+            if (sample.metrics[TIME_METRIC] <= 0)
+                continue;
+            points.push_back({toX(sample.n), toY(sample.metrics[TIME_METRIC])});
+            SDL_FRect rect = {points.back().x - 2, points.back().y - 2, 4, 4};
+            SDL_RenderFillRectF(mRenderer, &rect);
+        }
+        if (points.size() > 1)
+            SDL_RenderDrawLinesF(mRenderer, points.data(), points.size());
+
+        // The best fit dotted over the whole axis, so the extrapolated crossovers show
+        const SCALING_FIT &fit = curve.fits[TIME_METRIC];
+        if (fit.valid) {
+            for (float x = left; x <= right; x += 4) {
+                double n = std::pow(10.0, minX + (x - left) / (right - left) * (maxX - minX));
+                float y = toY(fit.predict(n));
+                if (y >= top && y <= bottom)
+                    SDL_RenderDrawPointF(mRenderer, x, y);
+            }
+        }
+
+        // The legend lists the best fit of each algorithm in the color of its curve
+        std::stringstream label;
+        label << Registry::instance()[curve.sort].key << ": " << (fit.valid ? gSCALING_MODEL_NAMES[fit.model] : "?");
+        mPlotLabelTexture->loadFromRenderedText(label.str(), color);
+        mPlotLabelTexture->render(left + 8, legend);
+        legend += mPlotLabelTexture->getHeight();
+    }
+
+    // Set background color
+    SDL_SetRenderDrawColor(mRenderer, gBackgroundColor.r, gBackgroundColor.g, gBackgroundColor.b, gBackgroundColor.a);
+}
@@ -12,8 +12,25 @@
 #include <string>
 #include <SDL2/SDL.h>
 #include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 #include "Utilities.hpp"
+#include "Elements.hpp"
+#include "Registry.hpp"
+#include "CacheSimulator.hpp"
+#include "ExternalSort.hpp"
+#include "Sonifier.hpp"
+#include "EventFeed.hpp"
+#include "ShmTrace.hpp"
+#include "ScalingReport.hpp"
+#include "StreamIngest.hpp"
+#include "SampleSort.hpp"
+#include "Verify.hpp"
+#include "CostModel.hpp"
+#include "Trace.hpp"
+#include "MemoryTracker.hpp"
 #include "LTexture.hpp"
 
 namespace Visualizer
@@ -44,6 +61,33 @@ namespace Visualizer
          */
         void run();
 
+        /*!
+         * @brief Replaces the cache hierarchy simulated in cache mode (X)
+         * @param levels The cache levels, from the closest to the farthest
+         */
+        void setCacheLevels(const std::vector<CACHE_LEVEL> &levels);
+
+        /*!
+         * @brief Shows the sorts streamed by a headless server instead of running them
+         * @param address The address the server streams on (unix:PATH, tcp:PORT or tcp:HOST:PORT)
+         * @throws std::runtime_error if the server can't be reached
+         */
+        void connectFeed(const std::string &address);
+
+        /*!
+         * @brief Shows the sort another program traces with a ShmTraceWriter instead of running them
+         * @param name The name of its shared memory, like /sort
+         * @throws std::runtime_error if no program traces under that name
+         */
+        void attach(const std::string &name);
+
+        /*!
+         * @brief Calibrates the cost model of the auto mode with a baseline of this machine
+         * @param path A baseline written by --save-baseline, with every input distribution
+         * @throws std::runtime_error if the baseline can't be read or holds no built-in algorithm
+         */
+        void loadCostModel(const std::string &path);
+
     private:
         COUPLE mWindowSize;            /*! The size of the window */
 
@@ -53,6 +97,13 @@ namespace Visualizer
         bool mIsSorted = false;       /*! Whether the array is sorted or not (end of sort)*/
         bool mIsFastForward = false;  /*! Whether the sort is fast forwarded or not (f was pressed while sorting)*/
         bool mHasSpeedChanged = false; /*! Whether the speed has changed or not (up or down arrow was pressed)*/
+        bool mIsPaused = false;       /*! Whether the sort is paused or not (p was pressed while sorting)*/
+        bool mRequestStep = false;    /*! Whether the user requested a single step of the paused sort (n was pressed)*/
+        bool mIsCacheMode = false;    /*! Whether the accesses of the sort go through the cache simulation (x was pressed)*/
+        bool mIsExternalMode = false; /*! Whether space runs the external sort on a file instead of sorting the array (d was pressed)*/
+        bool mIsScalingMode = false;  /*! Whether space measures how every algorithm scales instead of sorting the array (o was pressed)*/
+        bool mIsIngestMode = false;   /*! Whether space streams the array into the ingest structure instead of sorting it (5 was pressed)*/
+        bool mIsSampleMode = false;   /*! Whether space sorts the array with the sample sort of worker processes (7 was pressed)*/
 
         std::string mWindowTitle = "SDL Sort Visualizer"; /*! The title of the window */
 
@@ -66,25 +117,106 @@ namespace Visualizer
 
         int mCurrentElementsNumber = 3; /*! The currently selected number of elements */
 
-        SORT_IDENTIFIER mCurrentSort = BUBBLE_SORT; /*! The currently selected sort algorithm */
+        int mCurrentSort = BUBBLE_SORT; /*! The index in the Registry of the currently selected sort algorithm */
+
+        ELEMENT_TYPE mCurrentElementType = INT32_ELEMENTS; /*! The currently selected element type */
+
+        INGEST_STRATEGY mIngestStrategy = BINARY_INSERTION_INGEST; /*! The structure the array is streamed into in ingest mode */
+
+        int mPlaybackSeconds = 0;  /*! The duration the sort is played back in, 0 to run it at the selected speed (9) */
+        bool mIsPlayback = false;  /*! Whether the running or last sort is played back in that duration */
+        long long mPlaybackOps = 0; /*! The operations of the sort, counted by an unthrottled run before it's played */
+        long long mPlayedOps = 0;   /*! The operations played so far */
+        double mTrueSortMs = 0.0;   /*! The time of the unthrottled run */
+        double mPlaybackMs = 0.0;   /*! The time played so far, the pauses left out */
+        std::chrono::high_resolution_clock::time_point mLastStep; /*! When the sort was last stepped */
+
+        ARGSORT_MODE mArgsortMode = DIRECT_SORT; /*! Whether the sort moves the elements, their indices or their indices with cached keys (0) */
+        IndexArray mIndices;        /*! The indices the running argsort moves */
+        ElementArray mArgsortKeys;  /*! The elements as the argsort started, what its indices point to */
+
+        INPUT_DISTRIBUTION mInputDistribution = SHUFFLED_INPUT; /*! The order the shuffle leaves the elements in (LEFT/RIGHT) */
+
+        bool mIsAutoMode = false;   /*! Whether the sort picks the algorithm predicted to be the fastest (ENTER) */
+        CostModel mCostModel;       /*! The predictions of the auto mode, calibrated with --calibration */
+        bool mIsHelpShown = false;  /*! Whether the keys are listed instead of the statistics */
+        bool mHasDecision = false;  /*! Whether the auto mode picked the algorithm of the current array */
+        INPUT_FEATURES mFeatures;   /*! The features of the array it picked the algorithm for */
+        double mPredictedMs = 0.0;  /*! The predicted time of that algorithm, compared with mTrueSortMs, -1 if none was calibrated */
 
         SDL_Renderer *mRenderer = NULL; /*! The main renderer */
         SDL_Window *mWindow = NULL;     /*! The main window */
 
         LTexture *mSortNameTexture;    /*! The texture used to draw the text */
         LTexture *mInfoPanelTexture;   /*! The texture used to draw the info text */
+        LTexture *mKeysTexture;        /*! The texture used to draw the key showing the info text */
         LTexture *mSpeedTexture;       /*! The texture used to draw the speed text */
         LTexture *mSwapsTexture;       /*! The texture used to draw the swap count text */
         LTexture *mComparisonsTexture; /*! The texture used to draw the comparison count text */
         LTexture *mTimeTexture;        /*! The texture used to draw the time text */
         LTexture *mElementNumberTexture; /*! The texture used to draw the number of elements text */
+        LTexture *mElementTypeTexture;   /*! The texture used to draw the element type text */
+        LTexture *mCutoffTexture;        /*! The texture used to draw the sorting network cutoff text */
+        LTexture *mGapsTexture;          /*! The texture used to draw the shell sort gap sequence text */
+        LTexture *mSelectionTexture;     /*! The texture used to draw the selection k text */
+        LTexture *mVerifyTexture;        /*! The texture used to draw the verification of the last sort */
+        LTexture *mIngestTexture;        /*! The texture used to draw the ingest strategy text */
+        LTexture *mPlaybackTexture;      /*! The texture used to draw the playback duration text */
+        LTexture *mArgsortTexture;       /*! The texture used to draw the argsort mode text */
+        LTexture *mInputTexture;         /*! The texture used to draw the input distribution text */
+        LTexture *mAutoTexture;          /*! The texture used to draw the decision of the auto mode */
+        LTexture *mIngestStatsTexture;   /*! The texture used to draw the ingest latencies and throughput */
+        LTexture *mCacheTexture;         /*! The texture used to draw the cache statistics text */
+        LTexture *mExternalTexture;      /*! The texture used to draw the external sort statistics text */
+        LTexture *mSampleTexture;        /*! The texture used to draw the phases and traffic of the sample sort nodes */
+        LTexture *mMemoryTexture;        /*! The texture used to draw the memory statistics text */
+        LTexture *mScalingTexture;       /*! The texture used to draw the progress of the scaling report */
+        LTexture *mPlotLabelTexture;     /*! The texture used to draw the labels of the scaling plot */
 
         TTF_Font *mRobotoSmall; /*! The font used to draw the text */
         TTF_Font *mRobotoLarge; /*! The font used to draw the text */
 
         int mUsableWidth; /*! The usable width of the window */
 
-        std::vector<int> mNumbersArray; /*! The array to be sorted */
+        ElementArray mNumbersArray; /*! The array to be sorted */
+
+        ElementArray mFinalArray; /*! The array sorted in advance when a selection runs, to show the positions already final */
+
+        SortGenerator mSortStepper; /*! The coroutine of the running sort, stepped once per frame */
+
+        MULTISET_CHECKSUM mInputChecksum; /*! The checksum of the array when the sort started */
+        SORT_VERIFICATION mVerification;  /*! The checks of the array once the sort ended */
+        bool mIsVerified = false;         /*! Whether the last sort was verified (the other modes don't sort the array) */
+
+        CacheSimulator mCache = CacheSimulator(CacheSimulator::windowLevels()); /*! The simulated caches fed in cache mode */
+
+        MemoryTracker mMemory; /*! Counts the buffers, frames and recursion of the running sort */
+
+        Sonifier mSonifier; /*! Plays the operations of the sort while open (a was pressed) */
+
+        std::unique_ptr<ExternalSort> mExternalSort; /*! The external sort in progress, if any */
+        std::thread mExternalThread;                 /*! The thread running the external sort */
+        std::atomic<bool> mExternalFinished = false; /*! Set by the thread once it is done, even if the sort failed */
+
+        std::unique_ptr<ScalingReport> mScalingReport; /*! The scaling report in progress, if any */
+        std::thread mScalingThread;                    /*! The thread measuring the algorithms */
+        std::atomic<bool> mScalingFinished = false;    /*! Set by the thread once every algorithm is measured */
+
+        std::unique_ptr<SampleSort> mSampleSort;   /*! The sample sort in progress, if any */
+        std::thread mSampleThread;                 /*! The thread waiting for the worker processes */
+        std::atomic<bool> mSampleFinished = false; /*! Set by the thread once the workers are done, even if the sort failed */
+        std::vector<int> mSampleOwners;            /*! The node holding each element of the array */
+
+        std::unique_ptr<AnyStreamIngest> mIngest; /*! The structure the array is streamed into, if any */
+        std::vector<double> mIngestLatencies;    /*! The time of every insert so far, in nanoseconds */
+        int mArrived = 0;                        /*! The elements of the array streamed in so far, the structure takes their place */
+
+        std::unique_ptr<FeedClient> mFeed; /*! The server whose sorts are shown, if any */
+        std::unique_ptr<ShmTraceReader> mAttached; /*! The program whose sort is shown, if any */
+        std::vector<FEED_RECORD> mFeedRecords; /*! The records received in the current frame */
+
+        double mMinValue = 0.0; /*! The smallest value of the array, used to normalize the bars */
+        double mMaxValue = 0.0; /*! The largest value of the array, used to normalize the bars */
 
         std::chrono::high_resolution_clock::time_point mStart; /*! The start time of the sort */
         long long mElapsed = 0;
@@ -101,86 +233,159 @@ namespace Visualizer
         void handleEvents();
 
         /*!
-         * @brief Sorts the array using the currently selected algorithm
+         * @brief Selects the algorithm to run, unless a sort is running
+         * @param sort The index of the algorithm in the Registry
+         */
+        void selectSort(int sort);
+
+        /*!
+         * @brief Runs the currently selected algorithm on a copy of the array without drawing it,
+         *        counting the operations to play back and timing it
+         */
+        void countPlayback();
+
+        /*!
+         * @brief Creates the generator of the currently selected algorithm and starts the timer
+         */
+        void startSort();
+
+        /*!
+         * @brief Runs as many steps of the sort as the current speed allows in one frame
+         */
+        void stepSort();
+
+        /*!
+         * @brief Updates the counters and the highlighted elements with an operation of the sort
+         * @param op The operation yielded by the algorithm
+         */
+        void apply(const SORT_OP &op);
+
+        /*!
+         * @brief Samples the features of the array and selects the algorithm the cost model predicts to be the fastest
          */
-        void sort();
+        void chooseSort();
 
         /*!
-         * @brief Sorts the array using cocktail sort
+         * @brief Copies the keys of the indices an operation of the argsort moved into the array,
+         *        so the bars show the elements in the order of the indices
+         * @param op The operation yielded by the algorithm
          */
-        void cocktailSort();
+        void gather(const SORT_OP &op);
 
         /*!
-         * @brief Sorts the array using quick sort
-         * @param low The lower bound of the array
-         * @param high The upper bound of the array
+         * @brief Plays the tone of an element, pitched by its value
+         * @param index The index of the element
          */
-        void quickSort(int low, int high);
+        void sonify(int index);
 
         /*!
-         * @brief Utility function used by quick sort
-         * @param low The lower bound of the array
-         * @param high The upper bound of the array
+         * @brief Empties the simulated caches and sizes their counters for the current array
          */
-        int partition(int low, int high);
+        void resetCache();
 
         /*!
-         * @brief Sorts the array using bubble sort
+         * @brief Checks that the array is sorted (or selected) and holds the elements it held when the sort started
          */
-        void bubbleSort();
+        void verifyArray();
 
         /*!
-         * @brief Sorts the array using shell sort
+         * @brief Stops the timer and marks the array as sorted
          */
-        void shellSort();
+        void finishSort();
 
         /*!
-         * @brief Utility function used by heap sort
-         * @param n The size of the heap
-         * @param i The index of the array root
+         * @brief Starts the external sort of a file of random elements on its own thread
+         * @details The file holds 1024 times the selected number of elements of the selected type,
+         *          its chunks are sorted by the selected algorithm within 1/16 of the file size.
          */
-        void heapify(int n, int i);
+        void startExternalSort();
 
         /*!
-         * @brief Sorts the array using heap sort
+         * @brief Starts the external sort if needed and finishes it once its thread is done
          */
-        void heapSort();
+        void stepExternalSort();
 
         /*!
-         * @brief Utility function used by merge sort
-         * @param l The lower bound of the array
-         * @param r The upper bound of the array
-         * @param m The middle index of the array
+         * @brief Cancels the external sort and waits for its thread
          */
-        void merge(int l, int m, int r);
+        void stopExternalSort();
 
         /*!
-         * @brief Sorts the array using merge sort
-         * @param l The lower bound of the array
-         * @param r The upper bound of the array
+         * @brief Starts measuring every algorithm on the selected element type on its own thread
+         * @details The sizes double from 16 to 1M, each algorithm stops growing once a run takes 50ms.
          */
-        void mergeSort(int l, int r);
+        void startScaling();
 
-        /*
-         * @brief Sorts the array using selection sort
+        /*!
+         * @brief Starts the scaling report if needed and finishes it once its thread is done
+         */
+        void stepScaling();
+
+        /*!
+         * @brief Cancels the scaling report and waits for its thread
+         */
+        void stopScaling();
+
+        /*!
+         * @brief Starts the sample sort of a copy of the array by worker processes, waited for on its own thread
          */
-        void selectionSort();
+        void startSampleSort();
 
         /*!
-         * @brief Sorts the array using insertion sort
+         * @brief Starts the sample sort if needed, copies what the nodes hold into the array and
+         *        finishes the sort once the workers are done
          */
-        void insertionSort();
+        void stepSampleSort();
 
         /*!
-         * @brief Sorts the array using gnome sort
+         * @brief Kills the workers of the sample sort and waits for its thread
          */
-        void gnomeSort();
+        void stopSampleSort();
+
+        /*!
+         * @brief Creates the ingest structure of the selected strategy for the element type and starts the timer
+         */
+        void startIngest();
+
+        /*!
+         * @brief Streams as many elements into the structure as the current speed allows in one frame
+         * @details The structure is copied over the front of the array after every frame, the
+         *          elements still to arrive keep the back. Once all arrived the LSM runs are merged.
+         */
+        void stepIngest();
+
+        /*!
+         * @brief Applies the records received from the server or the traced program since the last frame
+         */
+        void receiveFeed();
+
+        /*!
+         * @brief Fills the array with the values of the currently selected element type
+         */
+        void fillArray();
 
         /*!
          * @brief Shuffles the array using the Fisher-Yates algorithm
          */
         void shuffle();
 
+        /*!
+         * @brief The text of the selection k, as many smallest elements as the array holds
+         */
+        std::string selectionText() const;
+
+        /*!
+         * @brief Draws the array colored by the node holding each element and the bytes each
+         *        node sent to every other one
+         */
+        void draw_sample();
+
+        /*!
+         * @brief Draws the boundaries of the LSM runs or the B-tree leaves and the end of the
+         *        elements streamed in
+         */
+        void draw_ingest();
+
         /*!
          * @brief Draws the elements to the screen
          */
@@ -190,6 +395,24 @@ namespace Visualizer
          * @brief Draws the array elements to the screen as rectangles
          */
         void draw_rects();
+
+        /*!
+         * @brief Draws the misses caused by each index as a strip under the bars
+         * @param top The y coordinate of the top of the strip
+         */
+        void draw_cache_heatmap(int top);
+
+        /*!
+         * @brief Draws the runs of the external sort as bars (full when written, draining while merged)
+         *        and the progress of the current phase as a strip under them
+         */
+        void draw_external();
+
+        /*!
+         * @brief Draws the time of every algorithm against the number of elements on log-log axes,
+         *        with the fitted model of each one dotted and a legend of the best fits
+         */
+        void draw_scaling();
     };
 }
 
@@ -0,0 +1,405 @@
+//
+//  EventFeed.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#endif
+
+#include "EventFeed.hpp"
+
+namespace
+{
+    const size_t RING_RECORDS = 1 << 16;  // 1MB of records shared by every viewer
+    const size_t BATCH_RECORDS = 256;     // Records published at once by the sorting thread
+    const size_t SEND_RECORDS = 4096;     // Records copied out of the ring for a viewer at once
+
+    // States of a viewer
+    enum CLIENT_STATE
+    {
+        CLIENT_WAITING,  // Needs a snapshot, until the sorting thread prepares it
+        CLIENT_READY,    // The snapshot is ready
+        CLIENT_STREAMING // Receives the ring from its cursor
+    };
+
+    typedef struct FEED_ADDRESS
+    {
+        bool isUnix;
+        std::string path; /*! The path of the Unix socket */
+        std::string host; /*! The host of the TCP socket */
+        std::string port; /*! The port of the TCP socket */
+    } FEED_ADDRESS;
+
+    // Parses unix:PATH, tcp:PORT or tcp:HOST:PORT
+    FEED_ADDRESS parseAddress(const std::string &address)
+    {
+        FEED_ADDRESS parsed = {false, "", "127.0.0.1", ""};
+
+        if (address.rfind("unix:", 0) == 0 && address.size() > 5) {
+            parsed.isUnix = true;
+            parsed.path = address.substr(5);
+        }
+        else if (address.rfind("tcp:", 0) == 0 && address.size() > 4) {
+            std::string rest = address.substr(4);
+            size_t colon = rest.rfind(':');
+            if (colon != std::string::npos) {
+                parsed.host = rest.substr(0, colon);
+                rest = rest.substr(colon + 1);
+            }
+            parsed.port = rest;
+        }
+        else
+            throw std::runtime_error("Invalid feed address (unix:PATH or tcp:[HOST:]PORT): " + address);
+
+        return parsed;
+    }
+
+#ifndef _WIN32
+    void setNonBlocking(int socket)
+    {
+        fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+#ifdef MSG_NOSIGNAL
+    const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    const int SEND_FLAGS = 0;
+#endif
+#endif
+}
+
+struct Visualizer::FeedServer::Client
+{
+    int socket = -1;
+    std::atomic<int> state = CLIENT_WAITING;
+
+    // Written by the sorting thread while waiting, read by the sender once ready
+    std::vector<FEED_RECORD> snapshot;
+    uint64_t snapshotCursor = 0;
+
+    // Only used by the sender
+    uint64_t cursor = 0;       /*! The next record of the ring to send */
+    std::vector<char> pending; /*! The bytes being sent */
+    size_t sent = 0;           /*! The bytes of pending already sent */
+};
+
+Visualizer::FeedServer::FeedServer(const std::string &address)
+{
+#ifdef _WIN32
+    throw std::runtime_error("The event feed is not supported on this platform");
+#else
+    FEED_ADDRESS parsed = parseAddress(address);
+
+    if (parsed.isUnix) {
+        sockaddr_un local = {};
+        local.sun_family = AF_UNIX;
+        if (parsed.path.size() >= sizeof(local.sun_path))
+            throw std::runtime_error("Socket path too long: " + parsed.path);
+        strcpy(local.sun_path, parsed.path.c_str());
+
+        mListener = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(parsed.path.c_str());
+        if (mListener < 0 || bind(mListener, (sockaddr *)&local, sizeof(local)) < 0)
+            throw std::runtime_error("Failed to bind " + address + ": " + strerror(errno));
+        mUnixPath = parsed.path;
+    }
+    else {
+        // Only local viewers (or tunnels) can connect
+        sockaddr_in local = {};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(std::stoi(parsed.port));
+        local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        int reuse = 1;
+        mListener = socket(AF_INET, SOCK_STREAM, 0);
+        if (mListener >= 0)
+            setsockopt(mListener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (mListener < 0 || bind(mListener, (sockaddr *)&local, sizeof(local)) < 0)
+            throw std::runtime_error("Failed to bind " + address + ": " + strerror(errno));
+    }
+
+    if (listen(mListener, 8) < 0)
+        throw std::runtime_error("Failed to listen on " + address + ": " + strerror(errno));
+    setNonBlocking(mListener);
+
+    mRing.reset(new std::atomic<int64_t>[RING_RECORDS * 2]());
+    mBatch.reserve(BATCH_RECORDS);
+    mSender = std::thread(&FeedServer::sendLoop, this);
+#endif
+}
+
+Visualizer::FeedServer::~FeedServer()
+{
+#ifndef _WIN32
+    mStop = true;
+    if (mSender.joinable())
+        mSender.join();
+
+    for (const std::shared_ptr<Client> &client : mClients)
+        close(client->socket);
+    if (mListener >= 0)
+        close(mListener);
+    if (!mUnixPath.empty())
+        unlink(mUnixPath.c_str());
+#endif
+}
+
+void Visualizer::FeedServer::flush()
+{
+    if (!mBatch.empty()) {
+        // Like a seqlock: a sender that copied a slot being overwritten sees the reservation
+        uint64_t head = mHead.load(std::memory_order_relaxed);
+        mReserved.store(head + mBatch.size(), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t k = 0; k < mBatch.size(); k++) {
+            int64_t words[2];
+            memcpy(words, &mBatch[k], sizeof(words));
+            size_t slot = (head + k) % RING_RECORDS;
+            mRing[slot * 2].store(words[0], std::memory_order_relaxed);
+            mRing[slot * 2 + 1].store(words[1], std::memory_order_relaxed);
+        }
+        mHead.store(head + mBatch.size(), std::memory_order_release);
+        mBatch.clear();
+    }
+
+    // The snapshots are taken here, between two operations of the sort
+    if (mPendingSnapshots.exchange(0, std::memory_order_acquire) == 0)
+        return;
+
+    std::vector<std::shared_ptr<Client>> clients;
+    {
+        std::lock_guard<std::mutex> lock(mClientsMutex);
+        clients = mClients;
+    }
+
+    for (const std::shared_ptr<Client> &client : clients) {
+        if (client->state.load(std::memory_order_acquire) != CLIENT_WAITING)
+            continue;
+
+        client->snapshot.clear();
+        client->snapshot.push_back(FEED_RECORD{FEED_HELLO, {}, gFEED_VERSION, gFEED_MAGIC});
+        if (mSnapshot)
+            mSnapshot(client->snapshot);
+        client->snapshotCursor = mHead.load(std::memory_order_relaxed);
+
+        client->state.store(CLIENT_READY, std::memory_order_release);
+    }
+}
+
+int Visualizer::FeedServer::clients()
+{
+    std::lock_guard<std::mutex> lock(mClientsMutex);
+    return mClients.size();
+}
+
+void Visualizer::FeedServer::sendLoop()
+{
+#ifndef _WIN32
+    std::vector<pollfd> fds;
+
+    while (!mStop) {
+        // Accept the new viewers, they wait for a snapshot
+        for (int socket; (socket = accept(mListener, NULL, NULL)) >= 0;) {
+            setNonBlocking(socket);
+#ifdef SO_NOSIGPIPE
+            int noSignal = 1;
+            setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+            std::shared_ptr<Client> client = std::make_shared<Client>();
+            client->socket = socket;
+
+            std::lock_guard<std::mutex> lock(mClientsMutex);
+            mClients.push_back(client);
+            mPendingSnapshots++;
+        }
+
+        std::vector<std::shared_ptr<Client>> clients;
+        {
+            std::lock_guard<std::mutex> lock(mClientsMutex);
+            clients = mClients;
+        }
+
+        bool progress = false;
+        std::vector<std::shared_ptr<Client>> closed;
+
+        for (const std::shared_ptr<Client> &client : clients) {
+            if (client->state.load(std::memory_order_acquire) == CLIENT_READY) {
+                client->pending.assign((const char *)client->snapshot.data(), (const char *)(client->snapshot.data() + client->snapshot.size()));
+                client->sent = 0;
+                client->cursor = client->snapshotCursor;
+                client->state.store(CLIENT_STREAMING, std::memory_order_release);
+            }
+            if (client->state.load(std::memory_order_acquire) != CLIENT_STREAMING)
+                continue;
+
+            // Once everything pending is sent the next records are copied out of the ring
+            if (client->sent == client->pending.size()) {
+                uint64_t head = mHead.load(std::memory_order_acquire);
+                size_t count = std::min<uint64_t>(head - client->cursor, SEND_RECORDS);
+                bool lapped = head - client->cursor > RING_RECORDS;
+
+                if (!lapped && count > 0) {
+                    client->pending.resize(count * sizeof(FEED_RECORD));
+                    for (size_t k = 0; k < count; k++) {
+                        size_t slot = (client->cursor + k) % RING_RECORDS;
+                        int64_t words[2] = {mRing[slot * 2].load(std::memory_order_relaxed), mRing[slot * 2 + 1].load(std::memory_order_relaxed)};
+                        memcpy(&client->pending[k * sizeof(FEED_RECORD)], words, sizeof(FEED_RECORD));
+                    }
+                    client->sent = 0;
+
+                    // The records copied are only valid if the sorting thread didn't start overwriting them meanwhile
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    lapped = mReserved.load(std::memory_order_relaxed) - client->cursor > RING_RECORDS;
+                    client->cursor += count;
+                }
+
+                // A viewer that fell a whole ring behind starts over from a snapshot
+                if (lapped) {
+                    client->pending.clear();
+                    client->sent = 0;
+                    client->state.store(CLIENT_WAITING, std::memory_order_release);
+                    mPendingSnapshots++;
+                    continue;
+                }
+            }
+
+            if (client->sent < client->pending.size()) {
+                ssize_t sent = send(client->socket, client->pending.data() + client->sent, client->pending.size() - client->sent, SEND_FLAGS);
+                if (sent > 0) {
+                    client->sent += sent;
+                    progress = true;
+                }
+                else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                    closed.push_back(client);
+            }
+        }
+
+        // Wait for a viewer to connect, leave or accept more bytes, or for the next records
+        fds.assign(1, pollfd{mListener, POLLIN, 0});
+        for (const std::shared_ptr<Client> &client : clients)
+            fds.push_back(pollfd{client->socket, (short)(client->sent < client->pending.size() ? POLLOUT : POLLIN), 0});
+
+        poll(fds.data(), fds.size(), progress ? 0 : 5);
+
+        for (size_t k = 1; k < fds.size(); k++) {
+            char byte;
+            if ((fds[k].revents & (POLLERR | POLLHUP | POLLNVAL)) ||
+                ((fds[k].revents & POLLIN) && recv(fds[k].fd, &byte, 1, 0) == 0))
+                closed.push_back(clients[k - 1]);
+        }
+
+        if (!closed.empty()) {
+            std::lock_guard<std::mutex> lock(mClientsMutex);
+            for (const std::shared_ptr<Client> &client : closed) {
+                auto found = std::find(mClients.begin(), mClients.end(), client);
+                if (found == mClients.end())
+                    continue;
+
+                close(client->socket);
+                mClients.erase(found);
+            }
+        }
+    }
+#endif
+}
+
+Visualizer::FeedClient::FeedClient(const std::string &address)
+{
+#ifdef _WIN32
+    throw std::runtime_error("The event feed is not supported on this platform");
+#else
+    FEED_ADDRESS parsed = parseAddress(address);
+
+    if (parsed.isUnix) {
+        sockaddr_un remote = {};
+        remote.sun_family = AF_UNIX;
+        if (parsed.path.size() >= sizeof(remote.sun_path))
+            throw std::runtime_error("Socket path too long: " + parsed.path);
+        strcpy(remote.sun_path, parsed.path.c_str());
+
+        mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (mSocket >= 0 && connect(mSocket, (sockaddr *)&remote, sizeof(remote)) < 0) {
+            close(mSocket);
+            mSocket = -1;
+        }
+    }
+    else {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo *results = NULL;
+        if (getaddrinfo(parsed.host.c_str(), parsed.port.c_str(), &hints, &results) == 0) {
+            for (addrinfo *result = results; result != NULL && mSocket < 0; result = result->ai_next) {
+                mSocket = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+                if (mSocket >= 0 && connect(mSocket, result->ai_addr, result->ai_addrlen) < 0) {
+                    close(mSocket);
+                    mSocket = -1;
+                }
+            }
+            freeaddrinfo(results);
+        }
+    }
+
+    if (mSocket < 0)
+        throw std::runtime_error("Failed to connect to " + address + ": " + strerror(errno));
+    setNonBlocking(mSocket);
+#endif
+}
+
+Visualizer::FeedClient::~FeedClient()
+{
+#ifndef _WIN32
+    if (mSocket >= 0)
+        close(mSocket);
+#endif
+}
+
+bool Visualizer::FeedClient::receive(std::vector<FEED_RECORD> &records)
+{
+#ifdef _WIN32
+    return false;
+#else
+    char buffer[1 << 16];
+    bool open = true;
+
+    // At most 4MB per call, so a flood of records can't stall the frame
+    for (int reads = 0; reads < 64; reads++) {
+        ssize_t received = recv(mSocket, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            mPartial.insert(mPartial.end(), buffer, buffer + received);
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+            open = false;
+        if (received == 0 || errno != EINTR)
+            break;
+    }
+
+    // Only whole records are returned, the rest waits for the next call
+    size_t whole = mPartial.size() / sizeof(FEED_RECORD);
+    size_t first = records.size();
+    records.resize(first + whole);
+    memcpy(records.data() + first, mPartial.data(), whole * sizeof(FEED_RECORD));
+    mPartial.erase(mPartial.begin(), mPartial.begin() + whole * sizeof(FEED_RECORD));
+
+    return open;
+#endif
+}
@@ -0,0 +1,151 @@
+//
+//  EventFeed.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef EventFeed_hpp
+#define EventFeed_hpp
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+
+namespace Visualizer
+{
+    /*!
+     * @brief Enum that represents the kinds of records of the event feed
+     */
+    enum FEED_KIND
+    {
+        FEED_HELLO,       // i the version, a gFEED_MAGIC, first record sent to a client
+        FEED_SORT,        // i the index of the algorithm in the Registry
+        FEED_BEGIN,       // i the ELEMENT_TYPE, a the number of elements, followed by their FEED_VALUE
+        FEED_VALUE,       // i the index, a the bits of the value
+        FEED_COMPARE,     // i and a the compared indices
+        FEED_SWAP,        // i and a the swapped indices
+        FEED_WRITE,       // i the index, a the bits of the value written
+        FEED_COMPARISONS, // a the comparisons so far
+        FEED_SWAPS,       // a the swaps and writes so far
+        FEED_END          // the array is sorted
+    };
+
+    const int gFEED_VERSION = 1;
+
+    const int64_t gFEED_MAGIC = 0x3144454546565300LL; // "\0SVFEED1", also tells apart the byte orders
+
+    /*!
+     * @brief A record of the event feed, sent as is in the byte order of the server
+     */
+    typedef struct FEED_RECORD
+    {
+        uint8_t kind;        /*! A FEED_KIND */
+        uint8_t reserved[3];
+        int32_t i;
+        int64_t a;
+    } FEED_RECORD;
+
+    static_assert(sizeof(FEED_RECORD) == 16, "Feed records are 16 bytes on the wire");
+
+    /*!
+     * @brief Broadcasts the events of the sorts to the viewers connected to a socket
+     * @details The sorting thread appends records to a local batch, published into a shared
+     *          ring in one go when full. A sender thread accepts the viewers and writes the ring to
+     *          each one from its own cursor with non-blocking sockets. The sorting thread never
+     *          waits for a viewer: one that falls a whole ring behind loses its place and gets a
+     *          fresh snapshot of the array instead, like a viewer that just connected.
+     */
+    class FeedServer
+    {
+    public:
+        /*!
+         * @brief FeedServer constructor, starts listening
+         * @param address unix:PATH or tcp:PORT (bound to localhost)
+         * @throws std::runtime_error if the address can't be listened on
+         */
+        FeedServer(const std::string &address);
+
+        ~FeedServer();
+
+        /*!
+         * @brief Sets the function describing the whole state of the sort to a new viewer
+         * @details Called on the sorting thread, from flush(), so it can read the array safely.
+         */
+        void setSnapshot(std::function<void(std::vector<FEED_RECORD> &)> snapshot) { mSnapshot = snapshot; }
+
+        /*!
+         * @brief Appends a record to the batch, publishing the batch once full
+         */
+        void publish(const FEED_RECORD &record)
+        {
+            mBatch.push_back(record);
+            if (mBatch.size() == mBatch.capacity())
+                flush();
+        }
+
+        /*!
+         * @brief Publishes the batch and prepares the snapshots the new viewers are waiting for
+         */
+        void flush();
+
+        /*!
+         * @brief The number of connected viewers
+         */
+        int clients();
+
+    private:
+        struct Client;
+
+        int mListener = -1;    /*! The listening socket */
+        std::string mUnixPath; /*! The path of the Unix socket, removed on exit */
+
+        std::unique_ptr<std::atomic<int64_t>[]> mRing; /*! The records published, two words each, as a ring */
+        std::atomic<uint64_t> mHead = 0;     /*! The number of records ever published */
+        std::atomic<uint64_t> mReserved = 0; /*! The number of records ever written to, published or not */
+        std::vector<FEED_RECORD> mBatch;        /*! The records not published yet */
+        std::function<void(std::vector<FEED_RECORD> &)> mSnapshot;
+
+        std::mutex mClientsMutex;                     /*! Protects the list, not the clients */
+        std::vector<std::shared_ptr<Client>> mClients;
+        std::atomic<int> mPendingSnapshots = 0; /*! Non zero when a viewer may be waiting for a snapshot */
+
+        std::atomic<bool> mStop = false;
+        std::thread mSender; /*! Accepts the viewers and writes to them */
+
+        void sendLoop();
+    };
+
+    /*!
+     * @brief Receives the event feed of a FeedServer
+     */
+    class FeedClient
+    {
+    public:
+        /*!
+         * @brief FeedClient constructor, connects to the server
+         * @param address unix:PATH, tcp:PORT or tcp:HOST:PORT
+         * @throws std::runtime_error if the server can't be reached
+         */
+        FeedClient(const std::string &address);
+
+        ~FeedClient();
+
+        /*!
+         * @brief Appends the records received so far, without waiting
+         * @return false once the server closed the connection
+         */
+        bool receive(std::vector<FEED_RECORD> &records);
+
+    private:
+        int mSocket = -1;
+        std::vector<char> mPartial; /*! The bytes of an incomplete record */
+    };
+}
+
+#endif /* EventFeed_hpp */
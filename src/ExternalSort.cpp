@@ -0,0 +1,517 @@
+//
+//  ExternalSort.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <future>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "ExternalSort.hpp"
+#include "Elements.hpp"
+#include "Registry.hpp"
+
+namespace
+{
+    using namespace Visualizer;
+
+    typedef std::unique_ptr<FILE, int (*)(FILE *)> TempFile;
+
+    /*!
+     * @brief Creates a temporary file, removed when closed
+     */
+    TempFile makeTempFile()
+    {
+        FILE *file = std::tmpfile();
+        if (file == NULL)
+            throw std::runtime_error("Failed to create a temporary file for the external sort");
+        return TempFile(file, &fclose);
+    }
+
+    /*!
+     * @brief Reads count elements into the buffer on another thread
+     */
+    template <typename T>
+    std::future<size_t> readAsync(FILE *file, std::vector<T> &buffer, size_t count, std::atomic<long long> &bytes)
+    {
+        buffer.resize(count);
+        return std::async(std::launch::async, [file, &buffer, count, &bytes]() {
+            size_t read = fread(buffer.data(), sizeof(T), count, file);
+            bytes += read * sizeof(T);
+            return read;
+        });
+    }
+
+    /*!
+     * @brief Writes the buffer on another thread, which must stay untouched until the future is ready
+     */
+    template <typename T>
+    std::future<size_t> writeAsync(FILE *file, const std::vector<T> &buffer, std::atomic<long long> &bytes)
+    {
+        return std::async(std::launch::async, [file, &buffer, &bytes]() {
+            size_t written = fwrite(buffer.data(), sizeof(T), buffer.size(), file);
+            bytes += written * sizeof(T);
+            return written;
+        });
+    }
+
+    /*!
+     * @brief Waits for a transfer, adding the time spent blocked to the I/O wait
+     * @param expected The number of elements the transfer should have moved
+     */
+    void waitTransfer(std::future<size_t> &transfer, size_t expected, std::atomic<long long> &waitNs)
+    {
+        if (!transfer.valid())
+            return;
+
+        auto start = std::chrono::steady_clock::now();
+        size_t moved = transfer.get();
+        waitNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        if (moved != expected)
+            throw std::runtime_error("External sort I/O failed");
+    }
+
+    /*
+     * Reads a run block after block, the next block being read while the current one is consumed.
+     */
+    template <typename T>
+    class BlockReader
+    {
+    public:
+        BlockReader(FILE *file, long long elements, long long blockElements, std::atomic<long long> &bytes, std::atomic<long long> &waitNs)
+            : mFile(file), mRemaining(elements), mBlockElements(blockElements), mBytes(bytes), mWaitNs(waitNs)
+        {
+            prefetch();
+            advance();
+        }
+
+        bool empty() const { return mPosition >= mCurrent.size(); }
+        const T &front() const { return mCurrent[mPosition]; }
+
+        void pop()
+        {
+            if (++mPosition == mCurrent.size())
+                advance();
+        }
+
+    private:
+        FILE *mFile;
+        long long mRemaining;    /*! The elements not requested yet */
+        long long mBlockElements;
+        std::atomic<long long> &mBytes;
+        std::atomic<long long> &mWaitNs;
+        std::vector<T> mCurrent; /*! The block being consumed */
+        std::vector<T> mNext;    /*! The block being read */
+        size_t mPosition = 0;
+        std::future<size_t> mPending; /*! Declared last so a pending read ends before the buffers go away */
+
+        void prefetch()
+        {
+            size_t count = std::min(mRemaining, mBlockElements);
+            mRemaining -= count;
+            if (count > 0)
+                mPending = readAsync(mFile, mNext, count, mBytes);
+        }
+
+        void advance()
+        {
+            mCurrent.clear();
+            mPosition = 0;
+            if (!mPending.valid())
+                return;
+
+            waitTransfer(mPending, mNext.size(), mWaitNs);
+            std::swap(mCurrent, mNext);
+            prefetch();
+        }
+    };
+
+    /*
+     * Buffers the merged elements, writing a full block while the next one fills up.
+     */
+    template <typename T>
+    class BlockWriter
+    {
+    public:
+        BlockWriter(FILE *file, long long blockElements, std::atomic<long long> &bytes, std::atomic<long long> &waitNs)
+            : mFile(file), mBlockElements(blockElements), mBytes(bytes), mWaitNs(waitNs)
+        {
+            mCurrent.reserve(blockElements);
+        }
+
+        void push(const T &value)
+        {
+            mCurrent.push_back(value);
+            if ((long long)mCurrent.size() == mBlockElements)
+                flush();
+        }
+
+        /*!
+         * @brief Writes what is left and waits for every write to complete
+         */
+        void finish()
+        {
+            flush();
+            waitTransfer(mPending, mWriting.size(), mWaitNs);
+            fflush(mFile);
+        }
+
+    private:
+        FILE *mFile;
+        long long mBlockElements;
+        std::atomic<long long> &mBytes;
+        std::atomic<long long> &mWaitNs;
+        std::vector<T> mCurrent; /*! The block being filled */
+        std::vector<T> mWriting; /*! The block being written */
+        std::future<size_t> mPending;
+
+        void flush()
+        {
+            if (mCurrent.empty())
+                return;
+
+            waitTransfer(mPending, mWriting.size(), mWaitNs);
+            std::swap(mCurrent, mWriting);
+            mCurrent.clear();
+            mPending = writeAsync(mFile, mWriting, mBytes);
+        }
+    };
+
+    /*
+     * Tournament tree over the heads of the runs. Every internal node keeps the loser of the match
+     * played there, so replacing the winner only replays the matches on its path to the root:
+     * log2(k) comparisons per element instead of the 2 log2(k) of a binary heap.
+     */
+    template <typename T, typename Compare>
+    class LoserTree
+    {
+    public:
+        LoserTree(const std::vector<std::unique_ptr<BlockReader<T>>> &sources, Compare less)
+            : mSources(sources), mLess(less), mTree(sources.size())
+        {
+            int k = sources.size();
+            std::vector<int> winners(2 * k);
+
+            // The leaves are the nodes k..2k-1, the matches are played bottom-up
+            for (int i = 0; i < k; i++)
+                winners[k + i] = i;
+            for (int node = k - 1; node >= 1; node--) {
+                int left = winners[2 * node];
+                int right = winners[2 * node + 1];
+                bool leftWins = beats(left, right);
+                winners[node] = leftWins ? left : right;
+                mTree[node] = leftWins ? right : left;
+            }
+
+            if (k > 0)
+                mTree[0] = winners[1];
+        }
+
+        /*!
+         * @brief The run holding the smallest head, -1 once every run is exhausted
+         */
+        int winner() const
+        {
+            if (mTree.empty() || mSources[mTree[0]]->empty())
+                return -1;
+            return mTree[0];
+        }
+
+        /*!
+         * @brief Replays the matches of a run after its head was popped
+         */
+        void replay(int source)
+        {
+            int winner = source;
+            for (int node = (source + (int)mTree.size()) / 2; node >= 1; node /= 2)
+                if (beats(mTree[node], winner))
+                    std::swap(mTree[node], winner);
+            mTree[0] = winner;
+        }
+
+    private:
+        const std::vector<std::unique_ptr<BlockReader<T>>> &mSources;
+        Compare mLess;
+        std::vector<int> mTree; /*! mTree[0] is the winner, the others the losers of each match */
+
+        // Exhausted runs lose every match, ties go to the earlier run so the merge is stable
+        bool beats(int a, int b) const
+        {
+            if (mSources[a]->empty())
+                return false;
+            if (mSources[b]->empty())
+                return true;
+            if (mLess(mSources[b]->front(), mSources[a]->front()))
+                return false;
+            return mLess(mSources[a]->front(), mSources[b]->front()) || a < b;
+        }
+    };
+}
+
+Visualizer::ExternalSort::ExternalSort(const EXTERNAL_SORT_CONFIG &config)
+    : mConfig(config)
+{
+}
+
+Visualizer::EXTERNAL_SORT_STATUS Visualizer::ExternalSort::status() const
+{
+    std::lock_guard<std::mutex> lock(mStatusMutex);
+    EXTERNAL_SORT_STATUS status = mStatus;
+
+    status.stats.bytesRead = mBytesRead;
+    status.stats.bytesWritten = mBytesWritten;
+    status.stats.ioWaitMs = mIoWaitNs / 1e6;
+    return status;
+}
+
+template <typename T>
+Visualizer::EXTERNAL_SORT_STATS Visualizer::ExternalSort::sort(FILE *input, FILE *output)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    EXTERNAL_SORT_STATS stats;
+    mCancel = false;
+    mBytesRead = 0;
+    mBytesWritten = 0;
+    mIoWaitNs = 0;
+
+    fseek(input, 0, SEEK_END);
+    stats.elements = ftell(input) / (long long)sizeof(T);
+    rewind(input);
+
+    // Three chunks fit in memory: one being read, one being sorted and one being written
+    long long memoryElements = std::max<long long>(mConfig.memoryBytes / (long long)sizeof(T), 3);
+    long long chunkElements = std::min<long long>(memoryElements / 3, INT_MAX / 2);
+    long long blockElements = std::max<long long>(mConfig.blockBytes / (long long)sizeof(T), 1);
+
+    {
+        std::lock_guard<std::mutex> lock(mStatusMutex);
+        mStatus = EXTERNAL_SORT_STATUS();
+        mStatus.phase = EXTERNAL_RUNS;
+        mStatus.expectedRuns = (stats.elements + chunkElements - 1) / chunkElements;
+        mStatus.stats.elements = stats.elements;
+    }
+
+    // First phase: sort the chunks into runs, reading the next one and writing the previous one meanwhile
+    auto start = Clock::now();
+    std::vector<TempFile> runs;
+    std::vector<long long> lengths;
+    {
+        std::vector<T> buffers[3];
+        std::future<size_t> reading;
+        std::future<size_t> writing;
+        long long remaining = stats.elements;
+
+        auto readChunk = [&](std::vector<T> &buffer) {
+            size_t count = std::min(remaining, chunkElements);
+            remaining -= count;
+            buffer.clear();
+            if (count > 0)
+                reading = readAsync(input, buffer, count, mBytesRead);
+        };
+
+        readChunk(buffers[0]);
+        for (int i = 0; reading.valid() && !mCancel; i++) {
+            std::vector<T> &chunk = buffers[i % 3];
+            std::vector<T> &previous = buffers[(i + 2) % 3];
+
+            waitTransfer(reading, chunk.size(), mIoWaitNs);
+            readChunk(buffers[(i + 1) % 3]);
+
+            {
+                ElementArray array(std::move(chunk));
+                SortGenerator sorting = Registry::instance()[mConfig.runSort].factory(array);
+                while (sorting.next() && !mCancel)
+                    ;
+                sorting.reset();
+                chunk = std::move(std::get<std::vector<T>>(array));
+            }
+
+            waitTransfer(writing, previous.size(), mIoWaitNs);
+            runs.push_back(makeTempFile());
+            lengths.push_back(chunk.size());
+            writing = writeAsync(runs.back().get(), chunk, mBytesWritten);
+
+            std::lock_guard<std::mutex> lock(mStatusMutex);
+            mStatus.runLengths = lengths;
+            mStatus.outputWritten += chunk.size();
+        }
+
+        // The buffers must outlive the transfers
+        if (reading.valid())
+            reading.wait();
+        waitTransfer(writing, lengths.empty() ? 0 : lengths.back(), mIoWaitNs);
+    }
+    stats.runs = runs.size();
+    {
+        std::lock_guard<std::mutex> lock(mStatusMutex);
+        mStatus.stats.runs = stats.runs;
+    }
+    stats.runPhaseMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Second phase: merge as many runs at a time as there are double buffered blocks in memory
+    start = Clock::now();
+    long long fanIn = std::max<long long>(memoryElements / (2 * blockElements) - 1, 2);
+
+    while (!mCancel && !runs.empty()) {
+        stats.mergePasses++;
+        {
+            std::lock_guard<std::mutex> lock(mStatusMutex);
+            mStatus.stats.mergePasses = stats.mergePasses;
+        }
+        bool lastPass = (long long)runs.size() <= fanIn;
+
+        std::vector<TempFile> merged;
+        std::vector<long long> mergedLengths;
+
+        for (size_t first = 0; first < runs.size() && !mCancel; first += fanIn) {
+            size_t last = std::min(runs.size(), (size_t)(first + fanIn));
+            std::vector<FILE *> group;
+            std::vector<long long> groupLengths;
+            for (size_t i = first; i < last; i++) {
+                rewind(runs[i].get());
+                group.push_back(runs[i].get());
+                groupLengths.push_back(lengths[i]);
+            }
+
+            // With few runs each one gets bigger blocks
+            long long runBlock = std::max(blockElements, memoryElements / (2 * ((long long)group.size() + 1)));
+
+            if (lastPass)
+                mergeRuns<T>(group, groupLengths, output, runBlock);
+            else {
+                merged.push_back(makeTempFile());
+                mergeRuns<T>(group, groupLengths, merged.back().get(), runBlock);
+                long long length = 0;
+                for (long long groupLength : groupLengths)
+                    length += groupLength;
+                mergedLengths.push_back(length);
+            }
+        }
+
+        if (lastPass)
+            break;
+        runs = std::move(merged);
+        lengths = std::move(mergedLengths);
+    }
+    stats.mergePhaseMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    stats.bytesRead = mBytesRead;
+    stats.bytesWritten = mBytesWritten;
+    stats.ioWaitMs = mIoWaitNs / 1e6;
+    stats.cancelled = mCancel;
+
+    std::lock_guard<std::mutex> lock(mStatusMutex);
+    mStatus.phase = EXTERNAL_DONE;
+    mStatus.stats = stats;
+    return stats;
+}
+
+template <typename T>
+void Visualizer::ExternalSort::mergeRuns(const std::vector<FILE *> &runs, const std::vector<long long> &lengths, FILE *output, long long blockElements)
+{
+    std::vector<std::unique_ptr<BlockReader<T>>> readers;
+    for (size_t i = 0; i < runs.size(); i++)
+        readers.push_back(std::make_unique<BlockReader<T>>(runs[i], lengths[i], blockElements, mBytesRead, mIoWaitNs));
+
+    BlockWriter<T> writer(output, blockElements, mBytesWritten, mIoWaitNs);
+    LoserTree<T, TotalLess<T>> tree(readers, TotalLess<T>());
+
+    std::vector<long long> consumed(runs.size(), 0);
+    long long written = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mStatusMutex);
+        mStatus.phase = EXTERNAL_MERGE;
+        mStatus.runLengths = lengths;
+        mStatus.runConsumed = consumed;
+        mStatus.outputWritten = 0;
+    }
+
+    for (int winner = tree.winner(); winner >= 0; winner = tree.winner()) {
+        writer.push(readers[winner]->front());
+        readers[winner]->pop();
+        tree.replay(winner);
+
+        consumed[winner]++;
+        written++;
+
+        // The progress is published once per block
+        if (written % blockElements == 0) {
+            if (mCancel)
+                break;
+
+            std::lock_guard<std::mutex> lock(mStatusMutex);
+            mStatus.runConsumed = consumed;
+            mStatus.outputWritten = written;
+        }
+    }
+    writer.finish();
+
+    std::lock_guard<std::mutex> lock(mStatusMutex);
+    mStatus.runConsumed = consumed;
+    mStatus.outputWritten = written;
+}
+
+template <typename T>
+void Visualizer::ExternalSort::writeRandomElements(FILE *file, long long elements, unsigned seed)
+{
+    std::mt19937_64 generator(seed);
+    std::vector<T> block;
+
+    while (elements > 0) {
+        block.resize(std::min<long long>(elements, 1 << 16));
+        for (T &value : block) {
+            if constexpr (std::is_floating_point<T>::value)
+                value = std::uniform_real_distribution<T>(-1, 1)(generator);
+            else
+                value = std::uniform_int_distribution<T>(std::numeric_limits<T>::min(), std::numeric_limits<T>::max())(generator);
+        }
+
+        if (fwrite(block.data(), sizeof(T), block.size(), file) != block.size())
+            throw std::runtime_error("Failed to write the input of the external sort");
+        elements -= block.size();
+    }
+
+    fflush(file);
+}
+
+template <typename T>
+bool Visualizer::ExternalSort::verifySorted(FILE *file, long long elements)
+{
+    std::vector<T> block(1 << 16);
+    TotalLess<T> less;
+    long long count = 0;
+    bool sorted = true;
+    T last{};
+
+    rewind(file);
+    for (size_t read; (read = fread(block.data(), sizeof(T), block.size(), file)) > 0; count += read) {
+        if (count > 0 && less(block[0], last))
+            sorted = false;
+        sorted = sorted && std::is_sorted(block.begin(), block.begin() + read, less);
+        last = block[read - 1];
+    }
+
+    return sorted && count == elements;
+}
+
+// The sort is instantiated for every ELEMENT_TYPE
+#define INSTANTIATE_EXTERNAL_SORT(T) \
+    template Visualizer::EXTERNAL_SORT_STATS Visualizer::ExternalSort::sort<T>(FILE *, FILE *); \
+    template void Visualizer::ExternalSort::writeRandomElements<T>(FILE *, long long, unsigned); \
+    template bool Visualizer::ExternalSort::verifySorted<T>(FILE *, long long);
+
+INSTANTIATE_EXTERNAL_SORT(int32_t)
+INSTANTIATE_EXTERNAL_SORT(int64_t)
+INSTANTIATE_EXTERNAL_SORT(uint64_t)
+INSTANTIATE_EXTERNAL_SORT(float)
+INSTANTIATE_EXTERNAL_SORT(double)
@@ -0,0 +1,138 @@
+//
+//  ExternalSort.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef ExternalSort_hpp
+#define ExternalSort_hpp
+
+#include <cstdio>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#include "Utilities.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Enum that represents the phases of an external sort
+     */
+    enum EXTERNAL_PHASE
+    {
+        EXTERNAL_IDLE,
+        EXTERNAL_RUNS,  // Sorting memory sized chunks into runs
+        EXTERNAL_MERGE, // Merging the runs
+        EXTERNAL_DONE
+    };
+
+    /*!
+     * @brief The options of an external sort
+     */
+    typedef struct EXTERNAL_SORT_CONFIG
+    {
+        long long memoryBytes = 64LL << 20; /*! The memory the sort may use for elements and buffers */
+        long long blockBytes = 64LL << 10;  /*! The smallest read or write issued to the files */
+        int runSort = QUICK_SORT;           /*! The algorithm sorting the chunks (its index in the Registry) */
+    } EXTERNAL_SORT_CONFIG;
+
+    /*!
+     * @brief The statistics of an external sort
+     */
+    typedef struct EXTERNAL_SORT_STATS
+    {
+        long long elements = 0;     /*! The number of elements sorted */
+        int runs = 0;               /*! The number of runs written by the first phase */
+        int mergePasses = 0;        /*! The number of merge passes over the data */
+        long long bytesRead = 0;    /*! The bytes read from the input and the run files */
+        long long bytesWritten = 0; /*! The bytes written to the run files and the output */
+        double ioWaitMs = 0.0;      /*! The time spent waiting for reads and writes to complete */
+        double runPhaseMs = 0.0;    /*! The time spent creating the runs */
+        double mergePhaseMs = 0.0;  /*! The time spent merging the runs */
+        bool cancelled = false;     /*! Whether the sort was cancelled */
+    } EXTERNAL_SORT_STATS;
+
+    /*!
+     * @brief A snapshot of a running external sort, used to draw it
+     */
+    typedef struct EXTERNAL_SORT_STATUS
+    {
+        EXTERNAL_PHASE phase = EXTERNAL_IDLE;
+        int expectedRuns = 0;               /*! The number of runs the first phase will write */
+        std::vector<long long> runLengths;  /*! The runs written so far, or merged by the current pass */
+        std::vector<long long> runConsumed; /*! How much of each run the current merge pass has consumed */
+        long long outputWritten = 0;        /*! The elements written by the current pass */
+        EXTERNAL_SORT_STATS stats;
+    } EXTERNAL_SORT_STATUS;
+
+    /*!
+     * @brief Sorts files larger than the memory budget
+     * @details Memory sized chunks of the input are sorted with an algorithm of the Registry and
+     *          written to temporary run files, which are then k-way merged through a loser tree.
+     *          Every file is read and written in blocks with double buffering, the next block
+     *          being transferred asynchronously while the current one is consumed. When there are
+     *          more runs than buffers fitting in memory the merge takes several passes.
+     */
+    class ExternalSort
+    {
+    public:
+        /*!
+         * @brief ExternalSort constructor
+         * @param config The options of the sort
+         */
+        ExternalSort(const EXTERNAL_SORT_CONFIG &config);
+
+        /*!
+         * @brief Sorts the elements of the input file into the output file
+         * @details Both files hold raw elements of type T, the input is read from its start.
+         *          Can be called from any thread, status() and cancel() can be used meanwhile.
+         */
+        template <typename T>
+        EXTERNAL_SORT_STATS sort(FILE *input, FILE *output);
+
+        /*!
+         * @brief Returns a copy of the progress of the sort
+         */
+        EXTERNAL_SORT_STATUS status() const;
+
+        /*!
+         * @brief Asks the sort to stop as soon as possible
+         */
+        void cancel() { mCancel = true; }
+
+        /*!
+         * @brief Writes random elements to a file, used to create inputs larger than memory
+         */
+        template <typename T>
+        static void writeRandomElements(FILE *file, long long elements, unsigned seed);
+
+        /*!
+         * @brief Checks that a file holds the given number of elements in order
+         */
+        template <typename T>
+        static bool verifySorted(FILE *file, long long elements);
+
+    private:
+        EXTERNAL_SORT_CONFIG mConfig;          /*! The options of the sort */
+        mutable std::mutex mStatusMutex;       /*! Protects mStatus */
+        EXTERNAL_SORT_STATUS mStatus;          /*! The progress of the sort */
+        std::atomic<bool> mCancel = false;     /*! Whether the sort was cancelled */
+        std::atomic<long long> mBytesRead = 0;    /*! Updated by the reading threads */
+        std::atomic<long long> mBytesWritten = 0; /*! Updated by the writing threads */
+        std::atomic<long long> mIoWaitNs = 0;     /*! The time the sort waited for the transfers */
+
+        /*!
+         * @brief Merges sorted runs into a file through a loser tree
+         * @param runs The run files
+         * @param lengths The number of elements of each run
+         * @param output The file receiving the merged elements
+         * @param blockElements The number of elements of each read and write buffer
+         */
+        template <typename T>
+        void mergeRuns(const std::vector<FILE *> &runs, const std::vector<long long> &lengths, FILE *output, long long blockElements);
+    };
+}
+
+#endif /* ExternalSort_hpp */
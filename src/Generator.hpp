@@ -0,0 +1,241 @@
+//
+//  Generator.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Generator_hpp
+#define Generator_hpp
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <memory>
+
+#include "MemoryTracker.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Allocator of the coroutine frames
+     * @details Frames are rounded up to 64 byte classes and recycled through per thread free
+     *          lists, so once the deepest recursion of an algorithm has been reached stepping
+     *          and recursing never touch the heap again. The memory is kept for the lifetime
+     *          of the thread.
+     */
+    class FrameArena
+    {
+    public:
+        /*!
+         * @brief Returns a block of at least size bytes
+         */
+        static void *allocate(std::size_t size)
+        {
+            std::size_t index = classOf(size);
+            if (index >= CLASSES) {
+                sHeapAllocations++;
+                return ::operator new(size);
+            }
+
+            FreeBlock *block = sFreeLists[index];
+            if (block != nullptr) {
+                sFreeLists[index] = block->next;
+                return block;
+            }
+
+            sHeapAllocations++;
+            return ::operator new((index + 1) * CLASS_SIZE);
+        }
+
+        /*!
+         * @brief Gives back a block returned by allocate with the same size
+         */
+        static void deallocate(void *pointer, std::size_t size)
+        {
+            std::size_t index = classOf(size);
+            if (index >= CLASSES) {
+                ::operator delete(pointer);
+                return;
+            }
+
+            FreeBlock *block = static_cast<FreeBlock *>(pointer);
+            block->next = sFreeLists[index];
+            sFreeLists[index] = block;
+        }
+
+        /*!
+         * @brief The number of blocks this thread has requested from the heap so far
+         */
+        static long long heapAllocations() { return sHeapAllocations; }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        static constexpr std::size_t CLASS_SIZE = 64; /*! The granularity of the size classes */
+        static constexpr std::size_t CLASSES = 64;    /*! Frames larger than CLASSES * CLASS_SIZE go to the heap */
+
+        static std::size_t classOf(std::size_t size) { return (size + CLASS_SIZE - 1) / CLASS_SIZE - 1; }
+
+        static inline thread_local FreeBlock *sFreeLists[CLASSES] = {};
+        static inline thread_local long long sHeapAllocations = 0;
+    };
+
+    /*!
+     * @brief Lazily evaluated sequence of values produced by a coroutine
+     * @details A generator can co_yield values or another generator, whose values are then
+     *          produced in place (this is how recursive algorithms recurse). Resuming always
+     *          jumps straight to the innermost running generator.
+     */
+    template <typename T>
+    class Generator
+    {
+    public:
+        struct promise_type;
+        typedef std::coroutine_handle<promise_type> handle_type;
+
+        struct promise_type
+        {
+            const T *mValue = nullptr;     /*! The last value yielded by this coroutine */
+            promise_type *mRoot = this;    /*! The outermost generator of the chain */
+            promise_type *mParent = nullptr; /*! The generator that yielded this one */
+            promise_type *mLeaf = this;    /*! The innermost running generator (root only) */
+            int mDepth = 0;                /*! The number of generators above this one */
+
+            Generator get_return_object() noexcept { return Generator(handle_type::from_promise(*this)); }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            // Gives control back to the parent, or to the caller of next() for the root
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(handle_type handle) noexcept
+                {
+                    promise_type &promise = handle.promise();
+                    if (promise.mParent == nullptr)
+                        return std::noop_coroutine();
+
+                    promise.mRoot->mLeaf = promise.mParent;
+                    return handle_type::from_promise(*promise.mParent);
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            FinalAwaiter final_suspend() noexcept { return {}; }
+
+            std::suspend_always yield_value(const T &value) noexcept
+            {
+                mValue = std::addressof(value);
+                mRoot->mLeaf = this;
+                return {};
+            }
+
+            // Starts the nested generator right away in place of this one
+            struct NestedAwaiter
+            {
+                handle_type nested;
+
+                bool await_ready() noexcept { return !nested; }
+
+                std::coroutine_handle<> await_suspend(handle_type handle) noexcept
+                {
+                    promise_type &parent = handle.promise();
+                    promise_type &child = nested.promise();
+
+                    child.mRoot = parent.mRoot;
+                    child.mParent = &parent;
+                    child.mDepth = parent.mDepth + 1;
+                    MemoryTracker::reached(child.mDepth);
+                    parent.mRoot->mLeaf = &child;
+                    return nested;
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            NestedAwaiter yield_value(Generator &&generator) noexcept { return NestedAwaiter{generator.mHandle}; }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() { throw; }
+
+            static void *operator new(std::size_t size)
+            {
+                MemoryTracker::frameAllocated(size);
+                return FrameArena::allocate(size);
+            }
+
+            static void operator delete(void *pointer, std::size_t size)
+            {
+                MemoryTracker::frameFreed(size);
+                FrameArena::deallocate(pointer, size);
+            }
+        };
+
+        Generator() = default;
+
+        Generator(Generator &&other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+
+        Generator &operator=(Generator &&other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                mHandle = std::exchange(other.mHandle, nullptr);
+            }
+            return *this;
+        }
+
+        Generator(const Generator &) = delete;
+        Generator &operator=(const Generator &) = delete;
+
+        ~Generator() { reset(); }
+
+        /*!
+         * @brief Runs the coroutine until it yields its next value
+         * @return false once the coroutine has finished
+         */
+        bool next()
+        {
+            if (!mHandle || mHandle.done())
+                return false;
+
+            handle_type::from_promise(*mHandle.promise().mLeaf).resume();
+            return !mHandle.done();
+        }
+
+        /*!
+         * @brief The value yielded by the last call to next()
+         */
+        const T &value() const { return *mHandle.promise().mLeaf->mValue; }
+
+        /*!
+         * @brief Whether the generator holds a coroutine
+         */
+        explicit operator bool() const { return (bool)mHandle; }
+
+        /*!
+         * @brief Destroys the coroutine (and with it the nested ones still running)
+         */
+        void reset()
+        {
+            if (mHandle) {
+                mHandle.destroy();
+                mHandle = nullptr;
+            }
+        }
+
+    private:
+        explicit Generator(handle_type handle) : mHandle(handle) {}
+
+        handle_type mHandle = nullptr; /*! The coroutine owned by the generator */
+    };
+}
+
+#endif /* Generator_hpp */
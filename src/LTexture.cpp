@@ -9,6 +9,7 @@
 #include <SDL2/SDL_ttf.h>
 
 #include "LTexture.hpp"
+#include "Trace.hpp"
 
 LTexture::LTexture(SDL_Renderer *renderer)
     : renderer(renderer)
@@ -45,6 +46,8 @@ LTexture::~LTexture()
 
 bool LTexture::loadFromRenderedText(std::string textureText, SDL_Color textColor, bool wrappable, int width, const PADDING padding)
 {
+    TRACE_SPAN("LTexture::loadFromRenderedText");
+
     // Remove preexisting texture
     free();
 
@@ -0,0 +1,155 @@
+//
+//  MemoryTracker.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef MemoryTracker_hpp
+#define MemoryTracker_hpp
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <algorithm>
+
+namespace Visualizer
+{
+    /*!
+     * @brief The memory used by a sort besides the array
+     */
+    typedef struct MEMORY_STATS
+    {
+        long long currentBytes = 0;  /*! The bytes of the buffers allocated and not freed yet */
+        long long peakBytes = 0;     /*! The largest currentBytes reached */
+        long long allocations = 0;   /*! The number of buffers allocated */
+        long long stackBytes = 0;    /*! The bytes of the coroutine frames alive, the stack of the recursion */
+        long long peakStackBytes = 0; /*! The largest stackBytes reached */
+        int peakDepth = 0;           /*! The deepest nesting of the generators, the recursion depth */
+    } MEMORY_STATS;
+
+    /*!
+     * @brief Accounts for the memory allocated by the sort running on this thread
+     * @details The algorithms allocate their buffers with TrackingAllocator and the generators
+     *          report their frames and nesting, all to the tracker installed on the thread by a
+     *          Scope. Without one nothing is counted, so the accounting costs a single thread
+     *          local load when off.
+     */
+    class MemoryTracker
+    {
+    public:
+        /*!
+         * @brief Installs a tracker on the thread for its lifetime
+         */
+        class Scope
+        {
+        public:
+            Scope(MemoryTracker &tracker) : mPrevious(sCurrent) { sCurrent = &tracker; }
+            ~Scope() { sCurrent = mPrevious; }
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            MemoryTracker *mPrevious; /*! The tracker installed before, restored on exit */
+        };
+
+        /*!
+         * @brief The tracker installed on this thread, NULL if none
+         */
+        static MemoryTracker *current() { return sCurrent; }
+
+        /*!
+         * @brief Forgets everything counted so far
+         */
+        void reset() { mStats = MEMORY_STATS(); }
+
+        const MEMORY_STATS &stats() const { return mStats; }
+
+        /*!
+         * @brief Counts a buffer allocated or freed on this thread
+         */
+        static void bufferAllocated(std::size_t bytes)
+        {
+            if (sCurrent == nullptr)
+                return;
+            sCurrent->mStats.allocations++;
+            sCurrent->mStats.currentBytes += bytes;
+            sCurrent->mStats.peakBytes = std::max(sCurrent->mStats.peakBytes, sCurrent->mStats.currentBytes);
+        }
+
+        static void bufferFreed(std::size_t bytes)
+        {
+            if (sCurrent != nullptr)
+                sCurrent->mStats.currentBytes -= bytes;
+        }
+
+        /*!
+         * @brief Counts a coroutine frame allocated or freed on this thread
+         */
+        static void frameAllocated(std::size_t bytes)
+        {
+            if (sCurrent == nullptr)
+                return;
+            sCurrent->mStats.stackBytes += bytes;
+            sCurrent->mStats.peakStackBytes = std::max(sCurrent->mStats.peakStackBytes, sCurrent->mStats.stackBytes);
+        }
+
+        static void frameFreed(std::size_t bytes)
+        {
+            if (sCurrent != nullptr)
+                sCurrent->mStats.stackBytes -= bytes;
+        }
+
+        /*!
+         * @brief Counts a generator started depth levels below the root
+         */
+        static void reached(int depth)
+        {
+            if (sCurrent != nullptr)
+                sCurrent->mStats.peakDepth = std::max(sCurrent->mStats.peakDepth, depth);
+        }
+
+    private:
+        MEMORY_STATS mStats; /*! The memory counted so far */
+
+        static inline thread_local MemoryTracker *sCurrent = nullptr;
+    };
+
+    /*!
+     * @brief Standard allocator reporting to the tracker of the thread
+     */
+    template <typename T>
+    struct TrackingAllocator
+    {
+        typedef T value_type;
+
+        TrackingAllocator() = default;
+
+        template <typename U>
+        TrackingAllocator(const TrackingAllocator<U> &) {}
+
+        T *allocate(std::size_t n)
+        {
+            MemoryTracker::bufferAllocated(n * sizeof(T));
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *pointer, std::size_t n)
+        {
+            MemoryTracker::bufferFreed(n * sizeof(T));
+            ::operator delete(pointer);
+        }
+
+        template <typename U>
+        bool operator==(const TrackingAllocator<U> &) const { return true; }
+    };
+
+    /*!
+     * @brief The buffers of the algorithms
+     */
+    template <typename T>
+    using TrackedVector = std::vector<T, TrackingAllocator<T>>;
+}
+
+#endif /* MemoryTracker_hpp */
@@ -0,0 +1,64 @@
+//
+//  PerfCounter.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include "PerfCounter.hpp"
+
+#ifdef __linux__
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+Visualizer::PerfCounter::PerfCounter()
+{
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // This thread on any CPU, there is no glibc wrapper
+    mFd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+Visualizer::PerfCounter::~PerfCounter()
+{
+#ifdef __linux__
+    if (mFd >= 0)
+        close(mFd);
+#endif
+}
+
+void Visualizer::PerfCounter::start()
+{
+#ifdef __linux__
+    if (mFd >= 0) {
+        ioctl(mFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(mFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+long long Visualizer::PerfCounter::stop()
+{
+#ifdef __linux__
+    long long count;
+    if (mFd >= 0) {
+        ioctl(mFd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(mFd, &count, sizeof(count)) == sizeof(count))
+            return count;
+    }
+#endif
+    return -1;
+}
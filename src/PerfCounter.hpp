@@ -0,0 +1,46 @@
+//
+//  PerfCounter.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef PerfCounter_hpp
+#define PerfCounter_hpp
+
+namespace Visualizer
+{
+    /*!
+     * @brief Counts the branches mispredicted by the calling thread with the hardware counters
+     * @details Uses perf_event_open on Linux, user space only. Where the counters can't be opened
+     *          (other systems, virtual machines without a PMU, a perf_event_paranoid setting
+     *          above 2) available() is false and stop() returns -1.
+     */
+    class PerfCounter
+    {
+    public:
+        PerfCounter();
+        ~PerfCounter();
+
+        PerfCounter(const PerfCounter &) = delete;
+        PerfCounter &operator=(const PerfCounter &) = delete;
+
+        bool available() const { return mFd >= 0; }
+
+        /*!
+         * @brief Resets the count and starts counting
+         */
+        void start();
+
+        /*!
+         * @brief Stops counting
+         * @return The branches mispredicted since start(), -1 if the counter is not available
+         */
+        long long stop();
+
+    private:
+        int mFd = -1; /*! The perf event, -1 if it couldn't be opened */
+    };
+}
+
+#endif /* PerfCounter_hpp */
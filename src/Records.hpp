@@ -0,0 +1,112 @@
+//
+//  Records.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Records_hpp
+#define Records_hpp
+
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstring>
+
+namespace Visualizer
+{
+    /*!
+     * @brief A key with a payload moved along with it
+     * @details The first 8 bytes of the payload repeat the key, so a payload that got separated
+     *          from its key is noticed.
+     */
+    template <int PAYLOAD>
+    struct RECORD
+    {
+        int64_t key;
+        unsigned char payload[PAYLOAD];
+
+        bool operator<(const RECORD &other) const { return key < other.key; }
+    };
+
+    /*!
+     * @brief A key with the index of its record, what the struct of arrays layout sorts
+     */
+    typedef struct KEY_INDEX
+    {
+        int64_t key;
+        int32_t index;
+
+        bool operator<(const KEY_INDEX &other) const { return key < other.key; }
+    } KEY_INDEX;
+
+    /*!
+     * @brief The record arrays the algorithms run on, one alternative for each payload size
+     *        and the key index pairs
+     */
+    typedef std::variant<std::vector<RECORD<16>>,
+                         std::vector<RECORD<32>>,
+                         std::vector<RECORD<64>>,
+                         std::vector<RECORD<128>>,
+                         std::vector<RECORD<256>>,
+                         std::vector<KEY_INDEX>> RecordArray;
+
+    /*!
+     * @brief The payload sizes of the RecordArray alternatives, in order
+     */
+    const int gRECORD_PAYLOADS[] = {16, 32, 64, 128, 256};
+
+    const int gRECORD_PAYLOADS_COUNT = 5;
+
+    /*!
+     * @brief Fills the record with the key, and the payload with the key followed by filler bytes
+     */
+    template <int PAYLOAD>
+    void fillRecord(RECORD<PAYLOAD> &record, int64_t key)
+    {
+        record.key = key;
+        std::memset(record.payload, (int)(key & 0xFF), PAYLOAD);
+        std::memcpy(record.payload, &key, sizeof(key));
+    }
+
+    /*!
+     * @brief Whether the payload still belongs to the key of the record
+     */
+    template <int PAYLOAD>
+    bool recordIntact(const RECORD<PAYLOAD> &record)
+    {
+        int64_t key;
+        std::memcpy(&key, record.payload, sizeof(key));
+        return key == record.key;
+    }
+
+    /*!
+     * @brief Creates an empty array of records with the given payload, one of gRECORD_PAYLOADS
+     */
+    inline RecordArray makeRecordArray(int payload)
+    {
+        RecordArray array;
+
+        switch (payload) {
+            case 16:
+                array.emplace<0>();
+                break;
+            case 32:
+                array.emplace<1>();
+                break;
+            case 64:
+                array.emplace<2>();
+                break;
+            case 128:
+                array.emplace<3>();
+                break;
+            default:
+                array.emplace<4>();
+                break;
+        }
+
+        return array;
+    }
+}
+
+#endif /* Records_hpp */
@@ -0,0 +1,404 @@
+//
+//  Registry.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <cstdio>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <algorithm>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+#include "Registry.hpp"
+#include "SortPlugin.h"
+
+namespace
+{
+    using namespace Visualizer;
+
+    // The time the plugin that last finished on this thread spent sorting through the callbacks
+    thread_local double gPluginSortMs = 0.0;
+
+    // The operations a plugin hands over at a time
+    const size_t gPLUGIN_BATCH = 256;
+
+    // The batches a plugin can get ahead of its generator before it waits
+    const size_t gPLUGIN_BATCHES = 16;
+
+    /*
+     * A plugin runs in one go, so it sorts a copy of the array on a thread of its own while the
+     * callbacks stream its operations, in batches through a bounded queue, to the generator
+     * that replays them on the real array. The plugin waits whenever it gets too far ahead, so
+     * the memory of the stream doesn't grow with the sort and the first operations are shown
+     * right away. The copy and the queue are the cost of running a plugin, not of its algorithm,
+     * so they aren't tracked: the memory of a plugin is the scratch slots it asks for.
+     */
+    template <typename T, typename Compare>
+    class PluginStream
+    {
+    public:
+        PluginStream(const sv_plugin *plugin, const std::vector<T> &array, size_t scratch, Compare less)
+            : mElements(array.begin(), array.end()), mSize(array.size()), mLess(less)
+        {
+            mElements.resize(mSize + scratch);
+            mFilling.reserve(gPLUGIN_BATCH);
+            mWorker = std::thread([this, plugin] { run(plugin); });
+        }
+
+        /*!
+         * @brief Stops streaming and waits for the plugin to return
+         * @details A plugin can't be interrupted, but once cancelled every comparison answers
+         *          "not less" and nothing moves, so the copy looks sorted and it returns quickly.
+         */
+        ~PluginStream()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                mCancelled = true;
+            }
+            mChanged.notify_all();
+            if (mWorker.joinable())
+                mWorker.join();
+        }
+
+        /*!
+         * @brief Takes the next batch of operations, waiting for the plugin if none is ready
+         * @return false once the plugin has finished and every batch was taken
+         */
+        bool next(std::vector<SORT_OP> &batch)
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mChanged.wait(lock, [this] { return !mQueue.empty() || mDone; });
+            if (mQueue.empty())
+                return false;
+
+            batch = std::move(mQueue.front());
+            mQueue.pop_front();
+            lock.unlock();
+            mChanged.notify_all();
+            return true;
+        }
+
+        /*!
+         * @brief Waits for the plugin to finish, only called once next returned false
+         * @return The time it spent sorting, without the waits for the generator
+         */
+        double finish()
+        {
+            if (mWorker.joinable())
+                mWorker.join();
+            return mSortMs;
+        }
+
+        /*!
+         * @brief Whether the plugin used an index out of range, its operations stop there
+         */
+        bool faulted() const { return mFaulted; }
+
+    private:
+        std::vector<T> mElements;    /*! The copy of the array followed by the scratch slots */
+        size_t mSize;                /*! The number of elements */
+        Compare mLess;               /*! The ordering of the elements */
+        bool mFaulted = false;       /*! Whether the plugin used an index out of range */
+
+        std::thread mWorker;         /*! Runs the plugin */
+        std::mutex mLock;            /*! Guards the queue and the flags */
+        std::condition_variable mChanged; /*! Signalled when a batch is queued or taken, or the stream ends */
+        std::deque<std::vector<SORT_OP>> mQueue; /*! The batches not taken yet */
+        std::vector<SORT_OP> mFilling; /*! The batch the callbacks append to, only used by the worker */
+        bool mDone = false;          /*! Whether the plugin has finished */
+        std::atomic<bool> mCancelled = false; /*! Whether the generator was destroyed before the end */
+        double mWaitedMs = 0.0;      /*! The time the plugin waited for room in the queue */
+        double mSortMs = 0.0;        /*! The time the plugin took, without the waits */
+
+        void run(const sv_plugin *plugin)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            sv_array array = {this, mSize, mElements.size() - mSize, &PluginStream::less, &PluginStream::swap, &PluginStream::move};
+            plugin->sort(&array);
+            if (!mFilling.empty())
+                flush();
+            auto end = std::chrono::high_resolution_clock::now();
+            mSortMs = std::chrono::duration<double, std::milli>(end - start).count() - mWaitedMs;
+
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                mDone = true;
+            }
+            mChanged.notify_all();
+        }
+
+        // Queues the batch being filled, waiting while the queue is full
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            if (mQueue.size() >= gPLUGIN_BATCHES && !mCancelled) {
+                auto start = std::chrono::high_resolution_clock::now();
+                mChanged.wait(lock, [this] { return mQueue.size() < gPLUGIN_BATCHES || mCancelled; });
+                mWaitedMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            }
+            if (!mCancelled)
+                mQueue.push_back(std::move(mFilling));
+            lock.unlock();
+            mChanged.notify_all();
+
+            mFilling.clear();
+            mFilling.reserve(gPLUGIN_BATCH);
+        }
+
+        void stream(const SORT_OP &op)
+        {
+            if (mFaulted)
+                return;
+            mFilling.push_back(op);
+            if (mFilling.size() == gPLUGIN_BATCH)
+                flush();
+        }
+
+        bool valid(size_t i, size_t j)
+        {
+            if (mCancelled.load(std::memory_order_relaxed))
+                return false;
+            if (i < mElements.size() && j < mElements.size())
+                return true;
+            mFaulted = true;
+            return false;
+        }
+
+        static int less(void *context, size_t i, size_t j)
+        {
+            PluginStream *self = static_cast<PluginStream *>(context);
+            if (!self->valid(i, j)) return 0;
+
+            self->stream(SORT_OP{COMPARE_OP, (int)i, (int)j});
+            return self->mLess(self->mElements[i], self->mElements[j]);
+        }
+
+        static void swap(void *context, size_t i, size_t j)
+        {
+            PluginStream *self = static_cast<PluginStream *>(context);
+            if (!self->valid(i, j)) return;
+
+            self->stream(SORT_OP{SWAP_OP, (int)i, (int)j});
+            std::swap(self->mElements[i], self->mElements[j]);
+        }
+
+        static void move(void *context, size_t to, size_t from)
+        {
+            PluginStream *self = static_cast<PluginStream *>(context);
+            if (!self->valid(to, from)) return;
+
+            self->stream(SORT_OP{WRITE_OP, (int)to, (int)from});
+            self->mElements[to] = self->mElements[from];
+        }
+    };
+
+    // Sorts the array with a plugin, yielding its operations on the array like a built-in algorithm
+    template <typename T, typename Compare>
+    SortGenerator pluginSort(const sv_plugin *plugin, std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+        size_t scratchSize = plugin->scratch_size != NULL ? plugin->scratch_size(n) : 0;
+
+        std::unique_ptr<PluginStream<T, Compare>> stream = std::make_unique<PluginStream<T, Compare>>(plugin, array, scratchSize, less);
+        TrackedVector<T> scratch(scratchSize);
+        auto at = [&](int i) -> T & { return i < n ? array[i] : scratch[i - n]; };
+
+        // Operations on the scratch slots are replayed but only the ones touching the array are yielded
+        std::vector<SORT_OP> batch;
+        while (stream->next(batch)) {
+            for (const SORT_OP &op : batch) {
+                switch (op.type) {
+                    case COMPARE_OP:
+                        co_yield SORT_OP{COMPARE_OP, op.i < n ? op.i : -1, op.j < n ? op.j : -1};
+                        break;
+                    case SWAP_OP:
+                        std::swap(at(op.i), at(op.j));
+                        if (op.i < n && op.j < n)
+                            co_yield op;
+                        else if (op.i < n)
+                            co_yield SORT_OP{WRITE_OP, op.i, -1};
+                        else if (op.j < n)
+                            co_yield SORT_OP{WRITE_OP, op.j, -1};
+                        break;
+                    case WRITE_OP:
+                        at(op.i) = at(op.j);
+                        if (op.i < n)
+                            co_yield SORT_OP{WRITE_OP, op.i, op.j < n ? op.j : -1};
+                        else if (op.j < n)
+                            co_yield SORT_OP{READ_OP, op.j, -1};
+                        break;
+                    case READ_OP:
+                        break;
+                }
+            }
+        }
+
+        gPluginSortMs = stream->finish();
+        if (stream->faulted())
+            printf("Plugin %s addressed an element out of range, its sort was stopped there\n", plugin->name);
+    }
+}
+
+Visualizer::Registry &Visualizer::Registry::instance()
+{
+    static Registry registry;
+    return registry;
+}
+
+Visualizer::Registry::Registry()
+{
+    // Built-in algorithms, in SORT_IDENTIFIER order
+    add({"Bubble Sort", "bubble", SDLK_b, makeFactory([](auto &array, auto less) { return bubbleSort(array, less); }), false});
+    add({"Quick Sort", "quick", SDLK_q, makeFactory([](auto &array, auto less) { return quickSort(array, 0, (int)array.size() - 1, less, instance().networkCutoff()); }), false, true});
+    add({"Cocktail Sort", "cocktail", SDLK_c, makeFactory([](auto &array, auto less) { return cocktailSort(array, less); }), false});
+    add({"Shell Sort", "shell", SDLK_e, makeFactory([](auto &array, auto less) { return shellSort(array, less, instance().gapSequence()); }), false, false, true});
+    add({"Heap Sort", "heap", SDLK_h, makeFactory([](auto &array, auto less) { return heapSort(array, less); }), false});
+    add({"Merge Sort", "merge", SDLK_m, makeFactory([](auto &array, auto less) { return mergeSort(array, 0, (int)array.size() - 1, less, instance().networkCutoff()); }), false, true});
+    add({"Selection Sort", "selection", SDLK_l, makeFactory([](auto &array, auto less) { return selectionSort(array, less); }), false});
+    add({"Insertion Sort", "insertion", SDLK_i, makeFactory([](auto &array, auto less) { return insertionSort(array, less); }), false});
+    add({"Gnome Sort", "gnome", SDLK_g, makeFactory([](auto &array, auto less) { return gnomeSort(array, less); }), false});
+    add({"Sorting Network", "network", SDLK_w, makeFactory([](auto &array, auto less) { return sortingNetwork(array, less); }), false});
+    add({"Block Merge Sort", "block", SDLK_v, makeFactory([](auto &array, auto less) { return blockMergeSort(array, less); }), false});
+    add({"Bottom-Up Heap Sort", "bottomup", SDLK_u, makeFactory([](auto &array, auto less) { return bottomUpHeapSort(array, less); }), false});
+    add({"4-ary Heap Sort", "heap4", SDLK_4, makeFactory([](auto &array, auto less) { return dAryHeapSort(array, 4, less); }), false});
+    add({"8-ary Heap Sort", "heap8", SDLK_8, makeFactory([](auto &array, auto less) { return dAryHeapSort(array, 8, less); }), false});
+    add({"Pattern-Defeating Quick Sort", "pdq", SDLK_y, makeFactory([](auto &array, auto less) { return pdqSort(array, less); }), false});
+    add({"Introselect", "select", SDLK_1, makeFactory([](auto &array, auto less) { return introSelect(array, instance().selectionK(), less); }), false, false, false, true});
+    add({"Heap Top-K", "topk", SDLK_2, makeFactory([](auto &array, auto less) { return heapTopK(array, instance().selectionK(), less); }), false, false, false, true});
+    add({"Partial Sort", "partial", SDLK_3, makeFactory([](auto &array, auto less) { return partialSort(array, instance().selectionK(), less); }), false, false, false, true});
+}
+
+Visualizer::Registry::~Registry()
+{
+    // The factories of the plugins point into the shared objects
+    mAlgorithms.clear();
+
+#ifndef _WIN32
+    for (void *handle : mHandles)
+        dlclose(handle);
+#endif
+}
+
+int Visualizer::Registry::add(ALGORITHM algorithm)
+{
+    if (find(algorithm.key) >= 0)
+        return -1;
+
+    // A key already selecting another algorithm or used by the controls is not bound
+    if (algorithm.hotkey != 0 && (findHotkey(algorithm.hotkey) >= 0 ||
+                                  std::find(gCONTROL_KEYS, gCONTROL_KEYS + gCONTROL_KEYS_COUNT, algorithm.hotkey) != gCONTROL_KEYS + gCONTROL_KEYS_COUNT))
+        algorithm.hotkey = 0;
+
+    mAlgorithms.push_back(algorithm);
+    return mAlgorithms.size() - 1;
+}
+
+int Visualizer::Registry::loadPlugins(const std::string &directory)
+{
+#ifdef _WIN32
+    printf("Warning: plugins are not supported on this platform!\n");
+    return 0;
+#else
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error))
+        return 0;
+
+    // Load the plugins in a stable order
+    std::vector<std::filesystem::path> paths;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+        if (entry.path().extension() == ".so")
+            paths.push_back(entry.path());
+    std::sort(paths.begin(), paths.end());
+
+    int loaded = 0;
+    for (const std::filesystem::path &path : paths) {
+        void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle == NULL) {
+            printf("Failed to load plugin %s! %s\n", path.c_str(), dlerror());
+            continue;
+        }
+
+        sv_plugin_entry entry = (sv_plugin_entry)dlsym(handle, SV_PLUGIN_ENTRY);
+        const sv_plugin *plugin = entry != NULL ? entry() : NULL;
+
+        if (plugin == NULL || plugin->abi_version != SV_PLUGIN_ABI_VERSION || plugin->sort == NULL || plugin->name == NULL || plugin->key == NULL) {
+            printf("Failed to load plugin %s! Missing or incompatible %s\n", path.c_str(), SV_PLUGIN_ENTRY);
+            dlclose(handle);
+            continue;
+        }
+
+        ALGORITHM algorithm = {
+            plugin->name,
+            plugin->key,
+            (SDL_Keycode)std::tolower((unsigned char)plugin->hotkey),
+            makeFactory([plugin](auto &array, auto less) { return pluginSort(plugin, array, less); }),
+            true
+        };
+
+        if (add(algorithm) < 0) {
+            printf("Failed to load plugin %s! The name %s is already taken\n", path.c_str(), plugin->key);
+            dlclose(handle);
+            continue;
+        }
+        if (algorithm.hotkey != 0 && mAlgorithms.back().hotkey == 0)
+            printf("Warning: the key %c of plugin %s is already taken, TAB selects it\n", (char)algorithm.hotkey, path.c_str());
+
+        mHandles.push_back(handle);
+        loaded++;
+    }
+
+    return loaded;
+#endif
+}
+
+int Visualizer::Registry::find(const std::string &key) const
+{
+    for (size_t i = 0; i < mAlgorithms.size(); i++)
+        if (mAlgorithms[i].key == key)
+            return i;
+    return -1;
+}
+
+int Visualizer::Registry::findHotkey(SDL_Keycode hotkey) const
+{
+    for (size_t i = 0; i < mAlgorithms.size(); i++)
+        if (mAlgorithms[i].hotkey != 0 && mAlgorithms[i].hotkey == hotkey)
+            return i;
+    return -1;
+}
+
+double Visualizer::Registry::sortTimeMs(int sort, std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end) const
+{
+    return mAlgorithms[sort].isPlugin ? gPluginSortMs : std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::string Visualizer::Registry::infoText() const
+{
+    std::stringstream text;
+
+    for (const ALGORITHM &algorithm : mAlgorithms) {
+        if (algorithm.hotkey == 0)
+            continue;
+
+        std::string name = algorithm.name;
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        text << " " << (char)std::toupper(algorithm.hotkey) << " - " << name << " \n";
+    }
+
+    text << " TAB - next sort \n";
+    return text.str();
+}
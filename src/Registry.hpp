@@ -0,0 +1,189 @@
+//
+//  Registry.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Registry_hpp
+#define Registry_hpp
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <algorithm>
+#include <SDL2/SDL.h>
+
+#include "Elements.hpp"
+#include "Records.hpp"
+#include "Argsort.hpp"
+#include "Sorts.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Creates the generator sorting the given array, whatever its element or record type
+     */
+    typedef struct SortFactory
+    {
+        std::function<SortGenerator(ElementArray &)> elements; /*! Sorts the arrays the window shows */
+        std::function<SortGenerator(RecordArray &)> records;   /*! Sorts records, or the keys of records with their index */
+        std::function<SortGenerator(IndexArray &, const ElementArray &)> indices; /*! Sorts the indices of the keys, the keys must outlive the generator */
+
+        SortGenerator operator()(ElementArray &array) const { return elements(array); }
+        SortGenerator operator()(RecordArray &array) const { return records(array); }
+        SortGenerator operator()(IndexArray &indices, const ElementArray &keys) const { return this->indices(indices, keys); }
+    } SortFactory;
+
+    /*!
+     * @brief A struct that represents an algorithm the engine can run
+     */
+    typedef struct ALGORITHM
+    {
+        std::string name;   /*! The name shown in the window */
+        std::string key;    /*! The name used on the command line */
+        SDL_Keycode hotkey; /*! The key selecting the algorithm in the window, 0 for none */
+        SortFactory factory; /*! Creates the generator of the algorithm */
+        bool isPlugin;      /*! Whether the algorithm was loaded from a shared object */
+        bool usesNetworkCutoff = false; /*! Whether the algorithm sorts small partitions with a network */
+        bool usesGapSequence = false;   /*! Whether the algorithm runs with the selected gap sequence */
+        bool selects = false;           /*! Whether the algorithm only puts the k smallest elements first (see selectionK) */
+    } ALGORITHM;
+
+    /*!
+     * @brief The list of the algorithms, the built-in ones first (in SORT_IDENTIFIER order) then the plugins
+     */
+    class Registry
+    {
+    public:
+        /*!
+         * @brief Returns the registry shared by the engine and the benchmark
+         */
+        static Registry &instance();
+
+        ~Registry();
+
+        /*!
+         * @brief Adds an algorithm
+         * @return The index of the algorithm, -1 if its key is already taken
+         */
+        int add(ALGORITHM algorithm);
+
+        /*!
+         * @brief Loads every plugin (.so) found in the directory
+         * @param directory The directory to scan
+         * @return The number of plugins loaded
+         */
+        int loadPlugins(const std::string &directory);
+
+        /*!
+         * @brief Finds an algorithm by its command line name
+         * @return The index of the algorithm, -1 if not found
+         */
+        int find(const std::string &key) const;
+
+        /*!
+         * @brief Finds the algorithm selected by a key
+         * @return The index of the algorithm, -1 if not found
+         */
+        int findHotkey(SDL_Keycode hotkey) const;
+
+        /*!
+         * @brief The algorithms in registration order
+         */
+        const std::vector<ALGORITHM> &algorithms() const { return mAlgorithms; }
+
+        /*!
+         * @brief The algorithm at the given index
+         */
+        const ALGORITHM &operator[](int index) const { return mAlgorithms[index]; }
+
+        /*!
+         * @brief The number of algorithms
+         */
+        int size() const { return mAlgorithms.size(); }
+
+        /*!
+         * @brief The partition size below which the recursive algorithms use a sorting network
+         */
+        int networkCutoff() const { return mNetworkCutoff; }
+
+        /*!
+         * @brief Sets the partition size below which the recursive algorithms use a sorting network
+         * @param cutoff The size, 0 to recurse down to single elements, at most gMAX_NETWORK_SIZE
+         */
+        void setNetworkCutoff(int cutoff) { mNetworkCutoff = std::max(0, std::min(cutoff, gMAX_NETWORK_SIZE)); }
+
+        /*!
+         * @brief The gap sequence of shell sort
+         */
+        GAP_SEQUENCE gapSequence() const { return mGapSequence; }
+
+        void setGapSequence(GAP_SEQUENCE sequence) { mGapSequence = sequence; }
+
+        /*!
+         * @brief The number of smallest elements the selection algorithms put first, 0 for the median
+         */
+        int selectionK() const { return mSelectionK; }
+
+        void setSelectionK(int k) { mSelectionK = std::max(0, k); }
+
+        /*!
+         * @brief The milliseconds a run of an algorithm took, from before its generator was created
+         *        to after it finished on this thread
+         * @details A plugin sorts a copy of the array in one go, through callbacks recording its
+         *          operations, and its generator then replays them. Its time is that of the sort
+         *          through the callbacks alone, the copy and the replay left out.
+         */
+        double sortTimeMs(int sort, std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end) const;
+
+        /*!
+         * @brief The lines of the info panel listing the algorithm keys
+         */
+        std::string infoText() const;
+
+        /*!
+         * @brief Wraps a generic sort (a lambda taking a std::vector<T> and a comparator) in a SortFactory
+         */
+        template <typename Sort>
+        static SortFactory makeFactory(Sort sort)
+        {
+            auto visitor = [sort](auto &array) {
+                return std::visit([&](auto &values) {
+                    typedef typename std::decay<decltype(values)>::type::value_type T;
+                    return sort(values, TotalLess<T>());
+                }, array);
+            };
+            // Bare indices gather the two keys they point to on every comparison, cached ones compare their copy
+            auto argsort = [sort](IndexArray &indices, const ElementArray &keys) {
+                return std::visit([&](auto &order) {
+                    typedef typename std::decay<decltype(order)>::type::value_type I;
+                    if constexpr (std::is_same<I, uint32_t>::value) {
+                        return std::visit([&](const auto &values) {
+                            typedef typename std::decay<decltype(values)>::type::value_type T;
+                            const T *data = values.data();
+                            return sort(order, [data](uint32_t a, uint32_t b) { return TotalLess<T>()(data[a], data[b]); });
+                        }, keys);
+                    }
+                    else {
+                        typedef decltype(I::key) T;
+                        return sort(order, [](const I &a, const I &b) { return TotalLess<T>()(a.key, b.key); });
+                    }
+                }, indices);
+            };
+            return {visitor, visitor, argsort};
+        }
+
+    private:
+        Registry();
+
+        std::vector<ALGORITHM> mAlgorithms; /*! The registered algorithms */
+        std::vector<void *> mHandles;       /*! The handles of the loaded shared objects */
+        int mNetworkCutoff = 0;             /*! Read by the factories when the sort starts */
+        GAP_SEQUENCE mGapSequence = CIURA_GAPS; /*! Read by the shell sort factory when the sort starts */
+        int mSelectionK = 10;               /*! Read by the selection factories when they start */
+    };
+}
+
+#endif /* Registry_hpp */
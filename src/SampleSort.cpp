@@ -0,0 +1,670 @@
+//
+//  SampleSort.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <new>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#endif
+
+#include "SampleSort.hpp"
+#include "Elements.hpp"
+#include "Registry.hpp"
+#include "Trace.hpp"
+
+namespace
+{
+    using namespace Visualizer;
+
+    // How long a node waits for the others to connect or to make progress before giving up
+    const int TIMEOUT_MS = 30000;
+
+    /*!
+     * @brief The counters of a node, in the shared memory so the parent reads them while it runs
+     */
+    typedef struct NODE_COUNTERS
+    {
+        std::atomic<int> phase;
+        std::atomic<long long> localSortNs;
+        std::atomic<long long> mergeNs;
+        std::atomic<long long> commNs;
+        std::atomic<long long> bytesSent;
+        std::atomic<long long> bytesReceived;
+        std::atomic<long long> output;
+        std::atomic<long long> outputOffset;
+        std::atomic<long long> sentTo[gSAMPLE_MAX_NODES];
+    } NODE_COUNTERS;
+
+    // The counters of every node come first, the input and the output arrays after them
+    const size_t COUNTERS_BYTES = (sizeof(NODE_COUNTERS) * gSAMPLE_MAX_NODES + 63) / 64 * 64;
+
+    NODE_COUNTERS *counters(void *shared)
+    {
+        return static_cast<NODE_COUNTERS *>(shared);
+    }
+
+    long long nanosSince(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+#ifndef _WIN32
+#ifdef MSG_NOSIGNAL
+    const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    const int SEND_FLAGS = 0;
+#endif
+
+    /*!
+     * @brief The socket a node listens on, created by the parent before the workers start
+     */
+    typedef struct NODE_LISTENER
+    {
+        int socket = -1;
+        std::string path; /*! The path of the Unix socket */
+        int port = 0;     /*! The port of the TCP socket */
+    } NODE_LISTENER;
+
+    NODE_LISTENER listenNode(SAMPLE_TRANSPORT transport, const std::string &path)
+    {
+        NODE_LISTENER listener;
+
+        if (transport == UNIX_TRANSPORT) {
+            sockaddr_un local = {};
+            local.sun_family = AF_UNIX;
+            if (path.size() >= sizeof(local.sun_path))
+                throw std::runtime_error("Socket path too long: " + path);
+            strcpy(local.sun_path, path.c_str());
+            unlink(path.c_str());
+
+            listener.socket = socket(AF_UNIX, SOCK_STREAM, 0);
+            listener.path = path;
+            if (listener.socket < 0 || bind(listener.socket, (sockaddr *)&local, sizeof(local)) < 0)
+                throw std::runtime_error("Failed to bind the node socket " + path + ": " + strerror(errno));
+        }
+        else {
+            sockaddr_in local = {};
+            local.sin_family = AF_INET;
+            local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            local.sin_port = 0;
+
+            // The system picks a free port
+            listener.socket = socket(AF_INET, SOCK_STREAM, 0);
+            socklen_t length = sizeof(local);
+            if (listener.socket < 0 || bind(listener.socket, (sockaddr *)&local, sizeof(local)) < 0 || getsockname(listener.socket, (sockaddr *)&local, &length) < 0)
+                throw std::runtime_error(std::string("Failed to bind a node socket on 127.0.0.1: ") + strerror(errno));
+            listener.port = ntohs(local.sin_port);
+        }
+
+        if (listen(listener.socket, gSAMPLE_MAX_NODES) < 0)
+            throw std::runtime_error(std::string("Failed to listen on a node socket: ") + strerror(errno));
+        return listener;
+    }
+
+    int connectNode(SAMPLE_TRANSPORT transport, const NODE_LISTENER &listener)
+    {
+        int node = -1;
+
+        if (transport == UNIX_TRANSPORT) {
+            sockaddr_un remote = {};
+            remote.sun_family = AF_UNIX;
+            strcpy(remote.sun_path, listener.path.c_str());
+            node = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (node >= 0 && connect(node, (sockaddr *)&remote, sizeof(remote)) < 0) {
+                close(node);
+                node = -1;
+            }
+        }
+        else {
+            sockaddr_in remote = {};
+            remote.sin_family = AF_INET;
+            remote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            remote.sin_port = htons(listener.port);
+            node = socket(AF_INET, SOCK_STREAM, 0);
+            if (node >= 0 && connect(node, (sockaddr *)&remote, sizeof(remote)) < 0) {
+                close(node);
+                node = -1;
+            }
+
+            // The counts and the samples are small, they shouldn't wait for more data
+            int on = 1;
+            if (node >= 0)
+                setsockopt(node, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        if (node < 0)
+            throw std::runtime_error(std::string("Failed to connect to another node: ") + strerror(errno));
+        return node;
+    }
+
+    void sendAll(int socket, const void *data, size_t bytes)
+    {
+        for (size_t sent = 0; sent < bytes;) {
+            ssize_t count = send(socket, (const char *)data + sent, bytes - sent, SEND_FLAGS);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                throw std::runtime_error(std::string("Failed to send to another node: ") + strerror(errno));
+            sent += count;
+        }
+    }
+
+    void receiveAll(int socket, void *data, size_t bytes)
+    {
+        for (size_t received = 0; received < bytes;) {
+            ssize_t count = recv(socket, (char *)data + received, bytes - received, 0);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                throw std::runtime_error("Another node closed its socket");
+            received += count;
+        }
+    }
+
+    /*!
+     * @brief Connects a node to every other one, returns the socket of each (-1 for itself)
+     * @details Each node connects to the ones of lower rank and accepts the others, which send
+     *          their rank first. The listeners exist before any worker starts, so a connection
+     *          never races the listen.
+     */
+    std::vector<int> connectMesh(int rank, const SAMPLE_SORT_CONFIG &config, const std::vector<NODE_LISTENER> &listeners)
+    {
+        std::vector<int> peers(config.nodes, -1);
+
+        for (int node = 0; node < rank; node++) {
+            peers[node] = connectNode(config.transport, listeners[node]);
+            int32_t me = rank;
+            sendAll(peers[node], &me, sizeof(me));
+        }
+
+        for (int accepted = 0; accepted < config.nodes - 1 - rank; accepted++) {
+            pollfd ready = {listeners[rank].socket, POLLIN, 0};
+            if (poll(&ready, 1, TIMEOUT_MS) <= 0)
+                throw std::runtime_error("The other nodes didn't connect");
+
+            int peer = accept(listeners[rank].socket, NULL, NULL);
+            if (peer < 0)
+                throw std::runtime_error(std::string("Failed to accept another node: ") + strerror(errno));
+            int on = 1;
+            if (config.transport == TCP_TRANSPORT)
+                setsockopt(peer, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+            int32_t node = -1;
+            receiveAll(peer, &node, sizeof(node));
+            if (node <= rank || node >= config.nodes || peers[node] >= 0)
+                throw std::runtime_error("A node sent an invalid rank");
+            peers[node] = peer;
+        }
+
+        for (int peer : peers)
+            if (peer >= 0)
+                fcntl(peer, F_SETFL, fcntl(peer, F_GETFL, 0) | O_NONBLOCK);
+        return peers;
+    }
+
+    /*!
+     * @brief A message to a node and the place of the one coming back from it
+     */
+    typedef struct NODE_TRANSFER
+    {
+        const char *send = NULL;  /*! The bytes sent to the node */
+        uint64_t sendBytes = 0;
+        char *receive = NULL;     /*! Where the bytes of the node go */
+        uint64_t capacity = 0;    /*! The most bytes the node may send */
+        uint64_t received = 0;    /*! Set to the bytes the node sent */
+    } NODE_TRANSFER;
+
+    /*!
+     * @brief Sends every other node its message while receiving theirs, the all-to-all of the sort
+     * @details Every message is its length followed by its bytes. All the transfers progress at
+     *          once on non-blocking sockets: a node blocked sending to a busy peer would otherwise
+     *          deadlock with the peer blocked sending to it.
+     */
+    void exchange(int rank, const std::vector<int> &peers, std::vector<NODE_TRANSFER> &transfers, NODE_COUNTERS &counters)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        int nodes = peers.size();
+
+        std::vector<uint64_t> sendHeaders(nodes), receiveHeaders(nodes);
+        std::vector<uint64_t> sent(nodes, 0), received(nodes, 0);
+        int pending = 0;
+        for (int node = 0; node < nodes; node++) {
+            sendHeaders[node] = transfers[node].sendBytes;
+            transfers[node].received = 0;
+            if (node != rank)
+                pending += 2;
+        }
+
+        std::vector<pollfd> polls;
+        std::vector<int> polled;
+        while (pending > 0) {
+            polls.clear();
+            polled.clear();
+            for (int node = 0; node < nodes; node++) {
+                if (node == rank)
+                    continue;
+                short events = 0;
+                if (sent[node] < sizeof(uint64_t) + transfers[node].sendBytes)
+                    events |= POLLOUT;
+                if (received[node] < sizeof(uint64_t) || received[node] < sizeof(uint64_t) + receiveHeaders[node])
+                    events |= POLLIN;
+                if (events != 0) {
+                    polls.push_back({peers[node], events, 0});
+                    polled.push_back(node);
+                }
+            }
+
+            int ready = poll(polls.data(), polls.size(), TIMEOUT_MS);
+            if (ready < 0 && errno == EINTR)
+                continue;
+            if (ready <= 0)
+                throw std::runtime_error("The exchange between the nodes stalled");
+
+            for (size_t p = 0; p < polls.size(); p++) {
+                int node = polled[p];
+                NODE_TRANSFER &transfer = transfers[node];
+
+                if (polls[p].revents & POLLOUT) {
+                    // The length, then the bytes straight from the shard
+                    const char *data = sent[node] < sizeof(uint64_t) ? (const char *)&sendHeaders[node] + sent[node] : transfer.send + (sent[node] - sizeof(uint64_t));
+                    size_t bytes = sent[node] < sizeof(uint64_t) ? sizeof(uint64_t) - sent[node] : transfer.sendBytes - (sent[node] - sizeof(uint64_t));
+                    ssize_t count = send(peers[node], data, bytes, SEND_FLAGS);
+                    if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                        throw std::runtime_error(std::string("Failed to send to another node: ") + strerror(errno));
+                    if (count > 0) {
+                        sent[node] += count;
+                        counters.bytesSent += count;
+                        if (sent[node] == sizeof(uint64_t) + transfer.sendBytes)
+                            pending--;
+                    }
+                }
+
+                bool receiving = received[node] < sizeof(uint64_t) || received[node] < sizeof(uint64_t) + receiveHeaders[node];
+                if ((polls[p].revents & (POLLIN | POLLHUP | POLLERR)) && receiving) {
+                    // The length, then the bytes straight into their place
+                    char *data = received[node] < sizeof(uint64_t) ? (char *)&receiveHeaders[node] + received[node] : transfer.receive + (received[node] - sizeof(uint64_t));
+                    size_t bytes = received[node] < sizeof(uint64_t) ? sizeof(uint64_t) - received[node] : receiveHeaders[node] - (received[node] - sizeof(uint64_t));
+                    ssize_t count = recv(peers[node], data, bytes, 0);
+                    if (count == 0)
+                        throw std::runtime_error("Another node closed its socket");
+                    if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                        throw std::runtime_error(std::string("Failed to receive from another node: ") + strerror(errno));
+                    if (count > 0) {
+                        received[node] += count;
+                        counters.bytesReceived += count;
+                        if (received[node] == sizeof(uint64_t) && receiveHeaders[node] > transfer.capacity)
+                            throw std::runtime_error("Another node sent more than expected");
+                        if (received[node] == sizeof(uint64_t) + receiveHeaders[node]) {
+                            transfer.received = receiveHeaders[node];
+                            pending--;
+                        }
+                    }
+                }
+            }
+        }
+
+        counters.commNs += nanosSince(start);
+    }
+
+    /*!
+     * @brief The work of a node: sorts its shard, picks the splitters with the others, exchanges
+     *        the partitions and merges the ones it received into its part of the output
+     */
+    template <typename T>
+    void runNode(int rank, const SAMPLE_SORT_CONFIG &config, const std::vector<NODE_LISTENER> &listeners, void *shared, long long n)
+    {
+        int nodes = config.nodes;
+        NODE_COUNTERS &mine = counters(shared)[rank];
+        T *input = reinterpret_cast<T *>((char *)shared + COUNTERS_BYTES);
+        T *output = input + n;
+        TotalLess<T> less;
+        auto pause = [&]() {
+            if (config.phaseDelayMs > 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(config.phaseDelayMs));
+        };
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<int> peers = connectMesh(rank, config, listeners);
+        mine.commNs += nanosSince(start);
+
+        // The shard is sorted by the algorithm of the Registry, then put back where the window sees it
+        mine.phase = SAMPLE_LOCAL_SORT;
+        long long first = n * rank / nodes;
+        long long shardSize = n * (rank + 1) / nodes - first;
+        start = std::chrono::high_resolution_clock::now();
+        {
+            ElementArray shard(std::vector<T>(input + first, input + first + shardSize));
+            SortGenerator sorting = Registry::instance()[config.localSort].factory(shard);
+            while (sorting.next())
+                ;
+            sorting.reset();
+            const std::vector<T> &sorted = std::get<std::vector<T>>(shard);
+            std::copy(sorted.begin(), sorted.end(), input + first);
+        }
+        mine.localSortNs = nanosSince(start);
+        const T *shard = input + first;
+        pause();
+
+        // Regularly spaced samples go to every node, which all pick the same splitters from them
+        mine.phase = SAMPLE_SPLITTERS;
+        long long sampleCount = std::min<long long>(shardSize, (long long)config.oversampling * nodes);
+        std::vector<T> samples(sampleCount);
+        for (long long i = 0; i < sampleCount; i++)
+            samples[i] = shard[(2 * i + 1) * shardSize / (2 * sampleCount)];
+
+        long long maxSamples = (long long)config.oversampling * nodes;
+        std::vector<T> allSamples((size_t)maxSamples * nodes);
+        std::vector<NODE_TRANSFER> transfers(nodes);
+        for (int node = 0; node < nodes; node++) {
+            transfers[node].send = (const char *)samples.data();
+            transfers[node].sendBytes = sampleCount * sizeof(T);
+            transfers[node].receive = (char *)(allSamples.data() + (size_t)node * maxSamples);
+            transfers[node].capacity = maxSamples * sizeof(T);
+        }
+        exchange(rank, peers, transfers, mine);
+
+        std::vector<T> pool(samples);
+        for (int node = 0; node < nodes; node++)
+            if (node != rank)
+                pool.insert(pool.end(), allSamples.begin() + (size_t)node * maxSamples, allSamples.begin() + (size_t)node * maxSamples + transfers[node].received / sizeof(T));
+        std::sort(pool.begin(), pool.end(), less);
+
+        std::vector<T> splitters;
+        for (int k = 1; k < nodes && !pool.empty(); k++)
+            splitters.push_back(pool[(size_t)k * pool.size() / nodes]);
+
+        // Partition k holds the elements after splitter k - 1 up to splitter k, the last one takes the rest
+        std::vector<long long> bounds(nodes + 1, shardSize);
+        bounds[0] = 0;
+        for (int k = 0; k < (int)splitters.size(); k++)
+            bounds[k + 1] = std::upper_bound(shard, shard + shardSize, splitters[k], less) - shard;
+
+        // Every node learns the size of every partition, so each knows where its output goes
+        std::vector<long long> counts(nodes), allCounts((size_t)nodes * nodes);
+        for (int k = 0; k < nodes; k++)
+            counts[k] = bounds[k + 1] - bounds[k];
+        for (int node = 0; node < nodes; node++) {
+            transfers[node].send = (const char *)counts.data();
+            transfers[node].sendBytes = nodes * sizeof(long long);
+            transfers[node].receive = (char *)(allCounts.data() + (size_t)node * nodes);
+            transfers[node].capacity = nodes * sizeof(long long);
+        }
+        exchange(rank, peers, transfers, mine);
+        std::copy(counts.begin(), counts.end(), allCounts.begin() + (size_t)rank * nodes);
+
+        long long offset = 0;
+        long long received = 0;
+        for (int node = 0; node < nodes; node++)
+            for (int k = 0; k < nodes; k++) {
+                if (k < rank)
+                    offset += allCounts[(size_t)node * nodes + k];
+                else if (k == rank)
+                    received += allCounts[(size_t)node * nodes + k];
+            }
+        mine.outputOffset = offset;
+        mine.output = received;
+        pause();
+
+        // The partitions land straight in the output, in the order of the nodes sending them
+        mine.phase = SAMPLE_EXCHANGE;
+        std::vector<long long> runs(nodes + 1, offset);
+        for (int node = 0; node < nodes; node++)
+            runs[node + 1] = runs[node] + allCounts[(size_t)node * nodes + rank];
+
+        for (int node = 0; node < nodes; node++) {
+            transfers[node].send = (const char *)(shard + bounds[node]);
+            transfers[node].sendBytes = counts[node] * sizeof(T);
+            transfers[node].receive = (char *)(output + runs[node]);
+            transfers[node].capacity = (runs[node + 1] - runs[node]) * sizeof(T);
+            if (node != rank)
+                mine.sentTo[node] = counts[node] * sizeof(T);
+        }
+        std::copy(shard + bounds[rank], shard + bounds[rank + 1], output + runs[rank]);
+        exchange(rank, peers, transfers, mine);
+        pause();
+
+        // The sorted runs are merged pairwise until one is left
+        mine.phase = SAMPLE_MERGE;
+        start = std::chrono::high_resolution_clock::now();
+        for (int width = 1; width < nodes; width *= 2)
+            for (int run = 0; run + width < nodes; run += 2 * width)
+                std::inplace_merge(output + runs[run], output + runs[run + width], output + runs[std::min(nodes, run + 2 * width)], less);
+        mine.mergeNs = nanosSince(start);
+
+        for (int peer : peers)
+            if (peer >= 0)
+                close(peer);
+        mine.phase = SAMPLE_DONE;
+    }
+#endif
+}
+
+long long Visualizer::SAMPLE_SORT_STATS::commBytes() const
+{
+    long long bytes = 0;
+    for (const SAMPLE_NODE_STATS &node : nodes)
+        bytes += node.bytesSent;
+    return bytes;
+}
+
+double Visualizer::SAMPLE_SORT_STATS::imbalance() const
+{
+    long long largest = 0;
+    for (const SAMPLE_NODE_STATS &node : nodes)
+        largest = std::max(largest, node.output);
+    return elements > 0 && !nodes.empty() ? (double)largest * nodes.size() / elements : 1.0;
+}
+
+Visualizer::SampleSort::SampleSort(const SAMPLE_SORT_CONFIG &config) : mConfig(config)
+{
+    mConfig.nodes = std::max(1, std::min(gSAMPLE_MAX_NODES, mConfig.nodes));
+    mConfig.oversampling = std::max(1, mConfig.oversampling);
+}
+
+Visualizer::SampleSort::~SampleSort()
+{
+#ifndef _WIN32
+    if (mShared != NULL)
+        munmap(mShared, mSharedBytes);
+#endif
+}
+
+template <typename T>
+Visualizer::SAMPLE_SORT_STATS Visualizer::SampleSort::sort(std::vector<T> &array)
+{
+#ifdef _WIN32
+    throw std::runtime_error("The sample sort needs a POSIX system");
+#else
+    TRACE_SPAN("sample sort");
+    auto start = std::chrono::high_resolution_clock::now();
+    long long n = array.size();
+    int nodes = mConfig.nodes;
+
+    // The workers inherit the mapping, the input and the output are shared with them
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mShared != NULL)
+            munmap(mShared, mSharedBytes);
+        mSharedBytes = COUNTERS_BYTES + std::max<size_t>(1, 2 * n * sizeof(T));
+        mShared = mmap(NULL, mSharedBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mShared == MAP_FAILED) {
+            mShared = NULL;
+            throw std::runtime_error("Failed to map the memory of the sample sort");
+        }
+        for (int node = 0; node < gSAMPLE_MAX_NODES; node++)
+            new (counters(mShared) + node) NODE_COUNTERS();
+        std::copy(array.begin(), array.end(), reinterpret_cast<T *>((char *)mShared + COUNTERS_BYTES));
+        mElements = n;
+        mElementBytes = sizeof(T);
+        mNodes = nodes;
+    }
+
+    static std::atomic<int> sorts = 0;
+    std::string prefix = "/tmp/sort-sample-" + std::to_string(getpid()) + "-" + std::to_string(sorts++) + "-";
+    std::vector<NODE_LISTENER> listeners;
+    std::vector<pid_t> workers;
+
+    auto cleanup = [&]() {
+        for (pid_t worker : workers)
+            if (worker > 0) {
+                kill(worker, SIGKILL);
+                waitpid(worker, NULL, 0);
+            }
+        for (const NODE_LISTENER &listener : listeners) {
+            if (listener.socket >= 0)
+                close(listener.socket);
+            if (!listener.path.empty())
+                unlink(listener.path.c_str());
+        }
+    };
+
+    try {
+        for (int node = 0; node < nodes; node++)
+            listeners.push_back(listenNode(mConfig.transport, prefix + std::to_string(node) + ".sock"));
+
+        for (int node = 0; node < nodes; node++) {
+            pid_t worker = fork();
+            if (worker < 0)
+                throw std::runtime_error(std::string("Failed to start a node of the sample sort: ") + strerror(errno));
+
+            if (worker == 0) {
+                // The worker only has this thread, it must not touch the locks of the others (stdio, the tracer)
+                int code = 0;
+                try {
+                    runNode<T>(node, mConfig, listeners, mShared, n);
+                }
+                catch (std::exception &e) {
+                    std::string message = "Node " + std::to_string(node) + " of the sample sort failed: " + e.what() + "\n";
+                    ssize_t written = write(STDERR_FILENO, message.c_str(), message.size());
+                    (void)written;
+                    code = 1;
+                }
+                _exit(code);
+            }
+            workers.push_back(worker);
+        }
+        mSetupMs = nanosSince(start) / 1e6;
+    }
+    catch (...) {
+        cleanup();
+        throw;
+    }
+
+    // Waits for the workers, every one of them is killed as soon as one fails or the sort is cancelled
+    bool failed = false;
+    int running = nodes;
+    while (running > 0) {
+        for (pid_t &worker : workers) {
+            int status = 0;
+            if (worker > 0 && waitpid(worker, &status, WNOHANG) == worker) {
+                worker = 0;
+                running--;
+                failed = failed || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+            }
+        }
+        if ((failed || mCancel) && running > 0) {
+            cleanup();
+            running = 0;
+        }
+        if (running > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    cleanup();
+
+    SAMPLE_SORT_STATS stats = status();
+    stats.cancelled = mCancel;
+    if (failed && !mCancel)
+        throw std::runtime_error("A node of the sample sort failed");
+
+    if (!mCancel) {
+        const T *output = reinterpret_cast<const T *>((char *)mShared + COUNTERS_BYTES) + n;
+        std::copy(output, output + n, array.begin());
+    }
+    stats.timeMs = nanosSince(start) / 1e6;
+    return stats;
+#endif
+}
+
+Visualizer::SAMPLE_SORT_STATS Visualizer::SampleSort::status() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    SAMPLE_SORT_STATS stats;
+    stats.elements = mElements;
+    stats.setupMs = mSetupMs;
+    if (mShared == NULL)
+        return stats;
+
+    for (int node = 0; node < mNodes; node++) {
+        const NODE_COUNTERS &source = counters(mShared)[node];
+        SAMPLE_NODE_STATS result;
+        result.shard = mElements * (node + 1) / mNodes - mElements * node / mNodes;
+        result.output = source.output;
+        result.outputOffset = source.outputOffset;
+        result.localSortMs = source.localSortNs / 1e6;
+        result.mergeMs = source.mergeNs / 1e6;
+        result.commMs = source.commNs / 1e6;
+        result.bytesSent = source.bytesSent;
+        result.bytesReceived = source.bytesReceived;
+        for (int peer = 0; peer < mNodes; peer++)
+            result.sentTo.push_back(source.sentTo[peer]);
+        result.phase = (SAMPLE_PHASE)source.phase.load();
+        stats.nodes.push_back(result);
+    }
+    return stats;
+}
+
+template <typename T>
+bool Visualizer::SampleSort::snapshot(std::vector<T> &array, std::vector<int> &owners) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mShared == NULL || mElementBytes != (int)sizeof(T))
+        return false;
+
+    // The output is only complete once every node is past the exchange
+    bool merging = true;
+    for (int node = 0; node < mNodes; node++)
+        merging = merging && counters(mShared)[node].phase >= SAMPLE_MERGE;
+
+    const T *source = reinterpret_cast<const T *>((char *)mShared + COUNTERS_BYTES) + (merging ? mElements : 0);
+    array.assign(source, source + mElements);
+
+    owners.assign(mElements, 0);
+    for (int node = 0; node < mNodes; node++) {
+        long long first = merging ? counters(mShared)[node].outputOffset.load() : mElements * node / mNodes;
+        long long count = merging ? counters(mShared)[node].output.load() : mElements * (node + 1) / mNodes - first;
+        std::fill(owners.begin() + std::min(first, mElements), owners.begin() + std::min(first + count, mElements), node);
+    }
+    return true;
+}
+
+// The sort is instantiated for every ELEMENT_TYPE
+#define INSTANTIATE_SAMPLE_SORT(T) \
+    template Visualizer::SAMPLE_SORT_STATS Visualizer::SampleSort::sort<T>(std::vector<T> &); \
+    template bool Visualizer::SampleSort::snapshot<T>(std::vector<T> &, std::vector<int> &) const;
+
+INSTANTIATE_SAMPLE_SORT(int32_t)
+INSTANTIATE_SAMPLE_SORT(int64_t)
+INSTANTIATE_SAMPLE_SORT(uint64_t)
+INSTANTIATE_SAMPLE_SORT(float)
+INSTANTIATE_SAMPLE_SORT(double)
@@ -0,0 +1,167 @@
+//
+//  SampleSort.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef SampleSort_hpp
+#define SampleSort_hpp
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+
+#include "Utilities.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Enum that represents the phases a node of the sample sort goes through
+     */
+    enum SAMPLE_PHASE
+    {
+        SAMPLE_IDLE,
+        SAMPLE_LOCAL_SORT, // Sorting its shard
+        SAMPLE_SPLITTERS,  // Sharing samples with every node and picking the splitters
+        SAMPLE_EXCHANGE,   // Sending each node its partition of the shard, receiving its own
+        SAMPLE_MERGE,      // Merging the partitions received into its part of the output
+        SAMPLE_DONE
+    };
+
+    const std::string gSAMPLE_PHASE_NAMES[] = {"idle", "local sort", "splitters", "exchange", "merge", "done"};
+
+    /*!
+     * @brief Enum that represents the sockets the nodes talk over
+     */
+    enum SAMPLE_TRANSPORT
+    {
+        UNIX_TRANSPORT, // Unix domain sockets in /tmp
+        TCP_TRANSPORT   // TCP sockets on 127.0.0.1
+    };
+
+    const std::string gSAMPLE_TRANSPORT_NAMES[] = {"unix", "tcp"};
+
+    const int gSAMPLE_TRANSPORTS_COUNT = 2;
+
+    // The most worker processes a sample sort starts
+    const int gSAMPLE_MAX_NODES = 16;
+
+    /*!
+     * @brief The options of a sample sort
+     */
+    typedef struct SAMPLE_SORT_CONFIG
+    {
+        int nodes = 4;                              /*! The worker processes, each sorting a shard */
+        SAMPLE_TRANSPORT transport = UNIX_TRANSPORT; /*! The sockets between the workers */
+        int localSort = QUICK_SORT;                 /*! The algorithm sorting the shards (its index in the Registry) */
+        int oversampling = 16;                      /*! The samples each node sends per node, more of them balance the partitions better */
+        int phaseDelayMs = 0;                       /*! The pause of every node after each phase, so the window can show them */
+    } SAMPLE_SORT_CONFIG;
+
+    /*!
+     * @brief The statistics of a node of the sample sort
+     */
+    typedef struct SAMPLE_NODE_STATS
+    {
+        long long shard = 0;            /*! The elements of its shard */
+        long long output = 0;           /*! The elements of its part of the output */
+        long long outputOffset = 0;     /*! Where its part starts in the output */
+        double localSortMs = 0.0;       /*! The time sorting the shard */
+        double mergeMs = 0.0;           /*! The time merging the partitions received */
+        double commMs = 0.0;            /*! The time spent in the exchanges, waiting for the slowest node included */
+        long long bytesSent = 0;        /*! The bytes written to the sockets, samples and counts included */
+        long long bytesReceived = 0;    /*! The bytes read from the sockets */
+        std::vector<long long> sentTo;  /*! The bytes of the partition sent to each node (its own stays local) */
+        SAMPLE_PHASE phase = SAMPLE_IDLE;
+    } SAMPLE_NODE_STATS;
+
+    /*!
+     * @brief The statistics of a sample sort
+     */
+    typedef struct SAMPLE_SORT_STATS
+    {
+        long long elements = 0;
+        std::vector<SAMPLE_NODE_STATS> nodes;
+        double setupMs = 0.0;           /*! The time starting the workers and creating their sockets */
+        double timeMs = 0.0;            /*! The time of the whole sort, setup included */
+        bool cancelled = false;         /*! Whether the sort was cancelled */
+
+        /*!
+         * @brief The bytes every node wrote to the sockets
+         */
+        long long commBytes() const;
+
+        /*!
+         * @brief The largest part of the output over the average, 1 when perfectly balanced
+         */
+        double imbalance() const;
+    } SAMPLE_SORT_STATS;
+
+    /*!
+     * @brief Sorts an array with worker processes that exchange their data over sockets, like the nodes of a cluster
+     * @details Each worker is a process forked with the array in shared memory. It sorts its
+     *          shard with an algorithm of the Registry and sends regularly spaced samples of it
+     *          to every other node; all of them sort the same samples and pick the same splitters.
+     *          The shard is then cut at the splitters and every node sends each other node its
+     *          partition in an all-to-all exchange over Unix or TCP sockets, all transfers
+     *          progressing at once through poll so no node waits on another's buffers. The sorted
+     *          partitions received are merged into the node's part of the output, whose offset
+     *          the nodes know from the partition sizes exchanged beforehand.
+     */
+    class SampleSort
+    {
+    public:
+        /*!
+         * @brief SampleSort constructor
+         * @param config The options of the sort
+         */
+        SampleSort(const SAMPLE_SORT_CONFIG &config);
+
+        ~SampleSort();
+
+        SampleSort(const SampleSort &) = delete;
+        SampleSort &operator=(const SampleSort &) = delete;
+
+        /*!
+         * @brief Sorts the array with the worker processes
+         * @details Can be called from any thread, status(), snapshot() and cancel() can be used meanwhile.
+         * @throws std::runtime_error if the workers can't be started or one of them fails
+         */
+        template <typename T>
+        SAMPLE_SORT_STATS sort(std::vector<T> &array);
+
+        /*!
+         * @brief Returns the progress of every node
+         */
+        SAMPLE_SORT_STATS status() const;
+
+        /*!
+         * @brief Copies the elements as the nodes hold them: the shards until every node is
+         *        merging, then the output
+         * @param owners Receives the node holding each element
+         * @return false if no sort of this type ran yet
+         */
+        template <typename T>
+        bool snapshot(std::vector<T> &array, std::vector<int> &owners) const;
+
+        /*!
+         * @brief Kills the workers of the running sort
+         */
+        void cancel() { mCancel = true; }
+
+    private:
+        SAMPLE_SORT_CONFIG mConfig;        /*! The options of the sort */
+        mutable std::mutex mMutex;         /*! Protects the mapping while it's replaced */
+        void *mShared = NULL;              /*! The memory shared with the workers: their counters, the input and the output */
+        size_t mSharedBytes = 0;
+        long long mElements = 0;           /*! The elements of the mapped arrays */
+        int mElementBytes = 0;             /*! The size of the mapped elements */
+        int mNodes = 0;                    /*! The nodes of the last sort */
+        double mSetupMs = 0.0;
+        std::atomic<bool> mCancel = false; /*! Whether the sort was cancelled */
+    };
+}
+
+#endif /* SampleSort_hpp */
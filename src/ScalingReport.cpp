@@ -0,0 +1,284 @@
+//
+//  ScalingReport.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#include "ScalingReport.hpp"
+#include "Elements.hpp"
+#include "Registry.hpp"
+#include "Trace.hpp"
+
+namespace
+{
+    using namespace Visualizer;
+
+    // The growth of a model at size n
+    double growth(int model, double n)
+    {
+        switch (model) {
+            case LINEAR_MODEL:
+                return n;
+            case LINEARITHMIC_MODEL:
+                return n * std::log2(n);
+            default:
+                return n * n;
+        }
+    }
+}
+
+double Visualizer::SCALING_FIT::predict(double n) const
+{
+    return constants[model] * growth(model, n);
+}
+
+Visualizer::ScalingReport::ScalingReport(unsigned seed, double budgetMs, int repeats)
+    : mSeed(seed), mBudgetMs(budgetMs), mRepeats(std::max(1, repeats))
+{
+}
+
+std::vector<int> Visualizer::ScalingReport::sizes(int minSize, int maxSize)
+{
+    std::vector<int> sizes;
+    for (long long n = std::max(2, minSize); n <= maxSize; n *= 2)
+        sizes.push_back(n);
+    return sizes;
+}
+
+void Visualizer::ScalingReport::measure(int sort, ELEMENT_TYPE type, const std::vector<int> &sizes)
+{
+    SCALING_CURVE curve;
+    curve.sort = sort;
+    curve.type = type;
+
+    for (int n : sizes) {
+        SCALING_SAMPLE sample = run(sort, type, n);
+        if (mCancel)
+            return;
+        curve.samples.push_back(sample);
+
+        for (int metric = 0; metric < gSCALING_METRICS_COUNT; metric++)
+            curve.fits[metric] = fit(curve.samples, (SCALING_METRIC)metric);
+
+        // The curve is published after every size, so the plot grows while measuring
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto found = std::find_if(mCurves.begin(), mCurves.end(), [&](const SCALING_CURVE &c) { return c.sort == sort && c.type == type; });
+            if (found == mCurves.end())
+                mCurves.push_back(curve);
+            else
+                *found = curve;
+        }
+
+        // Doubling n at most quadruples the time of the algorithms fitted here
+        if (sample.metrics[TIME_METRIC] > mBudgetMs / 4)
+            break;
+    }
+}
+
+std::vector<Visualizer::SCALING_CURVE> Visualizer::ScalingReport::curves()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCurves;
+}
+
+Visualizer::SCALING_SAMPLE Visualizer::ScalingReport::run(int sort, ELEMENT_TYPE type, int n)
+{
+    TRACE_SPAN("ScalingReport::run");
+
+    SCALING_SAMPLE sample = {n, {}};
+    std::vector<double> times;
+
+    for (int r = 0; r < mRepeats && !mCancel; r++) {
+        ElementArray array = makeElementArray(type, n);
+        std::visit([&](auto &values) { std::shuffle(values.begin(), values.end(), std::mt19937(mSeed + n)); }, array);
+
+        long long comparisons = 0;
+        long long writes = 0;
+        long long ops = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        SortGenerator sorting = Registry::instance()[sort].factory(array);
+        while (sorting.next()) {
+            switch (sorting.value().type) {
+                case COMPARE_OP:
+                    comparisons++;
+                    break;
+                case SWAP_OP:
+                    writes += 2;
+                    break;
+                case WRITE_OP:
+                    writes++;
+                    break;
+                case READ_OP:
+                    break;
+            }
+            if ((++ops & 0xFFFF) == 0 && mCancel)
+                break;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        sample.metrics[COMPARISONS_METRIC] = comparisons;
+        sample.metrics[WRITES_METRIC] = writes;
+        times.push_back(Registry::instance().sortTimeMs(sort, start, end));
+    }
+
+    if (!times.empty()) {
+        std::sort(times.begin(), times.end());
+        sample.metrics[TIME_METRIC] = times[times.size() / 2];
+        if (sample.metrics[TIME_METRIC] > 0)
+            sample.spread = (times[times.size() * 3 / 4] - times[times.size() / 4]) / sample.metrics[TIME_METRIC];
+    }
+    return sample;
+}
+
+Visualizer::SCALING_FIT Visualizer::ScalingReport::fit(const std::vector<SCALING_SAMPLE> &samples, SCALING_METRIC metric)
+{
+    // Zero counts (a sort writing nothing) and n < 2 (log n = 0) can't be fitted in log space
+    std::vector<const SCALING_SAMPLE *> points;
+    for (const SCALING_SAMPLE &sample : samples)
+        if (sample.n >= 2 && sample.metrics[metric] > 0)
+            points.push_back(&sample);
+
+    long long large = std::count_if(points.begin(), points.end(), [](const SCALING_SAMPLE *s) { return s->n >= 64; });
+    if (large >= 3)
+        points.erase(std::remove_if(points.begin(), points.end(), [](const SCALING_SAMPLE *s) { return s->n < 64; }), points.end());
+
+    SCALING_FIT result;
+    if (points.size() < 2)
+        return result;
+
+    for (int model = 0; model < gSCALING_MODELS_COUNT; model++) {
+        // With the exponent fixed, the least squares constant in log space is the mean log ratio
+        double logConstant = 0.0;
+        for (const SCALING_SAMPLE *point : points)
+            logConstant += std::log10(point->metrics[metric] / growth(model, point->n));
+        logConstant /= points.size();
+
+        double error = 0.0;
+        for (const SCALING_SAMPLE *point : points) {
+            double residual = std::log10(point->metrics[metric] / growth(model, point->n)) - logConstant;
+            error += residual * residual;
+        }
+
+        result.constants[model] = std::pow(10.0, logConstant);
+        result.errors[model] = std::sqrt(error / points.size());
+        if (result.errors[model] < result.errors[result.model])
+            result.model = (SCALING_MODEL)model;
+    }
+
+    result.valid = true;
+    return result;
+}
+
+std::vector<Visualizer::SCALING_CROSSOVER> Visualizer::ScalingReport::crossovers(const std::vector<SCALING_CURVE> &curves, SCALING_METRIC metric)
+{
+    std::vector<SCALING_CROSSOVER> crossovers;
+
+    for (size_t a = 0; a < curves.size(); a++) {
+        for (size_t b = a + 1; b < curves.size(); b++) {
+            if (curves[a].type != curves[b].type)
+                continue;
+
+            // The log ratio of the measurements at the sizes both algorithms ran, negative where a
+            // is ahead, and the side of each: -1 or 1 past the spread of the times, 0 within it
+            std::vector<std::pair<double, double>> ratios;
+            std::vector<int> sides;
+            for (const SCALING_SAMPLE &sampleA : curves[a].samples) {
+                auto sampleB = std::find_if(curves[b].samples.begin(), curves[b].samples.end(), [&](const SCALING_SAMPLE &s) { return s.n == sampleA.n; });
+                if (sampleB == curves[b].samples.end() || sampleA.metrics[metric] <= 0 || sampleB->metrics[metric] <= 0)
+                    continue;
+
+                double ratio = std::log(sampleA.metrics[metric] / sampleB->metrics[metric]);
+                double noise = metric == TIME_METRIC ? std::log(1 + std::max(sampleA.spread, sampleB->spread)) : 0.0;
+                ratios.push_back({std::log((double)sampleA.n), ratio});
+                sides.push_back(std::fabs(ratio) <= noise ? 0 : ratio < 0 ? -1 : 1);
+            }
+            if (ratios.empty())
+                continue;
+
+            // The lead settles after gCROSSOVER_SIZES consecutive sizes on one side, a crossover
+            // is where it settles on the other side
+            int leader = 0;      // The settled side, 0 until one is
+            size_t lastAhead = 0; // The last size the leader was ahead
+            int run = 0;
+            for (size_t i = 0; i < sides.size(); i++) {
+                run = sides[i] != 0 && i > 0 && sides[i] == sides[i - 1] ? run + 1 : sides[i] != 0;
+                if (sides[i] != 0 && sides[i] == leader)
+                    lastAhead = i;
+                if (run < gCROSSOVER_SIZES || sides[i] == leader)
+                    continue;
+
+                if (leader != 0) {
+                    // The zero of the log ratio after the last size the former leader was ahead
+                    size_t k = lastAhead;
+                    while (k + 1 < ratios.size() && (ratios[k + 1].second < 0) == (leader < 0))
+                        k++;
+                    double share = ratios[k].second / (ratios[k].second - ratios[k + 1].second);
+                    double n = std::exp(ratios[k].first + share * (ratios[k + 1].first - ratios[k].first));
+                    bool aWins = sides[i] < 0;
+                    crossovers.push_back({curves[a].type, aWins ? curves[a].sort : curves[b].sort, aWins ? curves[b].sort : curves[a].sort, n, true});
+                }
+                leader = sides[i];
+                lastAhead = i;
+            }
+
+            // Past the largest size the fits tell, as long as they agree with the settled leader
+            // (with the same model their ratio is constant, the one ahead stays ahead)
+            const SCALING_FIT &fitA = curves[a].fits[metric];
+            const SCALING_FIT &fitB = curves[b].fits[metric];
+            if (leader == 0 || !fitA.valid || !fitB.valid || fitA.model == fitB.model)
+                continue;
+
+            auto ratio = [&](double n) { return std::log(fitA.predict(n) / fitB.predict(n)); };
+            double low = std::exp(ratios.back().first);
+            double high = 1e12;
+            if ((ratio(low) < 0) != (leader < 0) || (ratio(low) < 0) == (ratio(high) < 0))
+                continue;
+
+            // The log ratio of the fits is monotonic in n, so it changes sign at most once
+            for (int step = 0; step < 100; step++) {
+                double middle = std::sqrt(low * high);
+                if ((ratio(middle) < 0) == (ratio(low) < 0))
+                    low = middle;
+                else
+                    high = middle;
+            }
+
+            // The one with the slower growing model wins past the crossing
+            bool aWins = fitA.model < fitB.model;
+            crossovers.push_back({curves[a].type, aWins ? curves[a].sort : curves[b].sort, aWins ? curves[b].sort : curves[a].sort, low, false});
+        }
+    }
+
+    return crossovers;
+}
+
+void Visualizer::ScalingReport::print()
+{
+    std::vector<SCALING_CURVE> measured = curves();
+
+    printf("algorithm,type,metric,max_n,best_model,constant,error_n,error_nlogn,error_n2\n");
+    for (const SCALING_CURVE &curve : measured) {
+        for (int metric = 0; metric < gSCALING_METRICS_COUNT; metric++) {
+            const SCALING_FIT &fit = curve.fits[metric];
+            printf("%s,%s,%s,%d,%s,%.6g,", Registry::instance()[curve.sort].key.c_str(), gELEMENT_TYPE_NAMES[curve.type].c_str(),
+                   gSCALING_METRIC_NAMES[metric].c_str(), curve.samples.empty() ? 0 : curve.samples.back().n,
+                   fit.valid ? gSCALING_MODEL_NAMES[fit.model].c_str() : "none", fit.constants[fit.model]);
+            printf("%.4f,%.4f,%.4f\n", fit.errors[LINEAR_MODEL], fit.errors[LINEARITHMIC_MODEL], fit.errors[QUADRATIC_MODEL]);
+        }
+    }
+
+    printf("\nfaster,slower,type,metric,crossover_n,source\n");
+    for (const SCALING_CROSSOVER &crossover : crossovers(measured, TIME_METRIC))
+        printf("%s,%s,%s,%s,%.0f,%s\n", Registry::instance()[crossover.faster].key.c_str(), Registry::instance()[crossover.slower].key.c_str(),
+               gELEMENT_TYPE_NAMES[crossover.type].c_str(), gSCALING_METRIC_NAMES[TIME_METRIC].c_str(), crossover.n,
+               crossover.measured ? "measured" : "extrapolated");
+}
@@ -0,0 +1,183 @@
+//
+//  ScalingReport.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef ScalingReport_hpp
+#define ScalingReport_hpp
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+
+#include "Utilities.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Enum that represents the growth models fitted to the measurements
+     */
+    enum SCALING_MODEL
+    {
+        LINEAR_MODEL,       // c n
+        LINEARITHMIC_MODEL, // c n log2 n
+        QUADRATIC_MODEL     // c n^2
+    };
+
+    const std::string gSCALING_MODEL_NAMES[] = {"n", "n log n", "n^2"};
+
+    const int gSCALING_MODELS_COUNT = 3;
+
+    /*!
+     * @brief Enum that represents the quantities measured at every size
+     */
+    enum SCALING_METRIC
+    {
+        COMPARISONS_METRIC, // The comparisons yielded
+        WRITES_METRIC,      // The elements written, two for each swap
+        TIME_METRIC         // The wall time of the sort in milliseconds
+    };
+
+    const std::string gSCALING_METRIC_NAMES[] = {"comparisons", "writes", "time_ms"};
+
+    const int gSCALING_METRICS_COUNT = 3;
+
+    // The consecutive sizes an algorithm has to stay ahead of another for a crossover to count
+    const int gCROSSOVER_SIZES = 3;
+
+    /*!
+     * @brief The measurements of an algorithm at one size
+     */
+    typedef struct SCALING_SAMPLE
+    {
+        int n;
+        double metrics[gSCALING_METRICS_COUNT]; /*! Indexed by SCALING_METRIC */
+        double spread = 0.0; /*! The interquartile range of the times of the repeats over their median */
+    } SCALING_SAMPLE;
+
+    /*!
+     * @brief The fit of the growth models to one metric of an algorithm
+     */
+    typedef struct SCALING_FIT
+    {
+        SCALING_MODEL model = LINEAR_MODEL;       /*! The model with the smallest error */
+        double constants[gSCALING_MODELS_COUNT] = {}; /*! The constant factor of each model */
+        double errors[gSCALING_MODELS_COUNT] = {};    /*! The RMS error of each model, in decades */
+        bool valid = false;                       /*! Whether there were enough samples to fit */
+
+        /*!
+         * @brief The value predicted by the best model at size n
+         */
+        double predict(double n) const;
+    } SCALING_FIT;
+
+    /*!
+     * @brief The measurements of an algorithm over the sizes and their fits
+     */
+    typedef struct SCALING_CURVE
+    {
+        int sort;                                /*! The index of the algorithm in the Registry */
+        ELEMENT_TYPE type;                       /*! The type of the elements sorted */
+        std::vector<SCALING_SAMPLE> samples;     /*! One for each size measured, in increasing order */
+        SCALING_FIT fits[gSCALING_METRICS_COUNT]; /*! Indexed by SCALING_METRIC */
+    } SCALING_CURVE;
+
+    /*!
+     * @brief A size where an algorithm overtakes another one
+     */
+    typedef struct SCALING_CROSSOVER
+    {
+        ELEMENT_TYPE type; /*! The type of the elements sorted */
+        int faster;     /*! The algorithm ahead for larger sizes */
+        int slower;     /*! The algorithm ahead for smaller sizes */
+        double n;       /*! The size where they cross */
+        bool measured;  /*! Whether n is interpolated between two measured sizes, or extrapolated from the fits */
+    } SCALING_CROSSOVER;
+
+    /*!
+     * @brief Measures how the algorithms scale over a geometric range of sizes
+     * @details Every algorithm runs at sizes doubling from a minimum to a maximum, until a single
+     *          run takes more than a quarter of the time budget (so quadratic algorithms stop
+     *          well before the linearithmic ones). Each metric is fitted against c n, c n log n
+     *          and c n^2 by least squares in log space, so the small and the large sizes weigh
+     *          the same, and the model with the smallest error is the best fit.
+     */
+    class ScalingReport
+    {
+    public:
+        /*!
+         * @brief ScalingReport constructor
+         * @param seed The seed of the shuffles
+         * @param budgetMs The time a single run may take before the sizes stop growing
+         * @param repeats The runs at each size, the median time is kept
+         */
+        ScalingReport(unsigned seed, double budgetMs, int repeats = 1);
+
+        /*!
+         * @brief The powers of two from minSize to maxSize
+         */
+        static std::vector<int> sizes(int minSize, int maxSize);
+
+        /*!
+         * @brief Measures an algorithm over the sizes and fits its curve
+         * @details Can run on another thread while curves() is called.
+         * @param sort The index of the algorithm in the Registry
+         * @param type The type of the elements sorted
+         * @param sizes The sizes to run, in increasing order
+         */
+        void measure(int sort, ELEMENT_TYPE type, const std::vector<int> &sizes);
+
+        /*!
+         * @brief A copy of the curves measured so far
+         */
+        std::vector<SCALING_CURVE> curves();
+
+        /*!
+         * @brief Fits the growth models to one metric of the samples
+         * @details The samples below 64 elements are left out of the fit when there are at least
+         *          3 larger ones, their time is mostly overhead.
+         */
+        static SCALING_FIT fit(const std::vector<SCALING_SAMPLE> &samples, SCALING_METRIC metric);
+
+        /*!
+         * @brief The sizes where two algorithms sorting the same element type overtake each other
+         * @details Within the sizes both ran, a size only counts for the one ahead when the gap
+         *          exceeds the spread of the repeats of both, and only gCROSSOVER_SIZES
+         *          consecutive sizes ahead settle which one leads. A crossover is where the lead
+         *          settles on the other one, interpolated on the log axes where the ratio first
+         *          changes sign after the last size the former leader was ahead. Past the largest
+         *          size, where the fitted curves cross, if the fits agree with the settled leader.
+         *          Fits of the same model never cross, their constants keep the same one ahead.
+         */
+        static std::vector<SCALING_CROSSOVER> crossovers(const std::vector<SCALING_CURVE> &curves, SCALING_METRIC metric);
+
+        /*!
+         * @brief Prints the fits and the crossovers of the wall time as CSV tables
+         */
+        void print();
+
+        /*!
+         * @brief Stops the measurement in progress, at the next size
+         */
+        void cancel() { mCancel = true; }
+
+    private:
+        unsigned mSeed;      /*! The seed of the shuffles */
+        double mBudgetMs;    /*! The longest run before the sizes stop growing */
+        int mRepeats;        /*! The runs at each size */
+
+        std::mutex mMutex;                  /*! Protects the curves */
+        std::vector<SCALING_CURVE> mCurves; /*! The curves measured so far */
+        std::atomic<bool> mCancel = false;  /*! Set to stop the measurement */
+
+        /*!
+         * @brief Sorts a shuffled array of n elements and returns its metrics
+         */
+        SCALING_SAMPLE run(int sort, ELEMENT_TYPE type, int n);
+    };
+}
+
+#endif /* ScalingReport_hpp */
@@ -0,0 +1,382 @@
+//
+//  ShmTrace.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef ShmTrace_hpp
+#define ShmTrace_hpp
+
+#include <new>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "EventFeed.hpp"
+
+namespace Visualizer
+{
+    const int gSHM_TRACE_VERSION = 1;
+
+    // The records the ring holds by default, 16MB of shared memory
+    const uint32_t gSHM_TRACE_CAPACITY = 1 << 20;
+
+    /*!
+     * @brief The start of the shared memory, followed by the ring of records
+     * @details A record is two 64 bit words, stored as atomics so the viewer may read a slot the
+     *          program is overwriting without undefined behavior. The counters live on their own
+     *          cache lines so the program and the viewer don't write to the same one.
+     */
+    typedef struct SHM_TRACE_HEADER
+    {
+        std::atomic<int64_t> magic; /*! gFEED_MAGIC once the ring is ready */
+        int32_t version;            /*! gSHM_TRACE_VERSION */
+        uint32_t capacity;          /*! The records of the ring, a power of two */
+
+        alignas(64) std::atomic<uint64_t> head;     /*! The records ever published, written by the program */
+        std::atomic<uint64_t> reserved;             /*! The records ever written to, published or not */
+        std::atomic<uint32_t> closed;               /*! Set by the program when it stops tracing */
+        alignas(64) std::atomic<uint32_t> resync;   /*! Set by the viewer when it lost records and needs the array again */
+    } SHM_TRACE_HEADER;
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free,
+                  "The ring is shared between processes, its atomics must be lock free");
+
+    /*!
+     * @brief The bytes of shared memory of a ring of the given capacity
+     */
+    inline size_t shmTraceBytes(uint32_t capacity)
+    {
+        return sizeof(SHM_TRACE_HEADER) + (size_t)capacity * 2 * sizeof(std::atomic<int64_t>);
+    }
+
+    /*!
+     * @brief Traces the sort of another program into a POSIX shared memory ring the visualizer attaches to
+     * @details Header only, it only needs this file and EventFeed.hpp (for the records). Every
+     *          call stores one record straight into the shared memory, the only copy made on this
+     *          side, with a few plain stores and no lock, wait or system call: the program never
+     *          waits for the viewer, which loses the records it didn't read before they were
+     *          overwritten and asks for the array again. The array is then sent on the next call,
+     *          from the thread running the sort, so the ring must hold more records than the
+     *          array has elements. Only one thread may trace at a time.
+     *
+     *          begin(array, n) ... compare(i, j) / swap(i, j) / write(i, value) ... end()
+     */
+    class ShmTraceWriter
+    {
+    public:
+        /*!
+         * @brief ShmTraceWriter constructor, creates the shared memory
+         * @param name The name of the shared memory, like /sort
+         * @param capacity The records of the ring, rounded up to a power of two
+         * @throws std::runtime_error if the shared memory can't be created
+         */
+        ShmTraceWriter(const std::string &name, uint32_t capacity = gSHM_TRACE_CAPACITY) : mName(name)
+        {
+#ifdef _WIN32
+            throw std::runtime_error("Shared memory tracing needs a POSIX system");
+#else
+            uint32_t slots = 1;
+            while (slots < capacity)
+                slots <<= 1;
+            mBytes = shmTraceBytes(slots);
+
+            int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+            if (fd < 0)
+                throw std::runtime_error("Failed to create the shared memory " + name);
+            if (ftruncate(fd, mBytes) != 0) {
+                close(fd);
+                shm_unlink(name.c_str());
+                throw std::runtime_error("Failed to size the shared memory " + name);
+            }
+            void *memory = mmap(NULL, mBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (memory == MAP_FAILED) {
+                shm_unlink(name.c_str());
+                throw std::runtime_error("Failed to map the shared memory " + name);
+            }
+
+            // The memory is zeroed by ftruncate, the magic tells the viewer the rest is set
+            mHeader = new (memory) SHM_TRACE_HEADER();
+            mWords = reinterpret_cast<std::atomic<int64_t> *>(mHeader + 1);
+            mMask = slots - 1;
+            mHeader->version = gSHM_TRACE_VERSION;
+            mHeader->capacity = slots;
+            mHeader->magic.store(gFEED_MAGIC, std::memory_order_release);
+#endif
+        }
+
+        ~ShmTraceWriter()
+        {
+#ifndef _WIN32
+            if (mHeader != NULL) {
+                mHeader->closed.store(1, std::memory_order_release);
+                munmap(mHeader, mBytes);
+                shm_unlink(mName.c_str());
+            }
+#endif
+        }
+
+        ShmTraceWriter(const ShmTraceWriter &) = delete;
+        ShmTraceWriter &operator=(const ShmTraceWriter &) = delete;
+
+        /*!
+         * @brief Starts tracing the sort of an array, sending its elements
+         * @details The array must stay valid until end(), its elements are sent again when the viewer
+         *          asks. T is int32_t, int64_t, uint64_t, float or double.
+         */
+        template <typename T>
+        void begin(const T *array, int n)
+        {
+            static_assert(elementType<T>() >= 0, "The visualizer shows int32_t, int64_t, uint64_t, float and double arrays");
+
+            mArray = array;
+            mElementType = elementType<T>();
+            mElementBytes = sizeof(T);
+            mSize = n;
+            mComparisons = 0;
+            mSwaps = 0;
+            snapshot();
+        }
+
+        /*!
+         * @brief Traces a comparison of the elements at i and j
+         */
+        void compare(int i, int j)
+        {
+            checkResync();
+            mComparisons++;
+            publish(FEED_COMPARE, i, j);
+        }
+
+        /*!
+         * @brief Traces a swap of the elements at i and j, after they are swapped in the array
+         */
+        void swap(int i, int j)
+        {
+            // An array sent now already holds the swap, it's sent as it was before
+            checkResync(i, j);
+            mSwaps++;
+            publish(FEED_SWAP, i, j);
+        }
+
+        /*!
+         * @brief Traces a write of a value at i, after it's stored in the array
+         */
+        template <typename T>
+        void write(int i, const T &value)
+        {
+            checkResync();
+            mSwaps++;
+            publish(FEED_WRITE, i, bits(&value, sizeof(T)));
+        }
+
+        /*!
+         * @brief Ends the sort, the array isn't read anymore
+         */
+        void end()
+        {
+            publish(FEED_COMPARISONS, 0, mComparisons);
+            publish(FEED_SWAPS, 0, mSwaps);
+            publish(FEED_END, 0, 0);
+            mArray = NULL;
+        }
+
+    private:
+        std::string mName;
+        size_t mBytes = 0;
+        SHM_TRACE_HEADER *mHeader = NULL;
+        std::atomic<int64_t> *mWords = NULL;
+        uint64_t mMask = 0;
+        uint64_t mNext = 0; /*! The index of the next record, only this thread writes the counters */
+
+        const void *mArray = NULL; /*! The array being sorted, NULL outside of begin() and end() */
+        int mElementType = 0;
+        int mElementBytes = 0;
+        int mSize = 0;
+        int64_t mComparisons = 0;
+        int64_t mSwaps = 0;
+
+        // The ELEMENT_TYPE of T, -1 if the visualizer can't show it
+        template <typename T>
+        static constexpr int elementType()
+        {
+            return std::is_same<T, int32_t>::value ? 0 : std::is_same<T, int64_t>::value ? 1 : std::is_same<T, uint64_t>::value ? 2
+                 : std::is_same<T, float>::value ? 3 : std::is_same<T, double>::value ? 4 : -1;
+        }
+
+        static int64_t bits(const void *value, size_t bytes)
+        {
+            int64_t word = 0;
+            std::memcpy(&word, value, bytes);
+            return word;
+        }
+
+        /*!
+         * @brief Stores a record in the ring and publishes it
+         * @details The reserved count moves first, so a viewer that read the slot while it was
+         *          overwritten sees that it may be torn.
+         */
+        void publish(FEED_KIND kind, int32_t i, int64_t a)
+        {
+            FEED_RECORD record = {(uint8_t)kind, {}, i, a};
+            int64_t words[2];
+            std::memcpy(words, &record, sizeof(record));
+
+            mHeader->reserved.store(mNext + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            mWords[(mNext & mMask) * 2].store(words[0], std::memory_order_relaxed);
+            mWords[(mNext & mMask) * 2 + 1].store(words[1], std::memory_order_relaxed);
+            mHeader->head.store(++mNext, std::memory_order_release);
+        }
+
+        void checkResync(int swappedI = -1, int swappedJ = -1)
+        {
+            if (mHeader->resync.load(std::memory_order_relaxed) != 0 && mArray != NULL)
+                snapshot(swappedI, swappedJ);
+        }
+
+        /*!
+         * @brief Sends the array and the counters, what a viewer needs to pick up the sort
+         * @details The elements at swappedI and swappedJ are sent exchanged, undoing a swap the
+         *          record about to be published applies again.
+         */
+        void snapshot(int swappedI = -1, int swappedJ = -1)
+        {
+            mHeader->resync.store(0, std::memory_order_relaxed);
+            publish(FEED_BEGIN, mElementType, mSize);
+            for (int i = 0; i < mSize; i++) {
+                int source = i == swappedI ? swappedJ : i == swappedJ ? swappedI : i;
+                publish(FEED_VALUE, i, bits((const char *)mArray + (size_t)source * mElementBytes, mElementBytes));
+            }
+            publish(FEED_COMPARISONS, 0, mComparisons);
+            publish(FEED_SWAPS, 0, mSwaps);
+        }
+    };
+
+    /*!
+     * @brief Reads the ring of a traced program, the attach mode of the engine
+     */
+    class ShmTraceReader
+    {
+    public:
+        /*!
+         * @brief ShmTraceReader constructor, maps the shared memory of a running ShmTraceWriter
+         * @throws std::runtime_error if no program traces under that name
+         */
+        ShmTraceReader(const std::string &name)
+        {
+#ifdef _WIN32
+            throw std::runtime_error("Shared memory tracing needs a POSIX system");
+#else
+            int fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0)
+                throw std::runtime_error("No program traces its sort on " + name);
+
+            // The header tells the size of the ring
+            void *header = mmap(NULL, sizeof(SHM_TRACE_HEADER), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (header == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Failed to map the shared memory " + name);
+            }
+            int64_t magic = static_cast<SHM_TRACE_HEADER *>(header)->magic.load(std::memory_order_acquire);
+            uint32_t capacity = static_cast<SHM_TRACE_HEADER *>(header)->capacity;
+            int32_t version = static_cast<SHM_TRACE_HEADER *>(header)->version;
+            munmap(header, sizeof(SHM_TRACE_HEADER));
+
+            if (magic != gFEED_MAGIC || version != gSHM_TRACE_VERSION || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+                close(fd);
+                throw std::runtime_error("The shared memory " + name + " doesn't hold a compatible trace");
+            }
+
+            mBytes = shmTraceBytes(capacity);
+            void *memory = mmap(NULL, mBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (memory == MAP_FAILED)
+                throw std::runtime_error("Failed to map the shared memory " + name);
+
+            mHeader = static_cast<SHM_TRACE_HEADER *>(memory);
+            mWords = reinterpret_cast<std::atomic<int64_t> *>(mHeader + 1);
+            mCapacity = capacity;
+
+            // Starts from the current array rather than from records long overwritten
+            mCursor = mHeader->head.load(std::memory_order_acquire);
+            mHeader->resync.store(1, std::memory_order_relaxed);
+#endif
+        }
+
+        ~ShmTraceReader()
+        {
+#ifndef _WIN32
+            if (mHeader != NULL)
+                munmap(mHeader, mBytes);
+#endif
+        }
+
+        ShmTraceReader(const ShmTraceReader &) = delete;
+        ShmTraceReader &operator=(const ShmTraceReader &) = delete;
+
+        /*!
+         * @brief Appends the records published since the last call, without waiting
+         * @details When the program lapped the viewer the records are dropped and the array is
+         *          asked for again, the records then start with its FEED_BEGIN.
+         * @return false once the program stopped tracing
+         */
+        bool receive(std::vector<FEED_RECORD> &records)
+        {
+            // Read first, so the records published before the program stopped are all in
+            bool open = mHeader->closed.load(std::memory_order_acquire) == 0;
+            uint64_t head = mHeader->head.load(std::memory_order_acquire);
+            size_t first = records.size();
+
+            if (head - mCursor <= mCapacity) {
+                records.resize(first + (head - mCursor));
+                for (uint64_t index = mCursor; index < head; index++) {
+                    int64_t words[2] = {mWords[(index & (mCapacity - 1)) * 2].load(std::memory_order_relaxed),
+                                        mWords[(index & (mCapacity - 1)) * 2 + 1].load(std::memory_order_relaxed)};
+                    std::memcpy(&records[first + (index - mCursor)], words, sizeof(FEED_RECORD));
+                }
+            }
+
+            // The oldest records read may have been overwritten meanwhile
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (mHeader->reserved.load(std::memory_order_relaxed) - mCursor > mCapacity) {
+                records.resize(first);
+                mHeader->resync.store(1, std::memory_order_relaxed);
+                mWaitingBegin = true;
+            }
+            mCursor = head;
+
+            // After a resync everything up to the new FEED_BEGIN belongs to the lost stretch
+            if (mWaitingBegin) {
+                auto begin = std::find_if(records.begin() + first, records.end(), [](const FEED_RECORD &record) { return record.kind == FEED_BEGIN; });
+                mWaitingBegin = begin == records.end();
+                records.erase(records.begin() + first, begin);
+            }
+
+            return open;
+        }
+
+    private:
+        size_t mBytes = 0;
+        SHM_TRACE_HEADER *mHeader = NULL;
+        std::atomic<int64_t> *mWords = NULL;
+        uint32_t mCapacity = 0;
+        uint64_t mCursor = 0;       /*! The index of the next record to read */
+        bool mWaitingBegin = true;  /*! Whether the records are skipped until the array is sent again */
+    };
+}
+
+#endif /* ShmTrace_hpp */
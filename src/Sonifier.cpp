@@ -0,0 +1,129 @@
+//
+//  Sonifier.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+#include "Sonifier.hpp"
+
+namespace
+{
+    const double TWO_PI = 6.283185307179586;
+}
+
+Visualizer::Sonifier::~Sonifier()
+{
+    close();
+}
+
+bool Visualizer::Sonifier::open()
+{
+    if (isOpen())
+        return true;
+
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        printf("Warning: SDL audio could not initialize! SDL error: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_AudioSpec desired = {};
+    desired.freq = 44100;
+    desired.format = AUDIO_F32SYS;
+    desired.channels = 1;
+    desired.samples = 512;
+    desired.callback = &Sonifier::callback;
+    desired.userdata = this;
+
+    SDL_AudioSpec obtained;
+    mDevice = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+    if (mDevice == 0) {
+        printf("Warning: audio device could not be opened! SDL error: %s\n", SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+
+    mSampleRate = obtained.freq;
+    SDL_PauseAudioDevice(mDevice, 0);
+    return true;
+}
+
+void Visualizer::Sonifier::close()
+{
+    if (!isOpen())
+        return;
+
+    // Once closed the callback doesn't run anymore
+    SDL_CloseAudioDevice(mDevice);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    mDevice = 0;
+
+    // Drop the tones left
+    float pitch;
+    while (mTones.pop(pitch))
+        ;
+}
+
+void Visualizer::Sonifier::beginFrame()
+{
+    mStride = 1;
+    mCounter = 0;
+    mBudget = gTONES_PER_FRAME;
+}
+
+void Visualizer::Sonifier::play(float pitch)
+{
+    if (!isOpen() || mCounter++ % mStride != 0)
+        return;
+
+    // Every time the budget runs out the stride doubles and the budget halves, so a frame
+    // queues at most about twice gTONES_PER_FRAME tones however many operations it runs
+    if (--mBudget == 0 && mStride < (1 << 30)) {
+        mStride *= 2;
+        mCounter = 0;
+        mBudget = std::max(1, gTONES_PER_FRAME / mStride);
+    }
+
+    // A full ring drops the tone, the sort never waits for the audio
+    mTones.push(pitch);
+}
+
+void Visualizer::Sonifier::callback(void *userdata, Uint8 *stream, int len)
+{
+    static_cast<Sonifier *>(userdata)->render(reinterpret_cast<float *>(stream), len / sizeof(float));
+}
+
+void Visualizer::Sonifier::render(float *samples, int count)
+{
+    // The queued tones share the buffer, each lasting between 1 and 40ms
+    int queued = std::max<int>(mTones.size(), 1);
+    int toneSamples = std::clamp(count / queued, mSampleRate / 1000, mSampleRate / 25);
+
+    for (int s = 0; s < count; s++) {
+        if (mToneLeft == 0) {
+            float pitch;
+            if (mTones.pop(pitch)) {
+                // A decade from 120Hz to 1200Hz
+                mFrequency = 120.0 * std::pow(10.0, pitch);
+                mToneLeft = toneSamples;
+            }
+        }
+
+        // The envelope follows whether a tone is playing, fading out when the ring is empty
+        float target = mToneLeft > 0 ? 1.0f : 0.0f;
+        mLevel += (target - mLevel) * 0.01f;
+
+        samples[s] = 0.2f * mLevel * (float)std::sin(mPhase);
+
+        mPhase += TWO_PI * mFrequency / mSampleRate;
+        if (mPhase > TWO_PI)
+            mPhase -= TWO_PI;
+
+        if (mToneLeft > 0)
+            mToneLeft--;
+    }
+}
@@ -0,0 +1,85 @@
+//
+//  Sonifier.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Sonifier_hpp
+#define Sonifier_hpp
+
+#include <SDL2/SDL.h>
+
+#include "Utilities.hpp"
+#include "SpscRing.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Plays a short tone for each operation of the sort, pitched by the value of the element
+     * @details The engine pushes the pitches into a wait-free ring and the SDL audio callback
+     *          pops them, so the callback never allocates, locks or waits. The length of the
+     *          tones adapts to the number queued, and when the ring runs dry the callback fades
+     *          to silence instead of underrunning.
+     */
+    class Sonifier
+    {
+    public:
+        ~Sonifier();
+
+        /*!
+         * @brief Opens the default audio device and starts playing
+         * @return false if no device could be opened
+         */
+        bool open();
+
+        /*!
+         * @brief Stops playing and closes the device
+         */
+        void close();
+
+        /*!
+         * @brief Whether the device is open
+         */
+        bool isOpen() const { return mDevice != 0; }
+
+        /*!
+         * @brief Resets the decimation, called before the operations of a frame
+         */
+        void beginFrame();
+
+        /*!
+         * @brief Queues a tone, decimated once the frame has queued gTONES_PER_FRAME of them
+         * @param pitch The height of the tone in [0, 1]
+         */
+        void play(float pitch);
+
+    private:
+        SpscRing<float, 4096> mTones; /*! The pitches waiting to be played */
+        SDL_AudioDeviceID mDevice = 0; /*! The open audio device, 0 if closed */
+        int mSampleRate = 44100;       /*! The sample rate obtained from the device */
+
+        // Producer side, touched by the engine only
+        int mStride = 1;  /*! One operation out of mStride is played */
+        long long mCounter = 0; /*! The operations since the stride last changed */
+        int mBudget = gTONES_PER_FRAME; /*! The tones left before the stride doubles */
+
+        // Consumer side, touched by the audio callback only
+        double mPhase = 0.0;     /*! The phase of the oscillator in radians */
+        double mFrequency = 0.0; /*! The frequency of the tone being played */
+        int mToneLeft = 0;       /*! The samples left to the tone being played */
+        float mLevel = 0.0f;     /*! The envelope, smoothed to avoid clicks */
+
+        /*!
+         * @brief The SDL audio callback
+         */
+        static void callback(void *userdata, Uint8 *stream, int len);
+
+        /*!
+         * @brief Synthesizes the next samples
+         */
+        void render(float *samples, int count);
+    };
+}
+
+#endif /* Sonifier_hpp */
@@ -0,0 +1,63 @@
+/*
+ *  SortPlugin.h
+ *  SDL_Sort_Visualizer
+ *
+ *  Created by Emiliano Iacopini on 10/18/26.
+ *
+ *  C ABI of the sort plugins. A plugin is a shared object placed in the plugins directory
+ *  that exports SV_PLUGIN_ENTRY (sv_plugin_descriptor) returning its descriptor.
+ *
+ *  The plugin never sees the elements: it sorts through the callbacks of sv_array, which is
+ *  what lets the engine count, visualize and benchmark it like the built-in algorithms.
+ *  Indices in [size, size + scratch) address scratch slots the plugin can move elements to.
+ */
+
+#ifndef SortPlugin_h
+#define SortPlugin_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SV_PLUGIN_ABI_VERSION 1
+#define SV_PLUGIN_ENTRY "sv_plugin_descriptor"
+
+/* The array handed to the sort function of a plugin */
+typedef struct sv_array
+{
+    void *context;  /* Opaque pointer to pass back to the callbacks */
+    size_t size;    /* The number of elements to sort */
+    size_t scratch; /* The number of scratch slots, addressed after the elements */
+
+    /* Returns non zero if the element at i orders before the element at j */
+    int (*less)(void *context, size_t i, size_t j);
+    /* Swaps the elements at i and j */
+    void (*swap)(void *context, size_t i, size_t j);
+    /* Copies the element at from over the element at to */
+    void (*move)(void *context, size_t to, size_t from);
+} sv_array;
+
+/* The descriptor returned by SV_PLUGIN_ENTRY, it must stay valid while the plugin is loaded */
+typedef struct sv_plugin
+{
+    uint32_t abi_version; /* Must be SV_PLUGIN_ABI_VERSION */
+    const char *name;     /* The name shown in the window, e.g. "Comb Sort" */
+    const char *key;      /* The name used on the command line, e.g. "comb" */
+    char hotkey;          /* The lowercase key selecting the algorithm in the window, 0 for none */
+
+    /* Returns the number of scratch slots needed to sort size elements, may be NULL */
+    size_t (*scratch_size)(size_t size);
+    /* Sorts the array */
+    void (*sort)(const sv_array *array);
+} sv_plugin;
+
+typedef const sv_plugin *(*sv_plugin_entry)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SortPlugin_h */
@@ -0,0 +1,129 @@
+//
+//  SortingNetworks.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef SortingNetworks_hpp
+#define SortingNetworks_hpp
+
+#include <array>
+#include <utility>
+#include <cstddef>
+
+namespace Visualizer
+{
+    /*!
+     * @brief A compare-exchange of a sorting network, puts the smaller element at i
+     */
+    typedef struct COMPARATOR
+    {
+        int i;
+        int j; /*! Always greater than i */
+    } COMPARATOR;
+
+    /*!
+     * @brief A network generated at compile time
+     */
+    typedef struct NETWORK
+    {
+        const COMPARATOR *comparators;
+        int size;
+    } NETWORK;
+
+    // The largest network generated at compile time
+    const int gMAX_NETWORK_SIZE = 32;
+
+    /*!
+     * @brief Generates the comparators of Batcher's merge exchange network for n elements
+     * @details Knuth's Algorithm 5.2.2M, which works for any n and not only powers of two. The
+     *          comparators come out layer after layer, those of a layer touching distinct elements.
+     *          Usable at compile time and at runtime.
+     * @param n The number of elements
+     * @param emit Called with the two indices of every comparator, in order
+     */
+    template <typename Emit>
+    constexpr void mergeExchangeNetwork(int n, Emit emit)
+    {
+        if (n < 2)
+            return;
+
+        int t = 0;
+        while ((1 << t) < n)
+            t++;
+
+        for (int p = 1 << (t - 1); p > 0; p >>= 1) {
+            int q = 1 << (t - 1);
+            int r = 0;
+            int d = p;
+
+            while (true) {
+                for (int i = 0; i < n - d; i++)
+                    if ((i & p) == r)
+                        emit(i, i + d);
+
+                if (q == p)
+                    break;
+                d = q - p;
+                q >>= 1;
+                r = p;
+            }
+        }
+    }
+
+    /*!
+     * @brief The number of comparators of the network for n elements
+     */
+    constexpr int networkSize(int n)
+    {
+        int size = 0;
+        mergeExchangeNetwork(n, [&size](int, int) { size++; });
+        return size;
+    }
+
+    /*!
+     * @brief Builds the comparators of the network for N elements
+     */
+    template <int N>
+    constexpr std::array<COMPARATOR, networkSize(N)> makeNetwork()
+    {
+        std::array<COMPARATOR, networkSize(N)> network{};
+        int k = 0;
+        mergeExchangeNetwork(N, [&network, &k](int i, int j) { network[k++] = COMPARATOR{i, j}; });
+        return network;
+    }
+
+    template <int N>
+    inline constexpr std::array<COMPARATOR, networkSize(N)> gNETWORK = makeNetwork<N>();
+
+    template <std::size_t... N>
+    constexpr std::array<NETWORK, sizeof...(N)> makeNetworkTable(std::index_sequence<N...>)
+    {
+        return {NETWORK{gNETWORK<N>.data(), (int)gNETWORK<N>.size()}...};
+    }
+
+    /*!
+     * @brief The networks for 0 to gMAX_NETWORK_SIZE elements, all built by the compiler
+     */
+    inline constexpr std::array<NETWORK, gMAX_NETWORK_SIZE + 1> gNETWORKS = makeNetworkTable(std::make_index_sequence<gMAX_NETWORK_SIZE + 1>());
+
+    /*!
+     * @brief Orders two elements without branching on the comparison
+     * @details Both outcomes are selected with conditional moves, so the branch predictor has
+     *          nothing to mispredict on random data.
+     * @return Whether the elements were exchanged
+     */
+    template <typename T, typename Compare>
+    inline bool compareExchange(T &a, T &b, Compare less)
+    {
+        bool swap = less(b, a);
+        T low = swap ? b : a;
+        T high = swap ? a : b;
+        a = low;
+        b = high;
+        return swap;
+    }
+}
+
+#endif /* SortingNetworks_hpp */
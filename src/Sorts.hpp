@@ -0,0 +1,1503 @@
+//
+//  Sorts.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Sorts_hpp
+#define Sorts_hpp
+
+#include <vector>
+#include <utility>
+#include <cmath>
+#include <algorithm>
+
+#include "Utilities.hpp"
+#include "Generator.hpp"
+#include "MemoryTracker.hpp"
+#include "SortingNetworks.hpp"
+
+/*
+ * Every algorithm is a coroutine templated over the element type and the comparator (a strict
+ * weak ordering, see TotalLess). It sorts the array in place and co_yields a SORT_OP right after
+ * every compare, swap, write or read into a temporary, so whoever drives it decides how many
+ * operations run per frame.
+ * Recursive algorithms recurse by co_yielding the generator of the sub-problem.
+ */
+
+namespace Visualizer
+{
+    typedef Generator<SORT_OP> SortGenerator;
+
+    /*!
+     * @brief Runs the comparators of a network on the elements starting at an offset
+     * @param offset The index of the first element covered by the network
+     */
+    template <typename T, typename Compare>
+    SortGenerator runNetwork(std::vector<T> &array, int offset, const COMPARATOR *comparators, int size, Compare less)
+    {
+        for (int c = 0; c < size; c++) {
+            int i = offset + comparators[c].i;
+            int j = offset + comparators[c].j;
+
+            co_yield SORT_OP{COMPARE_OP, i, j};
+            if (compareExchange(array[i], array[j], less))
+                co_yield SORT_OP{SWAP_OP, i, j};
+        }
+    }
+
+    /*!
+     * @brief Sorts array[low..high] with the compile-time network of its size, used as a base case
+     * @param low The lower bound of the array
+     * @param high The upper bound of the array, at most gMAX_NETWORK_SIZE - 1 elements after low
+     */
+    template <typename T, typename Compare>
+    SortGenerator smallSort(std::vector<T> &array, int low, int high, Compare less)
+    {
+        const NETWORK &network = gNETWORKS[high - low + 1];
+        co_yield runNetwork(array, low, network.comparators, network.size, less);
+    }
+
+    /*!
+     * @brief Sorts the array using a sorting network (Batcher's merge exchange)
+     * @details Arrays up to gMAX_NETWORK_SIZE elements use the networks built at compile time,
+     *          larger ones generate the same network at runtime.
+     */
+    template <typename T, typename Compare>
+    SortGenerator sortingNetwork(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+
+        if (n <= gMAX_NETWORK_SIZE) {
+            co_yield smallSort(array, 0, n - 1, less);
+            co_return;
+        }
+
+        TrackedVector<COMPARATOR> network;
+        mergeExchangeNetwork(n, [&network](int i, int j) { network.push_back(COMPARATOR{i, j}); });
+        co_yield runNetwork(array, 0, network.data(), (int)network.size(), less);
+    }
+
+    /*!
+     * @brief Sorts the array using bubble sort
+     */
+    template <typename T, typename Compare>
+    SortGenerator bubbleSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+        bool swapped;
+
+        for (int i = 0; i < n - 1; i++) {
+            swapped = false;
+            for (int j = 0; j < n - i - 1; j++) {
+                co_yield SORT_OP{COMPARE_OP, j, j + 1};
+                if (less(array[j + 1], array[j])) {
+                    std::swap(array[j], array[j + 1]);
+                    swapped = true;
+                    co_yield SORT_OP{SWAP_OP, j, j + 1};
+                }
+            }
+
+            if (!swapped) break;
+        }
+    }
+
+    /*!
+     * @brief Sorts the array using cocktail sort
+     */
+    template <typename T, typename Compare>
+    SortGenerator cocktailSort(std::vector<T> &array, Compare less)
+    {
+        bool swapped = true;
+        int start = 0;
+        int end = array.size() - 1;
+
+        while (swapped) {
+            swapped = false;
+
+            for (int i = start; i < end; ++i) {
+                co_yield SORT_OP{COMPARE_OP, i, i + 1};
+                if (less(array[i + 1], array[i])) {
+                    std::swap(array[i], array[i + 1]);
+                    swapped = true;
+                    co_yield SORT_OP{SWAP_OP, i, i + 1};
+                }
+            }
+            if (!swapped)
+                break;
+
+            swapped = false;
+            end--;
+
+            for (int i = end - 1; i >= start; --i) {
+                co_yield SORT_OP{COMPARE_OP, i, i + 1};
+                if (less(array[i + 1], array[i])) {
+                    std::swap(array[i], array[i + 1]);
+                    swapped = true;
+                    co_yield SORT_OP{SWAP_OP, i + 1, i};
+                }
+            }
+
+            start++;
+        }
+    }
+
+    /*!
+     * @brief Utility function used by quick sort (Lomuto partition around the last element)
+     * @param low The lower bound of the array
+     * @param high The upper bound of the array
+     * @param pivotIndex Set to the final position of the pivot
+     */
+    template <typename T, typename Compare>
+    SortGenerator partition(std::vector<T> &array, int low, int high, Compare less, int &pivotIndex)
+    {
+        T pivot = array[high];
+        co_yield SORT_OP{READ_OP, high, -1};
+        int i = (low - 1);
+
+        for (int j = low; j <= high - 1; j++) {
+            co_yield SORT_OP{COMPARE_OP, j, high};
+            if (less(array[j], pivot)) {
+                i++;
+                std::swap(array[i], array[j]);
+                co_yield SORT_OP{SWAP_OP, i, j};
+            }
+        }
+        std::swap(array[i + 1], array[high]);
+        co_yield SORT_OP{SWAP_OP, i + 1, high};
+
+        pivotIndex = i + 1;
+    }
+
+    /*!
+     * @brief Sorts the array using quick sort
+     * @param low The lower bound of the array
+     * @param high The upper bound of the array
+     * @param cutoff Partitions of up to this many elements are sorted by a network (0 to recurse to the end)
+     */
+    template <typename T, typename Compare>
+    SortGenerator quickSort(std::vector<T> &array, int low, int high, Compare less, int cutoff = 0)
+    {
+        if (low < high && high - low + 1 <= cutoff)
+            co_yield smallSort(array, low, high, less);
+        else if (low < high) {
+            int pi;
+            co_yield partition(array, low, high, less, pi);
+
+            co_yield quickSort(array, low, pi - 1, less, cutoff);
+            co_yield quickSort(array, pi + 1, high, less, cutoff);
+        }
+    }
+
+    /*!
+     * @brief The gaps of shell sort for n elements, in decreasing order and ending with 1
+     */
+    inline std::vector<int> shellGaps(int n, GAP_SEQUENCE sequence)
+    {
+        std::vector<long long> gaps;
+
+        switch (sequence) {
+            case SHELL_GAPS:
+                for (long long gap = n / 2; gap > 0; gap /= 2)
+                    gaps.push_back(gap);
+                break;
+            case KNUTH_GAPS:
+                // Gaps above n/3 only compare a few pairs each
+                for (long long gap = 1; gap == 1 || gap <= n / 3; gap = 3 * gap + 1)
+                    gaps.push_back(gap);
+                break;
+            case SEDGEWICK_GAPS:
+                gaps.push_back(1);
+                for (long long power = 2; gaps.back() < n; power *= 2)
+                    gaps.push_back(power * power + 3 * power / 2 + 1);
+                break;
+            case TOKUDA_GAPS:
+                for (double gap = 1.0; (long long)std::ceil(gap) < std::max(n, 2); gap = 2.25 * gap + 1.0)
+                    gaps.push_back((long long)std::ceil(gap));
+                break;
+            case CIURA_GAPS:
+                // Found experimentally up to 1750, extended geometrically
+                for (long long gap : {1, 4, 10, 23, 57, 132, 301, 701, 1750})
+                    gaps.push_back(gap);
+                while (gaps.back() < n)
+                    gaps.push_back((long long)(gaps.back() * 2.25));
+                break;
+            case PRATT_GAPS:
+                for (long long two = 1; two == 1 || two < n; two *= 2)
+                    for (long long gap = two; gap == 1 || gap < n; gap *= 3)
+                        gaps.push_back(gap);
+                break;
+        }
+        std::sort(gaps.begin(), gaps.end());
+
+        // Gaps of n or more compare nothing
+        std::vector<int> result;
+        for (auto gap = gaps.rbegin(); gap != gaps.rend(); gap++)
+            if (*gap < n || *gap == 1)
+                result.push_back(*gap);
+        return result;
+    }
+
+    /*!
+     * @brief Sorts the array using shell sort
+     * @param sequence The gap sequence, every gap is an insertion sort of the elements that far apart
+     */
+    template <typename T, typename Compare>
+    SortGenerator shellSort(std::vector<T> &array, Compare less, GAP_SEQUENCE sequence = SHELL_GAPS)
+    {
+        int n = array.size();
+
+        for (int gap : shellGaps(n, sequence)) {
+
+            for (int i = gap; i < n; i += 1) {
+
+                T temp = array[i];
+                co_yield SORT_OP{READ_OP, i, -1};
+                int j;
+
+                for (j = i; j >= gap; j -= gap) {
+                    co_yield SORT_OP{COMPARE_OP, j - gap, j};
+                    if (!less(temp, array[j - gap]))
+                        break;
+                    array[j] = array[j - gap];
+                    co_yield SORT_OP{WRITE_OP, j, j - gap};
+                }
+
+                if (j != i) {
+                    array[j] = temp;
+                    co_yield SORT_OP{WRITE_OP, j, -1};
+                }
+            }
+        }
+    }
+
+    /*!
+     * @brief Utility function used by heap sort
+     * @param n The size of the heap
+     * @param i The index of the array root
+     */
+    template <typename T, typename Compare>
+    SortGenerator heapify(std::vector<T> &array, int n, int i, Compare less)
+    {
+        int largest = i;
+        int l = 2 * i + 1;
+        int r = 2 * i + 2;
+
+        if (l < n) {
+            co_yield SORT_OP{COMPARE_OP, l, largest};
+            if (less(array[largest], array[l]))
+                largest = l;
+        }
+
+        if (r < n) {
+            co_yield SORT_OP{COMPARE_OP, r, largest};
+            if (less(array[largest], array[r]))
+                largest = r;
+        }
+
+        if (largest != i) {
+            std::swap(array[i], array[largest]);
+            co_yield SORT_OP{SWAP_OP, i, largest};
+            co_yield heapify(array, n, largest, less);
+        }
+    }
+
+    /*!
+     * @brief Sorts the array using heap sort
+     */
+    template <typename T, typename Compare>
+    SortGenerator heapSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+
+        for (int i = n / 2 - 1; i >= 0; i--)
+            co_yield heapify(array, n, i, less);
+
+        for (int i = n - 1; i > 0; i--) {
+
+            std::swap(array[0], array[i]);
+            co_yield SORT_OP{SWAP_OP, 0, i};
+
+            co_yield heapify(array, i, 0, less);
+        }
+    }
+
+    /*!
+     * @brief Utility function used by bottom-up heap sort, sifts the element at i down the heap of n elements
+     * @details Floyd's trick: the path of the larger children is followed down to a leaf with one
+     *          comparison per level, then climbed back up to where the element belongs. Most
+     *          elements end near the leaves, so this takes about half the comparisons of heapify.
+     */
+    template <typename T, typename Compare>
+    SortGenerator siftBottomUp(std::vector<T> &array, int n, int i, Compare less)
+    {
+        int j = i;
+        while (2 * j + 2 < n) {
+            co_yield SORT_OP{COMPARE_OP, 2 * j + 1, 2 * j + 2};
+            j = less(array[2 * j + 1], array[2 * j + 2]) ? 2 * j + 2 : 2 * j + 1;
+        }
+        if (2 * j + 1 < n)
+            j = 2 * j + 1;
+
+        while (j != i) {
+            co_yield SORT_OP{COMPARE_OP, j, i};
+            if (!less(array[j], array[i]))
+                break;
+            j = (j - 1) / 2;
+        }
+        if (j == i)
+            co_return;
+
+        // The path from i to j moves up one level and the element takes the place of j
+        int path[32];
+        int depth = 0;
+        for (int k = j; k != i; k = (k - 1) / 2)
+            path[depth++] = k;
+
+        T value = array[i];
+        co_yield SORT_OP{READ_OP, i, -1};
+        int hole = i;
+        while (depth > 0) {
+            int child = path[--depth];
+            array[hole] = array[child];
+            co_yield SORT_OP{WRITE_OP, hole, child};
+            hole = child;
+        }
+        array[hole] = value;
+        co_yield SORT_OP{WRITE_OP, hole, -1};
+    }
+
+    /*!
+     * @brief Sorts the array using bottom-up heap sort
+     */
+    template <typename T, typename Compare>
+    SortGenerator bottomUpHeapSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+
+        for (int i = n / 2 - 1; i >= 0; i--)
+            co_yield siftBottomUp(array, n, i, less);
+
+        for (int i = n - 1; i > 0; i--) {
+            std::swap(array[0], array[i]);
+            co_yield SORT_OP{SWAP_OP, 0, i};
+
+            co_yield siftBottomUp(array, i, 0, less);
+        }
+    }
+
+    /*!
+     * @brief Utility function used by d-ary heap sort, sifts the element at i down the heap of n elements
+     * @details The children of k are d k + 1 to d k + d, next to each other, so the d - 1
+     *          comparisons picking the largest one read a single cache line or two. The element
+     *          is held aside while the larger children move up into the hole.
+     * @param base The index of the root, the heap is array[base, base + n)
+     */
+    template <typename T, typename Compare>
+    SortGenerator siftDown(std::vector<T> &array, int n, int i, int d, Compare less, int base = 0)
+    {
+        T value = array[base + i];
+        co_yield SORT_OP{READ_OP, base + i, -1};
+        int hole = i;
+
+        while (true) {
+            int first = d * hole + 1;
+            if (first >= n)
+                break;
+
+            int largest = first;
+            for (int child = first + 1; child < std::min(first + d, n); child++) {
+                co_yield SORT_OP{COMPARE_OP, base + largest, base + child};
+                if (less(array[base + largest], array[base + child]))
+                    largest = child;
+            }
+
+            co_yield SORT_OP{COMPARE_OP, -1, base + largest};
+            if (!less(value, array[base + largest]))
+                break;
+
+            array[base + hole] = array[base + largest];
+            co_yield SORT_OP{WRITE_OP, base + hole, base + largest};
+            hole = largest;
+        }
+
+        if (hole != i) {
+            array[base + hole] = value;
+            co_yield SORT_OP{WRITE_OP, base + hole, -1};
+        }
+    }
+
+    /*!
+     * @brief Sorts the array using heap sort on a heap where every node has d children
+     * @details A wider heap is shallower (log_d n levels) and its siblings share cache lines,
+     *          at the price of more comparisons per level.
+     */
+    template <typename T, typename Compare>
+    SortGenerator dAryHeapSort(std::vector<T> &array, int d, Compare less)
+    {
+        int n = array.size();
+
+        for (int i = (n - 2) / d; i >= 0 && n > 1; i--)
+            co_yield siftDown(array, n, i, d, less);
+
+        for (int i = n - 1; i > 0; i--) {
+            std::swap(array[0], array[i]);
+            co_yield SORT_OP{SWAP_OP, 0, i};
+
+            co_yield siftDown(array, i, 0, d, less);
+        }
+    }
+
+    /*!
+     * @brief Utility function used as a fallback by the introspective algorithms, heap sorts [begin, end)
+     */
+    template <typename T, typename Compare>
+    SortGenerator heapSortRange(std::vector<T> &array, int begin, int end, Compare less)
+    {
+        int n = end - begin;
+        for (int i = (n - 2) / 2; i >= 0; i--)
+            co_yield siftDown(array, n, i, 2, less, begin);
+
+        for (int i = n - 1; i > 0; i--) {
+            std::swap(array[begin], array[begin + i]);
+            co_yield SORT_OP{SWAP_OP, begin, begin + i};
+            co_yield siftDown(array, i, 0, 2, less, begin);
+        }
+    }
+
+    /*!
+     * @brief Partitions smaller than this are sorted by insertion by pattern-defeating quick sort
+     */
+    const int gPDQ_INSERTION_SORT = 24;
+
+    /*!
+     * @brief Partitions larger than this take the pseudomedian of 9 as pivot instead of the median of 3
+     */
+    const int gPDQ_NINTHER = 128;
+
+    /*!
+     * @brief The elements a partial insertion sort may move before giving up
+     */
+    const int gPDQ_PARTIAL_INSERTION_LIMIT = 8;
+
+    /*!
+     * @brief The elements classified at a time by the branchless partition, each side
+     */
+    const int gPDQ_BLOCK = 64;
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, sorts [begin, end) by insertion
+     * @param limit The elements that may be moved before giving up, -1 for no limit
+     * @param sorted Set to whether the range was sorted within the limit
+     */
+    template <typename T, typename Compare>
+    SortGenerator pdqInsertionSort(std::vector<T> &array, int begin, int end, Compare less, int limit, bool &sorted)
+    {
+        int moved = 0;
+        sorted = true;
+
+        for (int i = begin + 1; i < end; i++) {
+            int j = i;
+            for (; j > begin; j--) {
+                co_yield SORT_OP{COMPARE_OP, j - 1, j};
+                if (!less(array[j], array[j - 1]))
+                    break;
+                std::swap(array[j], array[j - 1]);
+                co_yield SORT_OP{SWAP_OP, j - 1, j};
+            }
+
+            moved += i - j;
+            if (limit >= 0 && moved > limit) {
+                sorted = false;
+                co_return;
+            }
+        }
+    }
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, orders array[a] <= array[b] <= array[c]
+     */
+    template <typename T, typename Compare>
+    SortGenerator sort3(std::vector<T> &array, int a, int b, int c, Compare less)
+    {
+        int pairs[3][2] = {{a, b}, {b, c}, {a, b}};
+        for (auto &pair : pairs) {
+            co_yield SORT_OP{COMPARE_OP, pair[0], pair[1]};
+            if (less(array[pair[1]], array[pair[0]])) {
+                std::swap(array[pair[0]], array[pair[1]]);
+                co_yield SORT_OP{SWAP_OP, pair[0], pair[1]};
+            }
+        }
+    }
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, partitions [begin, end) around
+     *        array[begin] putting the elements equal to it on the left
+     * @details Used when the pivot equals the element before the partition, which is not greater
+     *          than anything in it: all the elements equal to the pivot end up in place at once.
+     */
+    template <typename T, typename Compare>
+    SortGenerator partitionLeft(std::vector<T> &array, int begin, int end, Compare less, int &pivotIndex)
+    {
+        T pivot = array[begin];
+        int first = begin;
+        int last = end;
+
+        // The pivot at begin stops the scans from the right
+        do {
+            last--;
+            co_yield SORT_OP{COMPARE_OP, begin, last};
+        } while (less(pivot, array[last]));
+
+        if (last + 1 == end) {
+            while (first < last) {
+                first++;
+                co_yield SORT_OP{COMPARE_OP, begin, first};
+                if (less(pivot, array[first]))
+                    break;
+            }
+        }
+        else {
+            do {
+                first++;
+                co_yield SORT_OP{COMPARE_OP, begin, first};
+            } while (!less(pivot, array[first]));
+        }
+
+        while (first < last) {
+            std::swap(array[first], array[last]);
+            co_yield SORT_OP{SWAP_OP, first, last};
+            do {
+                last--;
+                co_yield SORT_OP{COMPARE_OP, begin, last};
+            } while (less(pivot, array[last]));
+            do {
+                first++;
+                co_yield SORT_OP{COMPARE_OP, begin, first};
+            } while (!less(pivot, array[first]));
+        }
+
+        std::swap(array[begin], array[last]);
+        co_yield SORT_OP{SWAP_OP, begin, last};
+        pivotIndex = last;
+    }
+
+    /*!
+     * @brief Utility function used by the branchless partition, moves the elements at the offsets
+     *        from first to the offsets from last and vice versa
+     * @details Equal counts are swapped pairwise, otherwise the elements go around a single cycle,
+     *          one write each instead of the three of a swap.
+     */
+    template <typename T>
+    SortGenerator swapOffsets(std::vector<T> &array, int first, int last, const unsigned char *offsetsL, const unsigned char *offsetsR, int count, bool useSwaps)
+    {
+        if (useSwaps) {
+            for (int k = 0; k < count; k++) {
+                std::swap(array[first + offsetsL[k]], array[last - offsetsR[k]]);
+                co_yield SORT_OP{SWAP_OP, first + offsetsL[k], last - offsetsR[k]};
+            }
+        }
+        else if (count > 0) {
+            int l = first + offsetsL[0];
+            int r = last - offsetsR[0];
+            T temp = array[l];
+            co_yield SORT_OP{READ_OP, l, -1};
+            array[l] = array[r];
+            co_yield SORT_OP{WRITE_OP, l, r};
+
+            for (int k = 1; k < count; k++) {
+                l = first + offsetsL[k];
+                array[r] = array[l];
+                co_yield SORT_OP{WRITE_OP, r, l};
+                r = last - offsetsR[k];
+                array[l] = array[r];
+                co_yield SORT_OP{WRITE_OP, l, r};
+            }
+
+            array[r] = temp;
+            co_yield SORT_OP{WRITE_OP, r, -1};
+        }
+    }
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, classifies the size elements
+     *        from first, storing the offset of each one not less than the pivot
+     * @details The offset is stored unconditionally and the count advanced by the comparison,
+     *          and nothing is yielded, so the loop has no branch on the data.
+     * @return The number of offsets stored
+     */
+    template <typename T, typename Compare>
+    int classifyLeft(const std::vector<T> &array, int first, int size, const T &pivot, Compare less, unsigned char *offsets)
+    {
+        int count = 0;
+        for (int k = 0; k < size; k++) {
+            offsets[count] = k;
+            count += !less(array[first + k], pivot);
+        }
+        return count;
+    }
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, classifies the size elements
+     *        before last, storing the distance from last of each one less than the pivot
+     * @return The number of offsets stored
+     */
+    template <typename T, typename Compare>
+    int classifyRight(const std::vector<T> &array, int last, int size, const T &pivot, Compare less, unsigned char *offsets)
+    {
+        int count = 0;
+        for (int k = 1; k <= size; k++) {
+            offsets[count] = k;
+            count += less(array[last - k], pivot);
+        }
+        return count;
+    }
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, yields the comparisons of a
+     *        block against the pivot once the block is classified
+     * @param step 1 for a block of the left side, -1 for one of the right side
+     */
+    inline SortGenerator compareBlock(int from, int size, int step, int pivot)
+    {
+        for (int k = 0; k < size; k++)
+            co_yield SORT_OP{COMPARE_OP, from + k * step, pivot};
+    }
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, partitions [begin, end) around
+     *        array[begin] putting the elements equal to it on the right
+     * @details BlockQuicksort: the sides are classified a block of gPDQ_BLOCK elements at a time,
+     *          the offsets of the misplaced ones being stored unconditionally and their count
+     *          advanced by the result of the comparison, so there is no branch the predictor can
+     *          miss. The comparisons of a block are yielded after it is classified so the loop
+     *          does not suspend. The misplaced elements are then swapped in a batch.
+     * @param alreadyPartitioned Set to whether no element had to move
+     */
+    template <typename T, typename Compare>
+    SortGenerator partitionRight(std::vector<T> &array, int begin, int end, Compare less, int &pivotIndex, bool &alreadyPartitioned)
+    {
+        T pivot = array[begin];
+        int first = begin;
+        int last = end;
+
+        // The median of 3 left an element not less than the pivot at the end
+        do {
+            first++;
+            co_yield SORT_OP{COMPARE_OP, first, begin};
+        } while (less(array[first], pivot));
+
+        if (first - 1 == begin) {
+            while (first < last) {
+                last--;
+                co_yield SORT_OP{COMPARE_OP, last, begin};
+                if (less(array[last], pivot))
+                    break;
+            }
+        }
+        else {
+            do {
+                last--;
+                co_yield SORT_OP{COMPARE_OP, last, begin};
+            } while (!less(array[last], pivot));
+        }
+
+        alreadyPartitioned = first >= last;
+        if (!alreadyPartitioned) {
+            std::swap(array[first], array[last]);
+            co_yield SORT_OP{SWAP_OP, first, last};
+            first++;
+
+            unsigned char offsetsL[gPDQ_BLOCK];
+            unsigned char offsetsR[gPDQ_BLOCK];
+            int countL = 0, countR = 0;
+            int startL = 0, startR = 0;
+
+            while (last - first > 2 * gPDQ_BLOCK) {
+                if (countL == 0) {
+                    startL = 0;
+                    countL = classifyLeft(array, first, gPDQ_BLOCK, pivot, less, offsetsL);
+                    co_yield compareBlock(first, gPDQ_BLOCK, 1, begin);
+                }
+                if (countR == 0) {
+                    startR = 0;
+                    countR = classifyRight(array, last, gPDQ_BLOCK, pivot, less, offsetsR);
+                    co_yield compareBlock(last - 1, gPDQ_BLOCK, -1, begin);
+                }
+
+                int count = std::min(countL, countR);
+                co_yield swapOffsets(array, first, last, offsetsL + startL, offsetsR + startR, count, countL == countR);
+                countL -= count;
+                countR -= count;
+                startL += count;
+                startR += count;
+                if (countL == 0)
+                    first += gPDQ_BLOCK;
+                if (countR == 0)
+                    last -= gPDQ_BLOCK;
+            }
+
+            // The elements left are split between the sides without a pending block
+            int unknown = (last - first) - ((countL || countR) ? gPDQ_BLOCK : 0);
+            int sizeL, sizeR;
+            if (countR) {
+                sizeL = unknown;
+                sizeR = gPDQ_BLOCK;
+            }
+            else if (countL) {
+                sizeL = gPDQ_BLOCK;
+                sizeR = unknown;
+            }
+            else {
+                sizeL = unknown / 2;
+                sizeR = unknown - sizeL;
+            }
+
+            if (unknown && !countL) {
+                startL = 0;
+                countL = classifyLeft(array, first, sizeL, pivot, less, offsetsL);
+                co_yield compareBlock(first, sizeL, 1, begin);
+            }
+            if (unknown && !countR) {
+                startR = 0;
+                countR = classifyRight(array, last, sizeR, pivot, less, offsetsR);
+                co_yield compareBlock(last - 1, sizeR, -1, begin);
+            }
+
+            int count = std::min(countL, countR);
+            co_yield swapOffsets(array, first, last, offsetsL + startL, offsetsR + startR, count, countL == countR);
+            countL -= count;
+            countR -= count;
+            startL += count;
+            startR += count;
+            if (countL == 0)
+                first += sizeL;
+            if (countR == 0)
+                last -= sizeR;
+
+            // The misplaced elements of the pending block go to the far end of the other side
+            if (countL > 0) {
+                while (countL > 0) {
+                    countL--;
+                    last--;
+                    std::swap(array[first + offsetsL[startL + countL]], array[last]);
+                    co_yield SORT_OP{SWAP_OP, first + offsetsL[startL + countL], last};
+                }
+                first = last;
+            }
+            if (countR > 0) {
+                while (countR > 0) {
+                    countR--;
+                    std::swap(array[last - offsetsR[startR + countR]], array[first]);
+                    co_yield SORT_OP{SWAP_OP, last - offsetsR[startR + countR], first};
+                    first++;
+                }
+                last = first;
+            }
+        }
+
+        pivotIndex = first - 1;
+        std::swap(array[begin], array[pivotIndex]);
+        co_yield SORT_OP{SWAP_OP, begin, pivotIndex};
+    }
+
+    /*!
+     * @brief Utility function used by pattern-defeating quick sort, sorts [begin, end)
+     * @param badAllowed The highly unbalanced partitions left before falling back to heap sort
+     * @param leftmost Whether the range starts the array, otherwise array[begin - 1] is not
+     *        greater than any element of it
+     */
+    template <typename T, typename Compare>
+    SortGenerator pdqLoop(std::vector<T> &array, int begin, int end, Compare less, int badAllowed, bool leftmost)
+    {
+        while (true) {
+            int size = end - begin;
+            bool sorted;
+
+            if (size < gPDQ_INSERTION_SORT) {
+                co_yield pdqInsertionSort(array, begin, end, less, -1, sorted);
+                co_return;
+            }
+
+            // The pivot goes to begin, the median of 3 or the pseudomedian of 9
+            int half = size / 2;
+            if (size > gPDQ_NINTHER) {
+                co_yield sort3(array, begin, begin + half, end - 1, less);
+                co_yield sort3(array, begin + 1, begin + half - 1, end - 2, less);
+                co_yield sort3(array, begin + 2, begin + half + 1, end - 3, less);
+                co_yield sort3(array, begin + half - 1, begin + half, begin + half + 1, less);
+                std::swap(array[begin], array[begin + half]);
+                co_yield SORT_OP{SWAP_OP, begin, begin + half};
+            }
+            else
+                co_yield sort3(array, begin + half, begin, end - 1, less);
+
+            // A pivot equal to the element before the range is the smallest value in it, so the
+            // elements equal to it are put in place all at once and only the rest is sorted
+            if (!leftmost) {
+                co_yield SORT_OP{COMPARE_OP, begin - 1, begin};
+                if (!less(array[begin - 1], array[begin])) {
+                    int pivot;
+                    co_yield partitionLeft(array, begin, end, less, pivot);
+                    begin = pivot + 1;
+                    continue;
+                }
+            }
+
+            int pivot;
+            bool alreadyPartitioned;
+            co_yield partitionRight(array, begin, end, less, pivot, alreadyPartitioned);
+
+            int sizeL = pivot - begin;
+            int sizeR = end - (pivot + 1);
+
+            if (sizeL < size / 8 || sizeR < size / 8) {
+                // Too many bad partitions mean an adversarial pattern, heap sort bounds the time
+                if (--badAllowed == 0) {
+                    co_yield heapSortRange(array, begin, end, less);
+                    co_return;
+                }
+
+                // Otherwise a few elements are swapped to break the pattern
+                if (sizeL >= gPDQ_INSERTION_SORT) {
+                    int swaps[][2] = {{begin, begin + sizeL / 4}, {pivot - 1, pivot - sizeL / 4},
+                                      {begin + 1, begin + sizeL / 4 + 1}, {begin + 2, begin + sizeL / 4 + 2},
+                                      {pivot - 2, pivot - (sizeL / 4 + 1)}, {pivot - 3, pivot - (sizeL / 4 + 2)}};
+                    for (int k = 0; k < (sizeL > gPDQ_NINTHER ? 6 : 2); k++) {
+                        std::swap(array[swaps[k][0]], array[swaps[k][1]]);
+                        co_yield SORT_OP{SWAP_OP, swaps[k][0], swaps[k][1]};
+                    }
+                }
+                if (sizeR >= gPDQ_INSERTION_SORT) {
+                    int swaps[][2] = {{pivot + 1, pivot + 1 + sizeR / 4}, {end - 1, end - sizeR / 4},
+                                      {pivot + 2, pivot + 2 + sizeR / 4}, {pivot + 3, pivot + 3 + sizeR / 4},
+                                      {end - 2, end - (1 + sizeR / 4)}, {end - 3, end - (2 + sizeR / 4)}};
+                    for (int k = 0; k < (sizeR > gPDQ_NINTHER ? 6 : 2); k++) {
+                        std::swap(array[swaps[k][0]], array[swaps[k][1]]);
+                        co_yield SORT_OP{SWAP_OP, swaps[k][0], swaps[k][1]};
+                    }
+                }
+            }
+            else if (alreadyPartitioned) {
+                // A partition that moved nothing hints at sorted input, a short insertion sort may finish it
+                co_yield pdqInsertionSort(array, begin, pivot, less, gPDQ_PARTIAL_INSERTION_LIMIT, sorted);
+                if (sorted) {
+                    co_yield pdqInsertionSort(array, pivot + 1, end, less, gPDQ_PARTIAL_INSERTION_LIMIT, sorted);
+                    if (sorted)
+                        co_return;
+                }
+            }
+
+            // The left side recurses and the right one loops, so the depth stays logarithmic
+            co_yield pdqLoop(array, begin, pivot, less, badAllowed, leftmost);
+            begin = pivot + 1;
+            leftmost = false;
+        }
+    }
+
+    /*!
+     * @brief Sorts the array using pattern-defeating quick sort
+     * @details Quick sort with a branchless block partition, insertion sort on small partitions,
+     *          a partition for runs of equal elements, a shortcut for sorted runs and heap sort
+     *          when the pivots keep being bad.
+     */
+    template <typename T, typename Compare>
+    SortGenerator pdqSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+        int log2 = 0;
+        while ((n >> log2) > 1)
+            log2++;
+
+        co_yield pdqLoop(array, 0, n, less, std::max(1, log2), true);
+    }
+
+    /*!
+     * @brief The number of elements the selection algorithms put first out of n
+     * @param k The selection k, 0 for the median
+     */
+    inline int selectionCount(int n, int k)
+    {
+        if (k <= 0)
+            k = (n + 1) / 2;
+        return std::max(0, std::min(k, n));
+    }
+
+    /*!
+     * @brief Selects the k smallest elements using introselect (nth_element)
+     * @details Quickselect partitions around the median of 3 and only follows the side holding
+     *          index k - 1. After 2 log2 n partitions the range left is heap sorted, which bounds
+     *          the time to O(n log n). On exit array[k - 1] is the k-th smallest element, the
+     *          elements before it are not greater and the ones after not smaller.
+     * @param k The selection k, 0 for the median
+     */
+    template <typename T, typename Compare>
+    SortGenerator introSelect(std::vector<T> &array, int k, Compare less)
+    {
+        int n = array.size();
+        int target = selectionCount(n, k) - 1;
+        if (target < 0)
+            co_return;
+
+        int low = 0;
+        int high = n - 1;
+        int depth = 0;
+        for (int size = n; size > 1; size /= 2)
+            depth += 2;
+
+        while (high - low + 1 >= gPDQ_INSERTION_SORT) {
+            if (depth-- == 0) {
+                co_yield heapSortRange(array, low, high + 1, less);
+                co_return;
+            }
+
+            // The median of 3 goes last, where the Lomuto partition takes its pivot
+            co_yield sort3(array, low, high, low + (high - low) / 2, less);
+
+            int pivot;
+            co_yield partition(array, low, high, less, pivot);
+            if (pivot == target)
+                co_return;
+            if (target < pivot)
+                high = pivot - 1;
+            else
+                low = pivot + 1;
+        }
+
+        bool sorted;
+        co_yield pdqInsertionSort(array, low, high + 1, less, -1, sorted);
+    }
+
+    /*!
+     * @brief Utility function used by the heap selections, gathers the k smallest elements in a
+     *        max heap on [0, k)
+     * @details Every element after the heap is compared with its root, the largest so far, and
+     *          replaces it when smaller: O(n log k) with k + n comparisons on random input.
+     */
+    template <typename T, typename Compare>
+    SortGenerator heapSelect(std::vector<T> &array, int count, Compare less)
+    {
+        int n = array.size();
+
+        for (int i = (count - 2) / 2; i >= 0; i--)
+            co_yield siftDown(array, count, i, 2, less);
+
+        for (int i = count; i < n; i++) {
+            co_yield SORT_OP{COMPARE_OP, i, 0};
+            if (less(array[i], array[0])) {
+                std::swap(array[0], array[i]);
+                co_yield SORT_OP{SWAP_OP, 0, i};
+                co_yield siftDown(array, count, 0, 2, less);
+            }
+        }
+    }
+
+    /*!
+     * @brief Selects the k smallest elements with a max heap of k elements (top-k)
+     * @details The k smallest are left in heap order, the root (the k-th smallest) moved to k - 1.
+     * @param k The selection k, 0 for the median
+     */
+    template <typename T, typename Compare>
+    SortGenerator heapTopK(std::vector<T> &array, int k, Compare less)
+    {
+        int count = selectionCount(array.size(), k);
+        if (count == 0)
+            co_return;
+
+        co_yield heapSelect(array, count, less);
+
+        if (count > 1) {
+            std::swap(array[0], array[count - 1]);
+            co_yield SORT_OP{SWAP_OP, 0, count - 1};
+        }
+    }
+
+    /*!
+     * @brief Sorts the k smallest elements into [0, k), leaving the rest in any order
+     * @details Introselect puts the k-th smallest in place, then pattern-defeating quick sort
+     *          sorts the elements before it.
+     * @param k The selection k, 0 for the median
+     */
+    template <typename T, typename Compare>
+    SortGenerator partialSort(std::vector<T> &array, int k, Compare less)
+    {
+        int count = selectionCount(array.size(), k);
+
+        co_yield introSelect(array, count, less);
+
+        int log2 = 0;
+        while ((count >> log2) > 1)
+            log2++;
+        if (count > 1)
+            co_yield pdqLoop(array, 0, count - 1, less, std::max(1, log2), true);
+    }
+
+    /*!
+     * @brief Utility function used by merge sort
+     * @param left The lower bound of the array
+     * @param mid The middle index of the array
+     * @param right The upper bound of the array
+     */
+    template <typename T, typename Compare>
+    SortGenerator merge(std::vector<T> &array, int left, int mid, int right, Compare less)
+    {
+        int subArrayOne = mid - left + 1;
+        int subArrayTwo = right - mid;
+
+        // Create temp arrays
+        TrackedVector<T> leftArray(subArrayOne);
+        TrackedVector<T> rightArray(subArrayTwo);
+
+        // Copy data to temp arrays leftArray[] and rightArray[]
+        for (int i = 0; i < subArrayOne; i++) {
+            leftArray[i] = array[left + i];
+            co_yield SORT_OP{READ_OP, left + i, -1};
+        }
+        for (int j = 0; j < subArrayTwo; j++) {
+            rightArray[j] = array[mid + 1 + j];
+            co_yield SORT_OP{READ_OP, mid + 1 + j, -1};
+        }
+
+        int indexOfSubArrayOne = 0;    // Initial index of first sub-array
+        int indexOfSubArrayTwo = 0;    // Initial index of second sub-array
+        int indexOfMergedArray = left; // Initial index of merged array
+
+        // Merge the temp arrays back into array[left..right]
+        while (indexOfSubArrayOne < subArrayOne && indexOfSubArrayTwo < subArrayTwo) {
+            co_yield SORT_OP{COMPARE_OP, left + indexOfSubArrayOne, mid + 1 + indexOfSubArrayTwo};
+            // Taking from the left run on ties keeps the sort stable
+            if (!less(rightArray[indexOfSubArrayTwo], leftArray[indexOfSubArrayOne])) {
+                array[indexOfMergedArray] = leftArray[indexOfSubArrayOne];
+                indexOfSubArrayOne++;
+            }
+            else {
+                array[indexOfMergedArray] = rightArray[indexOfSubArrayTwo];
+                indexOfSubArrayTwo++;
+            }
+            co_yield SORT_OP{WRITE_OP, indexOfMergedArray, -1};
+            indexOfMergedArray++;
+        }
+
+        while (indexOfSubArrayOne < subArrayOne) {
+            array[indexOfMergedArray] = leftArray[indexOfSubArrayOne];
+            co_yield SORT_OP{WRITE_OP, indexOfMergedArray, -1};
+
+            indexOfSubArrayOne++;
+            indexOfMergedArray++;
+        }
+
+        while (indexOfSubArrayTwo < subArrayTwo) {
+            array[indexOfMergedArray] = rightArray[indexOfSubArrayTwo];
+            co_yield SORT_OP{WRITE_OP, indexOfMergedArray, -1};
+
+            indexOfSubArrayTwo++;
+            indexOfMergedArray++;
+        }
+    }
+
+    /*!
+     * @brief Sorts the array using merge sort
+     * @param l The lower bound of the array
+     * @param r The upper bound of the array
+     * @param cutoff Ranges of up to this many elements are sorted by a network (0 to recurse to the end),
+     *               networks are not stable so neither is the sort with a cutoff
+     */
+    template <typename T, typename Compare>
+    SortGenerator mergeSort(std::vector<T> &array, int l, int r, Compare less, int cutoff = 0)
+    {
+        if (l >= r)
+            co_return; // Returns recursively
+
+        if (r - l + 1 <= cutoff) {
+            co_yield smallSort(array, l, r, less);
+            co_return;
+        }
+
+        int mid = l + (r - l) / 2;
+        co_yield mergeSort(array, l, mid, less, cutoff);
+        co_yield mergeSort(array, mid + 1, r, less, cutoff);
+        co_yield merge(array, l, mid, r, less);
+    }
+
+    /*!
+     * @brief Sorts the array using selection sort
+     */
+    template <typename T, typename Compare>
+    SortGenerator selectionSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+        int i, j, min_idx;
+
+        for (i = 0; i < n - 1; i++) {
+            min_idx = i;
+            for (j = i + 1; j < n; j++) {
+                co_yield SORT_OP{COMPARE_OP, min_idx, j};
+                if (less(array[j], array[min_idx]))
+                    min_idx = j;
+            }
+
+            if (min_idx != i) {
+                std::swap(array[min_idx], array[i]);
+                co_yield SORT_OP{SWAP_OP, min_idx, i};
+            }
+        }
+    }
+
+    /*!
+     * @brief Sorts the array using insertion sort
+     */
+    template <typename T, typename Compare>
+    SortGenerator insertionSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+
+        for (int i = 1; i < n; i++) {
+            T key = array[i];
+            co_yield SORT_OP{READ_OP, i, -1};
+            int j = i - 1;
+
+            while (j >= 0) {
+                co_yield SORT_OP{COMPARE_OP, j + 1, j};
+                if (!less(key, array[j]))
+                    break;
+                array[j + 1] = array[j];
+                co_yield SORT_OP{WRITE_OP, j + 1, j};
+                j = j - 1;
+            }
+
+            if (j + 1 != i) {
+                array[j + 1] = key;
+                co_yield SORT_OP{WRITE_OP, j + 1, -1};
+            }
+        }
+    }
+
+    /*!
+     * @brief Sorts the array using gnome sort
+     */
+    template <typename T, typename Compare>
+    SortGenerator gnomeSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+        int index = 0;
+
+        while (index < n) {
+            if (index == 0)
+                index++;
+            if (index >= n)
+                break;
+            co_yield SORT_OP{COMPARE_OP, index - 1, index};
+            if (!less(array[index], array[index - 1]))
+                index++;
+            else {
+                std::swap(array[index], array[index - 1]);
+                index--;
+                co_yield SORT_OP{SWAP_OP, index + 1, index};
+            }
+        }
+    }
+
+    /*!
+     * @brief The elements of the cache of block merge sort, and the most A blocks it rolls at once
+     */
+    const int gBLOCK_MERGE_CACHE = 512;
+
+    /*!
+     * @brief Utility function used by block merge sort, swaps the blocks [a, a + count) and [b, b + count)
+     */
+    template <typename T>
+    SortGenerator blockSwap(std::vector<T> &array, int a, int b, int count)
+    {
+        for (int k = 0; k < count; k++) {
+            std::swap(array[a + k], array[b + k]);
+            co_yield SORT_OP{SWAP_OP, a + k, b + k};
+        }
+    }
+
+    /*!
+     * @brief Utility function used by block merge sort, rotates [start, end) left by amount with three reversals
+     */
+    template <typename T>
+    SortGenerator blockRotate(std::vector<T> &array, int start, int end, int amount)
+    {
+        if (amount <= 0 || amount >= end - start)
+            co_return;
+
+        int bounds[3][2] = {{start, start + amount - 1}, {start + amount, end - 1}, {start, end - 1}};
+        for (auto &bound : bounds) {
+            for (int i = bound[0], j = bound[1]; i < j; i++, j--) {
+                std::swap(array[i], array[j]);
+                co_yield SORT_OP{SWAP_OP, i, j};
+            }
+        }
+    }
+
+    /*!
+     * @brief Utility function used by block merge sort, finds the first index of [start, end) whose
+     *        element is not less than the element at key (end if none)
+     */
+    template <typename T, typename Compare>
+    SortGenerator binaryFirst(std::vector<T> &array, int key, int start, int end, Compare less, int &result)
+    {
+        T value = array[key];
+        while (start < end) {
+            int mid = start + (end - start) / 2;
+            co_yield SORT_OP{COMPARE_OP, key, mid};
+            if (less(array[mid], value))
+                start = mid + 1;
+            else
+                end = mid;
+        }
+        result = start;
+    }
+
+    /*!
+     * @brief Utility function used by block merge sort, finds the first index of [start, end) whose
+     *        element is greater than the element at key (end if none)
+     */
+    template <typename T, typename Compare>
+    SortGenerator binaryLast(std::vector<T> &array, int key, int start, int end, Compare less, int &result)
+    {
+        T value = array[key];
+        while (start < end) {
+            int mid = start + (end - start) / 2;
+            co_yield SORT_OP{COMPARE_OP, key, mid};
+            if (!less(value, array[mid]))
+                start = mid + 1;
+            else
+                end = mid;
+        }
+        result = start;
+    }
+
+    /*!
+     * @brief Utility function used by block merge sort, merges the A run held by the cache with the
+     *        B run [bStart, bEnd) into [aStart, bEnd)
+     * @param aStart The start of the A run, whose elements are in cache[0, aCount)
+     */
+    template <typename T, typename Compare>
+    SortGenerator mergeFromCache(std::vector<T> &array, int aStart, int aCount, int bStart, int bEnd, TrackedVector<T> &cache, Compare less)
+    {
+        int a = 0;
+        int b = bStart;
+        int out = aStart;
+
+        while (a < aCount && b < bEnd) {
+            co_yield SORT_OP{COMPARE_OP, -1, b};
+            // Taking from A on ties keeps the sort stable
+            if (!less(array[b], cache[a])) {
+                array[out] = cache[a++];
+                co_yield SORT_OP{WRITE_OP, out++, -1};
+            }
+            else {
+                array[out] = array[b];
+                co_yield SORT_OP{WRITE_OP, out++, b++};
+            }
+        }
+
+        // What is left of B is already in place
+        while (a < aCount) {
+            array[out] = cache[a++];
+            co_yield SORT_OP{WRITE_OP, out++, -1};
+        }
+    }
+
+    /*!
+     * @brief Utility function used by block merge sort, copies [start, start + count) into the cache
+     */
+    template <typename T>
+    SortGenerator fillCache(std::vector<T> &array, int start, int count, TrackedVector<T> &cache)
+    {
+        for (int k = 0; k < count; k++) {
+            cache[k] = array[start + k];
+            co_yield SORT_OP{READ_OP, start + k, -1};
+        }
+    }
+
+    /*!
+     * @brief Utility function used by block merge sort, merges [aStart, aEnd) and [aEnd, bEnd) with
+     *        rotations only
+     */
+    template <typename T, typename Compare>
+    SortGenerator mergeInPlace(std::vector<T> &array, int aStart, int aEnd, int bEnd, Compare less)
+    {
+        while (aStart < aEnd && aEnd < bEnd) {
+            // The B elements smaller than the first of A go before the whole of A
+            int mid;
+            co_yield binaryFirst(array, aStart, aEnd, bEnd, less, mid);
+            int amount = mid - aEnd;
+            co_yield blockRotate(array, aStart, mid, aEnd - aStart);
+
+            // The first of A is now in place, and so are the A elements not greater than it
+            aStart += amount;
+            aEnd = mid;
+            co_yield binaryLast(array, aStart, aStart, aEnd, less, aStart);
+        }
+    }
+
+    /*!
+     * @brief Utility function used by block merge sort, merges [start, mid) and [mid, end) in place
+     * @details A run that fits the cache is merged through it. Larger A runs are split in blocks
+     *          of about sqrt(|A|) elements rolled through B by block swaps: each time the last B
+     *          block passed reaches the smallest A block left, that A block is dropped behind and
+     *          the previous A block is merged with the B elements between them. The blocks keep
+     *          their original order in ids, so no element has to be extracted as a tag.
+     */
+    template <typename T, typename Compare>
+    SortGenerator blockMerge(std::vector<T> &array, int start, int mid, int end, TrackedVector<T> &cache, TrackedVector<int> &ids, Compare less)
+    {
+        // B entirely before A, or already in order
+        co_yield SORT_OP{COMPARE_OP, end - 1, start};
+        if (less(array[end - 1], array[start])) {
+            co_yield blockRotate(array, start, end, mid - start);
+            co_return;
+        }
+        co_yield SORT_OP{COMPARE_OP, mid, mid - 1};
+        if (!less(array[mid], array[mid - 1]))
+            co_return;
+
+        int lengthA = mid - start;
+        if (lengthA <= (int)cache.size()) {
+            co_yield fillCache(array, start, lengthA, cache);
+            co_yield mergeFromCache(array, start, lengthA, mid, end, cache, less);
+            co_return;
+        }
+
+        // At most gBLOCK_MERGE_CACHE blocks, the uneven one goes first
+        int blockSize = std::max((int)std::sqrt((double)lengthA), (lengthA + gBLOCK_MERGE_CACHE - 1) / gBLOCK_MERGE_CACHE);
+        bool cached = blockSize <= (int)cache.size();
+
+        int lastAStart = start, lastAEnd = start + lengthA % blockSize;
+        int lastBStart = mid, lastBEnd = mid;
+        int blockAStart = lastAEnd, blockAEnd = mid;
+        int blockBStart = mid, blockBEnd = mid + std::min(blockSize, end - mid);
+
+        // ids is a ring of the original indices of the A blocks, in their current order
+        int blocks = (blockAEnd - blockAStart) / blockSize;
+        int ring = blocks + 1;
+        int head = 0;
+        for (int k = 0; k < blocks; k++)
+            ids[k] = k;
+        int nextA = 0; // The original index of the smallest A block left
+
+        // The previous A block waits in the cache to be merged
+        if (cached)
+            co_yield fillCache(array, lastAStart, lastAEnd - lastAStart, cache);
+
+        while (true) {
+            int minA = blockAStart;
+            for (int k = 0; k < (blockAEnd - blockAStart) / blockSize; k++)
+                if (ids[(head + k) % ring] == nextA)
+                    minA = blockAStart + k * blockSize;
+
+            bool drop = blockBStart == blockBEnd;
+            if (!drop && lastBEnd > lastBStart) {
+                co_yield SORT_OP{COMPARE_OP, lastBEnd - 1, minA};
+                drop = !less(array[lastBEnd - 1], array[minA]);
+            }
+
+            if (drop) {
+                // The previous B block is split around the first element of the smallest A block
+                int splitB;
+                co_yield binaryFirst(array, minA, lastBStart, lastBEnd, less, splitB);
+                int remainingB = lastBEnd - splitB;
+
+                // The smallest A block goes first among the rolling ones
+                co_yield blockSwap(array, blockAStart, minA, blockSize);
+                std::swap(ids[head], ids[(head + (minA - blockAStart) / blockSize) % ring]);
+                nextA++;
+
+                // The previous A block is merged with the B elements that follow it
+                if (cached)
+                    co_yield mergeFromCache(array, lastAStart, lastAEnd - lastAStart, lastAEnd, splitB, cache, less);
+                else
+                    co_yield mergeInPlace(array, lastAStart, lastAEnd, splitB, less);
+
+                // The dropped A block moves behind the rest of the split B block
+                if (cached) {
+                    // Once in the cache its slots are free, so B only needs a block swap instead of a rotation
+                    co_yield fillCache(array, blockAStart, blockSize, cache);
+                    co_yield blockSwap(array, splitB, blockAStart + blockSize - remainingB, remainingB);
+                }
+                else
+                    co_yield blockRotate(array, splitB, blockAStart + blockSize, blockAStart - splitB);
+
+                lastAStart = blockAStart - remainingB;
+                lastAEnd = lastAStart + blockSize;
+                lastBStart = lastAEnd;
+                lastBEnd = lastAEnd + remainingB;
+
+                blockAStart += blockSize;
+                head = (head + 1) % ring;
+                if (blockAStart == blockAEnd)
+                    break;
+            }
+            else if (blockBEnd - blockBStart < blockSize) {
+                // The last B block is uneven, it is rotated before the A blocks
+                co_yield blockRotate(array, blockAStart, blockBEnd, blockBStart - blockAStart);
+
+                lastBStart = blockAStart;
+                lastBEnd = blockAStart + (blockBEnd - blockBStart);
+                blockAStart += blockBEnd - blockBStart;
+                blockAEnd += blockBEnd - blockBStart;
+                blockBEnd = blockBStart;
+            }
+            else {
+                // The first A block rolls to the end of the A blocks, swapped with the next B block
+                co_yield blockSwap(array, blockAStart, blockBStart, blockSize);
+                ids[(head + (blockAEnd - blockAStart) / blockSize) % ring] = ids[head];
+                head = (head + 1) % ring;
+
+                lastBStart = blockAStart;
+                lastBEnd = blockAStart + blockSize;
+                blockAStart += blockSize;
+                blockAEnd += blockSize;
+                blockBStart += blockSize;
+                blockBEnd = std::min(blockBEnd + blockSize, end);
+            }
+        }
+
+        // The last A block is merged with what is left of B
+        if (cached)
+            co_yield mergeFromCache(array, lastAStart, lastAEnd - lastAStart, lastAEnd, end, cache, less);
+        else
+            co_yield mergeInPlace(array, lastAStart, lastAEnd, end, less);
+    }
+
+    /*!
+     * @brief Sorts the array using block merge sort, a stable merge sort in place
+     * @details Bottom-up merge sort over runs of 16 sorted by insertion, merged by blockMerge.
+     *          Besides the array it only uses a fixed cache of gBLOCK_MERGE_CACHE elements and
+     *          as many block indices, whatever the size of the array.
+     */
+    template <typename T, typename Compare>
+    SortGenerator blockMergeSort(std::vector<T> &array, Compare less)
+    {
+        int n = array.size();
+        if (n < 2)
+            co_return;
+
+        TrackedVector<T> cache(std::min(n, gBLOCK_MERGE_CACHE));
+        TrackedVector<int> ids(gBLOCK_MERGE_CACHE + 1);
+
+        for (int start = 0; start < n; start += 16) {
+            int end = std::min(start + 16, n);
+            for (int i = start + 1; i < end; i++) {
+                for (int j = i; j > start; j--) {
+                    co_yield SORT_OP{COMPARE_OP, j - 1, j};
+                    if (!less(array[j], array[j - 1]))
+                        break;
+                    std::swap(array[j], array[j - 1]);
+                    co_yield SORT_OP{SWAP_OP, j - 1, j};
+                }
+            }
+        }
+
+        for (int width = 16; width < n; width *= 2)
+            for (int start = 0; start + width < n; start += 2 * width)
+                co_yield blockMerge(array, start, start + width, std::min(start + 2 * width, n), cache, ids, less);
+    }
+}
+
+#endif /* Sorts_hpp */
@@ -0,0 +1,73 @@
+//
+//  SpscRing.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef SpscRing_hpp
+#define SpscRing_hpp
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Visualizer
+{
+    /*!
+     * @brief A fixed size single producer, single consumer queue
+     * @details push and pop never block, allocate or loop: each one is a couple of atomic loads
+     *          and one store, so both sides are wait-free. A full queue rejects the element
+     *          instead of waiting for the consumer.
+     * @tparam T The type of the elements, copied in and out
+     * @tparam Capacity The number of slots, a power of two
+     */
+    template <typename T, size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two");
+
+    public:
+        /*!
+         * @brief Appends an element, only called by the producer
+         * @return false if the queue is full
+         */
+        bool push(const T &value)
+        {
+            size_t head = mHead.load(std::memory_order_relaxed);
+            if (head - mTail.load(std::memory_order_acquire) == Capacity)
+                return false;
+
+            mSlots[head & (Capacity - 1)] = value;
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /*!
+         * @brief Removes the oldest element, only called by the consumer
+         * @return false if the queue is empty
+         */
+        bool pop(T &value)
+        {
+            size_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail == mHead.load(std::memory_order_acquire))
+                return false;
+
+            value = mSlots[tail & (Capacity - 1)];
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /*!
+         * @brief The number of queued elements, exact only when called by one of the two sides
+         */
+        size_t size() const { return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire); }
+
+    private:
+        alignas(64) std::atomic<size_t> mHead = 0; /*! Written by the producer only */
+        alignas(64) std::atomic<size_t> mTail = 0; /*! Written by the consumer only */
+        alignas(64) std::array<T, Capacity> mSlots;
+    };
+}
+
+#endif /* SpscRing_hpp */
@@ -0,0 +1,297 @@
+//
+//  StreamIngest.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef StreamIngest_hpp
+#define StreamIngest_hpp
+
+#include <vector>
+#include <string>
+#include <variant>
+#include <algorithm>
+
+#include "Elements.hpp"
+
+namespace Visualizer
+{
+    /*!
+     * @brief Enum that represents the structures keeping the arriving elements sorted
+     */
+    enum INGEST_STRATEGY
+    {
+        BINARY_INSERTION_INGEST, // One sorted array, every element is inserted in place
+        LSM_INGEST,              // A sorted buffer flushed into runs, equal runs are merged
+        BTREE_INGEST             // Sorted leaves of bounded size under a sorted index of leaves
+    };
+
+    const std::string gINGEST_STRATEGY_NAMES[] = {"binary", "lsm", "btree"};
+
+    const int gINGEST_STRATEGIES_COUNT = 3;
+
+    // The elements the LSM buffer holds before it's flushed as a run
+    const int gLSM_BUFFER = 64;
+
+    // The elements a B-tree leaf holds before it's split in two
+    const int gBTREE_LEAF = 64;
+
+    /*!
+     * @brief The work done by a structure since it was created
+     */
+    typedef struct INGEST_STATS
+    {
+        long long inserted = 0;    /*! The elements inserted */
+        long long comparisons = 0; /*! The comparisons between elements */
+        long long writes = 0;      /*! The elements written, shifted, flushed or merged */
+        long long merges = 0;      /*! The runs merged (LSM) or the leaves split (B-tree) */
+    } INGEST_STATS;
+
+    /*!
+     * @brief The percentiles of the insert latencies, in nanoseconds
+     */
+    typedef struct INGEST_LATENCY
+    {
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double max = 0.0;
+    } INGEST_LATENCY;
+
+    /*!
+     * @brief Computes the percentiles of the latencies (nearest rank)
+     */
+    inline INGEST_LATENCY latencyPercentiles(std::vector<double> latencies)
+    {
+        INGEST_LATENCY result;
+        if (latencies.empty())
+            return result;
+
+        std::sort(latencies.begin(), latencies.end());
+        auto rank = [&](double q) { return latencies[std::min(latencies.size() - 1, (size_t)(q * latencies.size()))]; };
+
+        result.p50 = rank(0.50);
+        result.p99 = rank(0.99);
+        result.p999 = rank(0.999);
+        result.max = latencies.back();
+        return result;
+    }
+
+    /*!
+     * @brief Keeps the elements sorted while they arrive one at a time
+     * @details Binary insertion finds the place of each element with a binary search and shifts
+     *          the larger ones, so an insert costs O(n) writes. The LSM strategy inserts into a
+     *          small sorted buffer, flushes it as a run when full and merges the last two runs
+     *          while the older one isn't larger, like a binary counter: inserts are cheap except
+     *          for the ones triggering a merge, whose cost is the size of the runs merged. The
+     *          B-tree strategy keeps leaves of at most gBTREE_LEAF elements under a sorted index
+     *          of leaves (a B+ tree of two levels): a binary search over the first element of
+     *          each leaf, then one within the leaf, and a full leaf is split in halves.
+     */
+    template <typename T>
+    class StreamIngest
+    {
+    public:
+        /*!
+         * @brief StreamIngest constructor
+         * @param strategy The structure holding the elements
+         */
+        StreamIngest(INGEST_STRATEGY strategy = BINARY_INSERTION_INGEST) : mStrategy(strategy) {}
+
+        /*!
+         * @brief Inserts an element
+         */
+        void insert(const T &value)
+        {
+            switch (mStrategy) {
+                case BINARY_INSERTION_INGEST:
+                    insertSorted(mSorted, value);
+                    break;
+                case LSM_INGEST:
+                    insertSorted(mBuffer, value);
+                    if ((int)mBuffer.size() == gLSM_BUFFER)
+                        flush();
+                    break;
+                case BTREE_INGEST:
+                    insertLeaf(value);
+                    break;
+            }
+
+            mStats.inserted++;
+        }
+
+        /*!
+         * @brief Merges the buffer and every run of the LSM strategy into one, so the layout is sorted
+         * @details The other strategies are always sorted.
+         */
+        void compact()
+        {
+            if (mStrategy != LSM_INGEST)
+                return;
+
+            if (!mBuffer.empty())
+                mRuns.push_back(std::move(mBuffer));
+            mBuffer.clear();
+
+            while (mRuns.size() >= 2)
+                mergeLastRuns();
+        }
+
+        /*!
+         * @brief Copies the elements in the order they are stored (the LSM runs from the oldest, then the buffer)
+         */
+        void layout(std::vector<T> &out) const
+        {
+            out.clear();
+            out.reserve(mStats.inserted);
+
+            switch (mStrategy) {
+                case BINARY_INSERTION_INGEST:
+                    out = mSorted;
+                    break;
+                case LSM_INGEST:
+                    for (const std::vector<T> &run : mRuns)
+                        out.insert(out.end(), run.begin(), run.end());
+                    out.insert(out.end(), mBuffer.begin(), mBuffer.end());
+                    break;
+                case BTREE_INGEST:
+                    for (const std::vector<T> &leaf : mRuns)
+                        out.insert(out.end(), leaf.begin(), leaf.end());
+                    break;
+            }
+        }
+
+        /*!
+         * @brief The sizes of the LSM runs, from the oldest, or of the B-tree leaves
+         */
+        std::vector<int> blocks() const
+        {
+            std::vector<int> sizes;
+            for (const std::vector<T> &block : mRuns)
+                sizes.push_back(block.size());
+            return sizes;
+        }
+
+        INGEST_STRATEGY strategy() const { return mStrategy; }
+
+        const INGEST_STATS &stats() const { return mStats; }
+
+    private:
+        INGEST_STRATEGY mStrategy; /*! The structure holding the elements */
+        INGEST_STATS mStats;       /*! The work done so far */
+        TotalLess<T> mLess;        /*! The order of the elements */
+
+        std::vector<T> mSorted;             /*! The elements of the binary insertion strategy */
+        std::vector<T> mBuffer;             /*! The sorted buffer of the LSM strategy */
+        std::vector<std::vector<T>> mRuns;  /*! The runs of the LSM strategy from the oldest, or the leaves of the B-tree in order */
+
+        bool less(const T &a, const T &b)
+        {
+            mStats.comparisons++;
+            return mLess(a, b);
+        }
+
+        /*!
+         * @brief Inserts the value after the elements not greater than it, shifting the larger ones
+         */
+        void insertSorted(std::vector<T> &array, const T &value)
+        {
+            int low = 0;
+            int high = array.size();
+            while (low < high) {
+                int middle = low + (high - low) / 2;
+                if (less(value, array[middle]))
+                    high = middle;
+                else
+                    low = middle + 1;
+            }
+
+            array.insert(array.begin() + low, value);
+            mStats.writes += array.size() - low;
+        }
+
+        /*!
+         * @brief Turns the full buffer into the newest run and merges the runs it completes
+         */
+        void flush()
+        {
+            mRuns.push_back(std::move(mBuffer));
+            mBuffer.clear();
+            mBuffer.reserve(gLSM_BUFFER);
+            mStats.writes += gLSM_BUFFER;
+
+            while (mRuns.size() >= 2 && mRuns[mRuns.size() - 2].size() <= mRuns.back().size())
+                mergeLastRuns();
+        }
+
+        /*!
+         * @brief Merges the newest run into the one before it, the older elements first on ties
+         */
+        void mergeLastRuns()
+        {
+            std::vector<T> &older = mRuns[mRuns.size() - 2];
+            std::vector<T> &newer = mRuns.back();
+            std::vector<T> merged;
+            merged.reserve(older.size() + newer.size());
+
+            size_t i = 0, j = 0;
+            while (i < older.size() && j < newer.size()) {
+                if (less(newer[j], older[i]))
+                    merged.push_back(newer[j++]);
+                else
+                    merged.push_back(older[i++]);
+            }
+            merged.insert(merged.end(), older.begin() + i, older.end());
+            merged.insert(merged.end(), newer.begin() + j, newer.end());
+
+            mStats.writes += merged.size();
+            mStats.merges++;
+
+            mRuns.pop_back();
+            mRuns.back() = std::move(merged);
+        }
+
+        /*!
+         * @brief Inserts the value in the leaf covering it and splits the leaf once full
+         */
+        void insertLeaf(const T &value)
+        {
+            if (mRuns.empty())
+                mRuns.emplace_back();
+
+            // The last leaf whose first element is not greater than the value (the first one if none)
+            int low = 1;
+            int high = mRuns.size();
+            while (low < high) {
+                int middle = low + (high - low) / 2;
+                if (less(value, mRuns[middle].front()))
+                    high = middle;
+                else
+                    low = middle + 1;
+            }
+            int leaf = low - 1;
+
+            insertSorted(mRuns[leaf], value);
+
+            if ((int)mRuns[leaf].size() == gBTREE_LEAF) {
+                std::vector<T> upper(mRuns[leaf].begin() + gBTREE_LEAF / 2, mRuns[leaf].end());
+                mRuns[leaf].resize(gBTREE_LEAF / 2);
+                mStats.writes += upper.size();
+                mStats.merges++;
+                mRuns.insert(mRuns.begin() + leaf + 1, std::move(upper));
+            }
+        }
+    };
+
+    /*!
+     * @brief A structure for each element type (same order as ELEMENT_TYPE)
+     */
+    typedef std::variant<StreamIngest<int32_t>,
+                         StreamIngest<int64_t>,
+                         StreamIngest<uint64_t>,
+                         StreamIngest<float>,
+                         StreamIngest<double>> AnyStreamIngest;
+}
+
+#endif /* StreamIngest_hpp */
@@ -0,0 +1,170 @@
+//
+//  Trace.cpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#include <stdexcept>
+#include <algorithm>
+
+#include "Trace.hpp"
+
+namespace
+{
+    using namespace Visualizer;
+
+    // The spans of a thread, handed to the tracer when full and when the thread exits
+    struct ThreadBuffer
+    {
+        TRACE_BATCH batch = {0, NULL, {}};
+
+        ~ThreadBuffer()
+        {
+            if (!batch.events.empty())
+                Tracer::instance().submit(std::move(batch));
+        }
+    };
+
+    thread_local ThreadBuffer gThreadBuffer;
+
+    // Writes a string as a JSON string, the names are literals but may hold quotes
+    void writeString(FILE *file, const char *text)
+    {
+        fputc('"', file);
+        for (const char *c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\')
+                fputc('\\', file);
+            if ((unsigned char)*c >= 0x20)
+                fputc(*c, file);
+        }
+        fputc('"', file);
+    }
+}
+
+Visualizer::Tracer &Visualizer::Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+void Visualizer::Tracer::start(const std::string &path)
+{
+    mFile = fopen(path.c_str(), "w");
+    if (mFile == NULL)
+        throw std::runtime_error("Failed to create the trace file " + path);
+
+    fprintf(mFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    mFirstEvent = true;
+    mNamedThreads.clear();
+    mStopping = false;
+    mEpoch = std::chrono::steady_clock::now();
+    mWriter = std::thread(&Tracer::writeLoop, this);
+    mEnabled = true;
+}
+
+void Visualizer::Tracer::stop()
+{
+    if (!mEnabled)
+        return;
+
+    mEnabled = false;
+    if (!gThreadBuffer.batch.events.empty())
+        submit(std::move(gThreadBuffer.batch));
+    gThreadBuffer.batch.events.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mReady.notify_one();
+    mWriter.join();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    fprintf(mFile, "\n]}\n");
+    fclose(mFile);
+    mFile = NULL;
+}
+
+long long Visualizer::Tracer::now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mEpoch).count();
+}
+
+void Visualizer::Tracer::record(const char *name, long long start, long long end)
+{
+    TRACE_BATCH &batch = gThreadBuffer.batch;
+
+    if (batch.thread == 0)
+        batch.thread = mNextThread++;
+    if (batch.events.capacity() < (size_t)gTRACE_BUFFER)
+        batch.events.reserve(gTRACE_BUFFER);
+
+    batch.events.push_back({name, start, end - start});
+
+    // The events move to the writer, the next span reserves a new buffer
+    if ((int)batch.events.size() == gTRACE_BUFFER) {
+        submit(std::move(batch));
+        batch.events.clear();
+    }
+}
+
+void Visualizer::Tracer::nameThread(const char *name)
+{
+    TRACE_BATCH &batch = gThreadBuffer.batch;
+    if (batch.thread == 0)
+        batch.thread = mNextThread++;
+    batch.threadName = name;
+}
+
+void Visualizer::Tracer::submit(TRACE_BATCH &&batch)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // Buffers of threads exiting after the trace stopped are dropped
+        if (mFile == NULL || mStopping)
+            return;
+        mPending.push_back(std::move(batch));
+    }
+    mReady.notify_one();
+}
+
+void Visualizer::Tracer::writeLoop()
+{
+    std::vector<TRACE_BATCH> batches;
+
+    while (true) {
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mReady.wait(lock, [this]() { return mStopping || !mPending.empty(); });
+            batches.swap(mPending);
+            stopping = mStopping;
+        }
+
+        for (const TRACE_BATCH &batch : batches)
+            write(batch);
+        batches.clear();
+
+        if (stopping)
+            return;
+    }
+}
+
+void Visualizer::Tracer::write(const TRACE_BATCH &batch)
+{
+    if (batch.threadName != NULL && std::find(mNamedThreads.begin(), mNamedThreads.end(), batch.thread) == mNamedThreads.end()) {
+        fprintf(mFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", mFirstEvent ? "" : ",\n", batch.thread);
+        writeString(mFile, batch.threadName);
+        fprintf(mFile, "}}");
+        mNamedThreads.push_back(batch.thread);
+        mFirstEvent = false;
+    }
+
+    for (const TRACE_EVENT &event : batch.events) {
+        fprintf(mFile, "%s{\"name\":", mFirstEvent ? "" : ",\n");
+        writeString(mFile, event.name);
+        fprintf(mFile, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", batch.thread, event.start / 1000.0, event.duration / 1000.0);
+        mFirstEvent = false;
+    }
+}
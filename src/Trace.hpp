@@ -0,0 +1,156 @@
+//
+//  Trace.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Trace_hpp
+#define Trace_hpp
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+// The spans only exist when built with TRACE=1, otherwise they compile to nothing
+#ifdef SORT_TRACE
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SPAN(name) Visualizer::TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_THREAD(name) Visualizer::Tracer::instance().nameThread(name)
+#else
+#define TRACE_SPAN(name)
+#define TRACE_THREAD(name)
+#endif
+
+namespace Visualizer
+{
+    // The events a thread buffers before handing them to the writer
+    const int gTRACE_BUFFER = 4096;
+
+    /*!
+     * @brief A span of time spent by a thread, in nanoseconds since the trace started
+     */
+    typedef struct TRACE_EVENT
+    {
+        const char *name; /*! A string literal, never copied */
+        long long start;
+        long long duration;
+    } TRACE_EVENT;
+
+    /*!
+     * @brief The events of a thread handed to the writer at once
+     */
+    typedef struct TRACE_BATCH
+    {
+        int thread;               /*! The id of the thread in the trace */
+        const char *threadName;   /*! The name given with TRACE_THREAD, if any */
+        std::vector<TRACE_EVENT> events;
+    } TRACE_BATCH;
+
+    /*!
+     * @brief Writes the spans of every thread to a Chrome trace event JSON file
+     * @details Each thread records its spans into its own buffer without locking. A full buffer
+     *          (or the buffer of a thread that exits) is handed to a writer thread, which formats
+     *          it into the file while the others keep running. The file opens in chrome://tracing
+     *          and ui.perfetto.dev, every span as a complete event on the row of its thread.
+     */
+    class Tracer
+    {
+    public:
+        /*!
+         * @brief Returns the tracer of the process
+         */
+        static Tracer &instance();
+
+        /*!
+         * @brief Starts recording the spans and writing them to the file
+         * @throws std::runtime_error if the file can't be created
+         */
+        void start(const std::string &path);
+
+        /*!
+         * @brief Flushes the spans of the calling thread, waits for the writer and closes the file
+         * @details Threads still running keep the spans they didn't hand over yet out of the file.
+         */
+        void stop();
+
+        bool enabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+        /*!
+         * @brief The nanoseconds since the trace started
+         */
+        long long now() const;
+
+        /*!
+         * @brief Records a span of the calling thread
+         */
+        void record(const char *name, long long start, long long end);
+
+        /*!
+         * @brief Names the row of the calling thread in the trace
+         */
+        void nameThread(const char *name);
+
+        /*!
+         * @brief Hands a buffer of events to the writer
+         */
+        void submit(TRACE_BATCH &&batch);
+
+    private:
+        Tracer() = default;
+
+        std::atomic<bool> mEnabled = false;      /*! Whether spans are recorded */
+        std::atomic<int> mNextThread = 1;        /*! The id given to the next thread recording a span */
+        std::chrono::steady_clock::time_point mEpoch; /*! When the trace started */
+
+        FILE *mFile = NULL;                /*! The JSON file */
+        bool mFirstEvent = true;           /*! Whether no event was written yet (no comma before it) */
+        std::vector<int> mNamedThreads;    /*! The threads whose name was written */
+
+        std::thread mWriter;               /*! Formats the batches into the file */
+        std::mutex mMutex;                 /*! Protects the pending batches and the stop flag */
+        std::condition_variable mReady;    /*! Signals a batch or the stop */
+        std::vector<TRACE_BATCH> mPending; /*! The batches waiting to be written */
+        bool mStopping = false;            /*! Set by stop() */
+
+        /*!
+         * @brief The loop of the writer thread
+         */
+        void writeLoop();
+
+        /*!
+         * @brief Writes the events of a batch, and the name of its thread the first time
+         */
+        void write(const TRACE_BATCH &batch);
+    };
+
+    /*!
+     * @brief Records the time from its construction to its destruction as a span, use TRACE_SPAN
+     */
+    class TraceSpan
+    {
+    public:
+        TraceSpan(const char *name) : mName(name), mStart(Tracer::instance().enabled() ? Tracer::instance().now() : -1) {}
+
+        ~TraceSpan()
+        {
+            if (mStart >= 0)
+                Tracer::instance().record(mName, mStart, Tracer::instance().now());
+        }
+
+        TraceSpan(const TraceSpan &) = delete;
+        TraceSpan &operator=(const TraceSpan &) = delete;
+
+    private:
+        const char *mName;
+        long long mStart; /*! -1 when the tracer was off */
+    };
+}
+
+#endif /* Trace_hpp */
@@ -9,6 +9,7 @@
 #define Utilities_hpp
 
 #include <string>
+#include <SDL2/SDL.h>
 
 /*!
  * @brief A struct that represents a couple of integers used to represent the size of the window
@@ -20,7 +21,7 @@ typedef struct COUPLE
 } COUPLE;
 
 /*!
- * @brief Enum that represents the sorting algorithms available
+ * @brief Enum that represents the built-in sorting algorithms (their index in the Registry)
  */
 enum SORT_IDENTIFIER
 {
@@ -32,22 +33,85 @@ enum SORT_IDENTIFIER
     MERGE_SORT,
     SELECTION_SORT,
     INSERTION_SORT,
-    GNOME_SORT
+    GNOME_SORT,
+    SORTING_NETWORK,
+    BLOCK_MERGE_SORT,
+    BOTTOM_UP_HEAP_SORT,
+    QUATERNARY_HEAP_SORT,
+    OCTONARY_HEAP_SORT,
+    PDQ_SORT,
+    INTRO_SELECT,
+    HEAP_TOP_K,
+    PARTIAL_SORT
 };
 
-// Strings used to represent the sorting algorithms
-const std::string gSORT_NAMES[] = {
-    "Bubble Sort",
-    "Quick Sort",
-    "Cocktail Sort",
-    "Shell Sort",
-    "Heap Sort",
-    "Merge Sort",
-    "Selection Sort",
-    "Insertion Sort",
-    "Gnome Sort"
+/*!
+ * @brief Enum that represents the element types the array can hold
+ */
+enum ELEMENT_TYPE
+{
+    INT32_ELEMENTS,
+    INT64_ELEMENTS,
+    UINT64_ELEMENTS,
+    FLOAT_ELEMENTS,
+    DOUBLE_ELEMENTS
+};
+
+// Strings used to represent the element types
+const std::string gELEMENT_TYPE_NAMES[] = {
+    "int32",
+    "int64",
+    "uint64",
+    "float",
+    "double"
+};
+
+const int gELEMENT_TYPES_COUNT = 5;
+
+/*!
+ * @brief Enum that represents the orders the elements are arranged in before a sort
+ */
+enum INPUT_DISTRIBUTION
+{
+    SHUFFLED_INPUT,      // A random permutation
+    SORTED_INPUT,        // Already in order
+    REVERSED_INPUT,      // In reverse order
+    NEARLY_SORTED_INPUT, // In order but for 1% of the elements swapped with random others
+    FEW_UNIQUE_INPUT     // A random permutation of 16 distinct values
 };
 
+// Strings used to represent the input distributions
+const std::string gINPUT_DISTRIBUTION_NAMES[] = {
+    "shuffled",
+    "sorted",
+    "reversed",
+    "nearly",
+    "few"
+};
+
+const int gINPUT_DISTRIBUTIONS_COUNT = 5;
+
+/*!
+ * @brief Enum that represents the operations the algorithms perform on the array
+ */
+enum OP_TYPE
+{
+    COMPARE_OP, // The elements at i and j were compared
+    SWAP_OP,    // The elements at i and j were swapped
+    WRITE_OP,   // A value was written at i (copied from j, -1 if it came from outside the array)
+    READ_OP     // The element at i was copied out of the array (to a temporary or a buffer)
+};
+
+/*!
+ * @brief A struct that represents an operation yielded by an algorithm
+ */
+typedef struct SORT_OP
+{
+    OP_TYPE type;
+    int i;
+    int j;
+} SORT_OP;
+
 typedef struct PADDING
 {
     int top;
@@ -56,8 +120,52 @@ typedef struct PADDING
     int left;
 } PADDING;
 
-// String used for the info text
-const std::string gINFO_TEXT = " B - bubble sort \n E - shell sort \n Q - quick sort \n H - heap sort \n C - cocktail sort \n M - merge sort \n L - selection sort \n I - insertion sort \n G - gnome sort \n ------- \n Spacebar - start/ff \n S - shuffle \n ESC - quit \n ------- \n";
+// String used for the info text, after the keys of the algorithms
+const std::string gINFO_TEXT = " ------- \n T - element type \n Spacebar - start/ff \n P - pause \n N - step \n X - cache sim \n A - sound \n R - network cutoff \n F - gap sequence \n Z - selection k \n D - external sort \n O - scaling plot \n 5 - ingest mode \n 6 - ingest strategy \n 7 - sample sort \n 9 - playback time \n 0 - argsort \n LEFT/RIGHT - input order \n ENTER - auto algorithm \n S - shuffle \n ESC - quit \n ------- \n";
+
+// Keys used by the controls, they can't select an algorithm
+const SDL_Keycode gCONTROL_KEYS[] = {SDLK_t, SDLK_p, SDLK_n, SDLK_x, SDLK_s, SDLK_j, SDLK_k, SDLK_d, SDLK_r, SDLK_a, SDLK_o, SDLK_f, SDLK_z, SDLK_5, SDLK_6, SDLK_7, SDLK_9, SDLK_0, SDLK_F1};
+
+const int gCONTROL_KEYS_COUNT = 19;
+
+// The seconds a sort is played back in whatever its length (9 cycles through them), 0 to run it at the speed
+const int gPLAYBACK_SECONDS[] = {0, 5, 10, 30, 60};
+
+const int gPLAYBACK_SECONDS_COUNT = 5;
+
+// The worker processes of the sample sort in the window (7)
+const int gSAMPLE_NODES = 4;
+
+// Partition sizes below which quick sort and merge sort switch to a sorting network (R cycles through them)
+const int gNETWORK_CUTOFFS[] = {0, 4, 8, 16, 32};
+
+const int gNETWORK_CUTOFFS_COUNT = 5;
+
+/*!
+ * @brief Enum that represents the gap sequences of shell sort (F cycles through them)
+ */
+enum GAP_SEQUENCE
+{
+    SHELL_GAPS,     // n/2, n/4, ..., 1
+    KNUTH_GAPS,     // (3^k - 1) / 2 up to n/3
+    SEDGEWICK_GAPS, // 4^k + 3 2^(k-1) + 1
+    TOKUDA_GAPS,    // ceil((9^k - 4^k) / (5 4^(k-1)))
+    CIURA_GAPS,     // 1, 4, 10, 23, 57, 132, 301, 701, 1750, then x2.25
+    PRATT_GAPS      // 2^p 3^q
+};
+
+const std::string gGAP_SEQUENCE_NAMES[] = {"shell", "knuth", "sedgewick", "tokuda", "ciura", "pratt"};
+
+const int gGAP_SEQUENCES_COUNT = 6;
+
+// The k of the selection algorithms Z cycles through, 0 for the median
+const int gSELECTION_KS[] = {1, 10, 50, 100, 0};
+
+const int gSELECTION_KS_COUNT = 5;
+
+// The tones played per frame before the operations are decimated (fast forward runs whole sorts in a frame)
+const int gTONES_PER_FRAME = 256;
+
 // Save the different speeds
 const int gSPEEDS[] = {1, 5, 10, 20, 50, 100};
 
@@ -67,4 +175,13 @@ const SDL_Color gBackgroundColor = {0x4a, 0x18, 0xa8, 0xFF}; /*! The background
 
 const SDL_Color gFontColor = {0xFF, 0xFF, 0xFF, 0xFF}; /*! The font color of the text */
 
+const SDL_Color gGridColor = {0x6a, 0x48, 0xc8, 0xFF}; /*! The color of the grid of the scaling plot */
+
+// The colors of the curves of the scaling plot, cycled through by algorithm
+const SDL_Color gPLOT_COLORS[] = {{0xFF, 0xD7, 0x00, 0xFF}, {0x00, 0xFF, 0x7F, 0xFF}, {0xFF, 0x45, 0x45, 0xFF}, {0x00, 0xBF, 0xFF, 0xFF},
+                                  {0xFF, 0x8C, 0x00, 0xFF}, {0xF3, 0xEE, 0xFC, 0xFF}, {0xFF, 0x69, 0xB4, 0xFF}, {0x7F, 0xFF, 0x00, 0xFF},
+                                  {0x40, 0xE0, 0xD0, 0xFF}, {0xDA, 0x70, 0xD6, 0xFF}, {0xC0, 0xC0, 0xC0, 0xFF}, {0xFF, 0xA0, 0x7A, 0xFF}};
+
+const int gPLOT_COLORS_COUNT = 12;
+
 #endif /* Utilities_hpp */
\ No newline at end of file
@@ -0,0 +1,205 @@
+//
+//  Verify.hpp
+//  SDL_Sort_Visualizer
+//
+//  Created by Emiliano Iacopini on 10/18/26.
+//
+
+#ifndef Verify_hpp
+#define Verify_hpp
+
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include "Elements.hpp"
+
+namespace Visualizer
+{
+    // Arrays at least this large are verified by several threads
+    const size_t gVERIFY_PARALLEL = 1 << 18;
+
+    // The vector registers the order check works on, supported by SSE2 and NEON alike
+    const int gVERIFY_VECTOR_BYTES = 16;
+
+    /*!
+     * @brief An order independent checksum of the elements of an array
+     * @details The sums of two 64 bit hashes of the bits of every element, wrapping around: equal
+     *          for any permutation of the same elements and, with overwhelming probability,
+     *          different as soon as an element is lost, duplicated or changed (-0.0 included).
+     */
+    typedef struct MULTISET_CHECKSUM
+    {
+        uint64_t first = 0;
+        uint64_t second = 0;
+
+        bool operator==(const MULTISET_CHECKSUM &other) const { return first == other.first && second == other.second; }
+        bool operator!=(const MULTISET_CHECKSUM &other) const { return !(*this == other); }
+    } MULTISET_CHECKSUM;
+
+    /*!
+     * @brief The outcome of the verification of a sort
+     */
+    typedef struct SORT_VERIFICATION
+    {
+        bool sorted = false;      /*! Whether the array is in order (not checked for selections) */
+        bool permutation = false; /*! Whether the array holds the same elements as before the sort */
+        double timeMs = 0.0;      /*! The time the checks took */
+
+        bool valid() const { return sorted && permutation; }
+    } SORT_VERIFICATION;
+
+    /*!
+     * @brief Runs check on consecutive chunks of [0, n) on their own threads when n is large
+     * @param check Called with the bounds of a chunk, returns its partial result
+     * @param combine Folds the partial results, in chunk order
+     */
+    template <typename Result, typename Check, typename Combine>
+    Result parallelChunks(size_t n, Result initial, Check check, Combine combine)
+    {
+        size_t threads = n < gVERIFY_PARALLEL ? 1 : std::max(1u, std::min(std::thread::hardware_concurrency(), 16u));
+        std::vector<Result> partial(threads, initial);
+        std::vector<std::thread> workers;
+
+        for (size_t t = 1; t < threads; t++)
+            workers.emplace_back([&, t]() { partial[t] = check(n * t / threads, n * (t + 1) / threads); });
+        partial[0] = check(0, n / threads);
+
+        for (std::thread &worker : workers)
+            worker.join();
+
+        Result result = initial;
+        for (const Result &value : partial)
+            result = combine(result, value);
+        return result;
+    }
+
+    /*!
+     * @brief Maps the bits of a vector of elements to signed integers in the order of TotalLess
+     * @details Integers keep their bits (uint64 has its sign bit flipped), floating point values
+     *          have the magnitude of the negative ones flipped, like TotalLess::key.
+     */
+    template <typename T, typename Vector>
+    Vector orderKeys(Vector bits)
+    {
+        typedef typename std::remove_reference<decltype(bits[0])>::type Key;
+        const int shift = sizeof(Key) * 8 - 1;
+
+        if constexpr (std::is_floating_point<T>::value)
+            return bits ^ ((bits >> shift) & (Key)(~((typename std::make_unsigned<Key>::type)1 << shift)));
+        else if constexpr (std::is_unsigned<T>::value)
+            return bits ^ (Key)((typename std::make_unsigned<Key>::type)1 << shift);
+        else
+            return bits;
+    }
+
+    /*!
+     * @brief Whether [begin, end) is in the order of TotalLess
+     * @details Compares the keys of 16 bytes of elements with the same 16 bytes shifted by one
+     *          element at once, with the vector extensions of GCC and Clang so the compiler emits
+     *          SSE2 or NEON instructions whatever the optimization level. The descending lanes are
+     *          ORed together and only tested every 64 vectors, which keeps the loop branch free.
+     */
+    template <typename T>
+    bool isSortedRange(const T *data, size_t begin, size_t end)
+    {
+        typedef typename std::conditional<sizeof(T) == 4, int32_t, int64_t>::type Key;
+        typedef Key Vector __attribute__((vector_size(gVERIFY_VECTOR_BYTES)));
+        const size_t lanes = gVERIFY_VECTOR_BYTES / sizeof(T);
+
+        size_t i = begin;
+        while (i + lanes < end) {
+            Vector descending = {};
+            size_t stop = std::min(end - lanes, i + 64 * lanes);
+
+            for (; i < stop; i += lanes) {
+                Vector current, next;
+                std::memcpy(&current, data + i, sizeof(Vector));
+                std::memcpy(&next, data + i + 1, sizeof(Vector));
+                descending |= (Vector)(orderKeys<T>(next) < orderKeys<T>(current));
+            }
+
+            for (size_t lane = 0; lane < lanes; lane++)
+                if (descending[lane] != 0)
+                    return false;
+        }
+
+        // The last elements that don't fill a vector
+        TotalLess<T> less;
+        for (; i + 1 < end; i++)
+            if (less(data[i + 1], data[i]))
+                return false;
+
+        return true;
+    }
+
+    /*!
+     * @brief Whether the array is in the order of TotalLess, checked by several threads when large
+     */
+    template <typename T>
+    bool isSortedVectorized(const std::vector<T> &array)
+    {
+        // Every chunk but the last checks the first element of the next one too
+        size_t n = array.size();
+        return parallelChunks(n, true, [&](size_t begin, size_t end) { return isSortedRange(array.data(), begin, std::min(n, end + 1)); },
+                              [](bool a, bool b) { return a && b; });
+    }
+
+    /*!
+     * @brief A 64 bit mix of the bits of a value (the finalizer of SplitMix64)
+     */
+    inline uint64_t mixBits(uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    /*!
+     * @brief The multiset checksum of the array, computed by several threads when large
+     */
+    template <typename T>
+    MULTISET_CHECKSUM multisetChecksum(const std::vector<T> &array)
+    {
+        return parallelChunks(array.size(), MULTISET_CHECKSUM(), [&](size_t begin, size_t end) {
+            MULTISET_CHECKSUM sum;
+            for (size_t i = begin; i < end; i++) {
+                uint64_t bits = 0;
+                std::memcpy(&bits, &array[i], sizeof(T));
+                sum.first += mixBits(bits);
+                sum.second += mixBits(bits ^ 0x9E3779B97F4A7C15ULL);
+            }
+            return sum;
+        }, [](MULTISET_CHECKSUM a, const MULTISET_CHECKSUM &b) {
+            a.first += b.first;
+            a.second += b.second;
+            return a;
+        });
+    }
+
+    /*!
+     * @brief Checks that the array is sorted and holds the elements whose checksum was taken before the sort
+     * @param array The array after the sort
+     * @param before The checksum of the array before the sort
+     * @param checkOrder Whether the order is checked too (selections only settle part of the array)
+     */
+    template <typename T>
+    SORT_VERIFICATION verifySort(const std::vector<T> &array, const MULTISET_CHECKSUM &before, bool checkOrder = true)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        SORT_VERIFICATION result;
+        result.sorted = !checkOrder || isSortedVectorized(array);
+        result.permutation = multisetChecksum(array) == before;
+
+        auto end = std::chrono::high_resolution_clock::now();
+        result.timeMs = std::chrono::duration<double, std::milli>(end - start).count();
+        return result;
+    }
+}
+
+#endif /* Verify_hpp */
@@ -8,20 +8,76 @@
 #include <stdio.h>
 #include <SDL2/SDL.h>
 #include <stdexcept>
+#include <cstring>
 
 #include "Engine.hpp"
+#include "Benchmark.hpp"
+#include "Registry.hpp"
+#include "Trace.hpp"
 
 int main(int argc, char *argv[])
 {
     try
     {
+        // Loads the sort plugins, from ../plugins unless another directory is given with --plugins
+        const char *plugins = "../plugins";
+        for (int i = 1; i + 1 < argc; i++)
+            if (strcmp(argv[i], "--plugins") == 0)
+                plugins = argv[i + 1];
+        Visualizer::Registry::instance().loadPlugins(plugins);
+
+        // Writes the spans of the engine to a Chrome trace file, when built with TRACE=1
+        for (int i = 1; i + 1 < argc; i++)
+            if (strcmp(argv[i], "--trace") == 0) {
+#ifdef SORT_TRACE
+                Visualizer::Tracer::instance().start(argv[i + 1]);
+                TRACE_THREAD("main");
+#else
+                throw std::runtime_error("--trace needs a build with tracing (make TRACE=1)");
+#endif
+            }
+
+        // Runs the algorithms without a window and prints their statistics
+        if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+        {
+            Visualizer::Benchmark benchmark(Visualizer::Benchmark::parseArguments(argc, argv));
+            int code = benchmark.run();
+            Visualizer::Tracer::instance().stop();
+            return code;
+        }
+
         Visualizer::Engine engine({800, 600}, "SDL Sort Visualizer");
+
+        // Replaces the cache hierarchy simulated when X is pressed
+        for (int i = 1; i + 1 < argc; i++)
+            if (strcmp(argv[i], "--cache") == 0)
+                engine.setCacheLevels(Visualizer::CacheSimulator::parseLevels(argv[i + 1]));
+
+        // Shows the sorts streamed by a headless server started with --serve
+        for (int i = 1; i + 1 < argc; i++)
+            if (strcmp(argv[i], "--view") == 0)
+                engine.connectFeed(argv[i + 1]);
+
+        // Shows the sort of another program traced with ShmTraceWriter
+        for (int i = 1; i + 1 < argc; i++)
+            if (strcmp(argv[i], "--attach") == 0)
+                engine.attach(argv[i + 1]);
+
+        // Calibrates the auto mode with a baseline recorded on this machine
+        for (int i = 1; i + 1 < argc; i++)
+            if (strcmp(argv[i], "--calibration") == 0)
+                engine.loadCostModel(argv[i + 1]);
+
         engine.run();
     }
     catch (std::runtime_error &e)
     {
         printf("%s\n", e.what());
+        Visualizer::Tracer::instance().stop();
         return -1;
     }
+
+    // The engine joined its threads when it was destroyed, their spans are all in
+    Visualizer::Tracer::instance().stop();
     return 0;
 }